@@ -0,0 +1,27 @@
+#ifndef _CANCEL_TOKEN_H_
+#define _CANCEL_TOKEN_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Cooperative cancellation for a background job. The job keeps the ticket
+// it was started with; its owner moves <latest> on to make it stale. Long
+// loops check isCancelled() between steps and bail out early, leaving a
+// result the owner will throw away anyway. A default token never cancels.
+class CancelToken {
+    private:
+        std::shared_ptr<const std::atomic<uint64_t>> latest;
+        uint64_t ticket = 0;
+
+    public:
+        CancelToken() = default;
+        CancelToken(std::shared_ptr<const std::atomic<uint64_t>> latest, uint64_t ticket)
+            : latest(std::move(latest)), ticket(ticket) {}
+
+        bool isCancelled() const {
+            return latest && latest->load(std::memory_order_relaxed) != ticket;
+        }
+};
+
+#endif /* _CANCEL_TOKEN_H_ */
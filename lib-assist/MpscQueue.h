@@ -0,0 +1,54 @@
+#ifndef _MPSC_QUEUE_H_
+#define _MPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// Lock-free queue for handing results from any number of threads to one
+// consumer. push() is a single compare-and-swap onto a list; drain() takes
+// the whole list with one exchange and hands it back in push order (per
+// producer; pushes from different threads interleave as they landed).
+// Only ever drained whole, so there is no ABA to guard against.
+template <typename T>
+class MpscQueue {
+    private:
+        struct Node {
+            T value;
+            Node* next;
+        };
+        std::atomic<Node*> head{nullptr};
+
+    public:
+        MpscQueue() = default;
+        ~MpscQueue() { drain(); }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread
+        void push(T value) {
+            Node* node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+            while (!head.compare_exchange_weak(node->next, node,
+                                               std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        // Consumer thread only: everything pushed so far, oldest first
+        std::vector<T> drain() {
+            Node* node = head.exchange(nullptr, std::memory_order_acquire);
+            std::vector<T> values;
+            while (node) {
+                values.push_back(std::move(node->value));
+                Node* next = node->next;
+                delete node;
+                node = next;
+            }
+            std::reverse(values.begin(), values.end());
+            return values;
+        }
+
+        bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+};
+
+#endif /* _MPSC_QUEUE_H_ */
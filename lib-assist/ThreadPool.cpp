@@ -0,0 +1,114 @@
+#include "ThreadPool.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+
+// Set on pool workers, and on a caller while it works through its loop
+static thread_local bool insideLoop = false;
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+void ThreadPool::workerLoop() {
+    insideLoop = true;
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;      // stopping, and nothing left to do
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+// Progress of one parallelFor(), shared with the workers helping out
+struct LoopState {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+    std::mutex lock;
+    std::condition_variable done;
+    std::exception_ptr error;
+};
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    if (workers.empty() || count == 1 || insideLoop) {
+        for (size_t i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    // Helpers can still be draining the index counter after the last body
+    // returns, so the state is shared rather than on this stack. <body> is
+    // only called while the caller is still waiting.
+    auto state = std::make_shared<LoopState>();
+    auto work = [state, count, &body]() {
+        for (size_t i = state->next++; i < count; i = state->next++) {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(state->lock);
+                if (!state->error) state->error = std::current_exception();
+            }
+            if (++state->finished == count) {
+                std::lock_guard<std::mutex> guard(state->lock);
+                state->done.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), count - 1);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (size_t i = 0; i < helpers; ++i) tasks.push_back(work);
+    }
+    wake.notify_all();
+
+    insideLoop = true;
+    work();
+    insideLoop = false;
+
+    std::unique_lock<std::mutex> guard(state->lock);
+    state->done.wait(guard, [&] { return state->finished == count; });
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+
+    auto run = [task = std::move(task)]() {
+        insideLoop = false;
+        task();
+        insideLoop = true;
+    };
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.push_back(std::move(run));
+    }
+    wake.notify_one();
+}
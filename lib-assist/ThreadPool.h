@@ -0,0 +1,47 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops and background tasks. The calling thread
+// takes part in the work, so a pool of N workers runs N + 1 ways.
+class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex lock;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        void workerLoop();
+
+    public:
+        explicit ThreadPool(size_t threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Shared pool, one worker per hardware thread besides the caller's
+        static ThreadPool& global();
+
+        // Run body(i) for every i < count and return once all have finished.
+        // Indices are handed out one at a time, in no particular order. The
+        // first exception thrown by <body> is rethrown here. Called from
+        // inside a loop body, runs serially on the calling thread.
+        void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+        // Queue <task> for a worker and return at once. With no workers it
+        // runs here before returning. Tasks are not loop bodies, so they may
+        // run parallelFor() loops of their own. <task> must not throw.
+        void submit(std::function<void()> task);
+
+        size_t getThreadCount() const { return workers.size(); }
+};
+
+#endif /* _THREAD_POOL_H_ */
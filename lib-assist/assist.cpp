@@ -72,7 +72,20 @@ std::vector<FontDef> retrieveFonts(std::string fontPath) {
 }
 
 // Helper to map Math -> NDC (stands for Normalized Device Coordinates btw)
-float mapToScreen(float value, float min, float max) {
+// Done in double: world values only lose their digits once they are
+// relative to the view
+float mapToScreen(double value, double min, double max) {
     // Returns value between -1.0 and 1.0
-    return ((value - min) / (max - min)) * 2.0f - 1.0f;
+    return static_cast<float>(((value - min) / (max - min)) * 2.0 - 1.0);
+}
+
+GraphView padView(GraphView view, double margin) {
+    double padX = (view.maxX - view.minX) * margin;
+    double padY = (view.maxY - view.minY) * margin;
+    return {view.minX - padX, view.maxX + padX, view.minY - padY, view.maxY + padY};
+}
+
+bool containsView(const GraphView& outer, const GraphView& inner) {
+    return inner.minX >= outer.minX && inner.maxX <= outer.maxX &&
+           inner.minY >= outer.minY && inner.maxY <= outer.maxY;
 }
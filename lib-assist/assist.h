@@ -6,11 +6,13 @@
 #include <string>
 #include <cmath>
 
+// World-space bounds of the view. Double, so deep zooms far from the
+// origin keep distinct bounds (see TessellationOptions::precision).
 struct GraphView {
-    float minX = -10.0f;
-    float maxX =  10.0f;
-    float minY = -10.0f;
-    float maxY =  10.0f;
+    double minX = -10.0;
+    double maxX =  10.0;
+    double minY = -10.0;
+    double maxY =  10.0;
 };
 
 struct RenderColor {
@@ -31,6 +33,27 @@ std::string extractFontName(const std::string& filename);
 
 std::vector<FontDef> retrieveFonts(std::string fontPath = "fonts");
 
-float mapToScreen(float value, float min, float max);
+float mapToScreen(double value, double min, double max);
+
+// <view> grown by <margin> times its size on every side
+GraphView padView(GraphView view, double margin);
+
+// Whether <inner> lies entirely within <outer>
+bool containsView(const GraphView& outer, const GraphView& inner);
+
+// mapToScreen() for a whole view, its divisions done once up front.
+// Default constructed, it passes coordinates through.
+struct ScreenMap {
+    double minX = -1.0, minY = -1.0;
+    double scaleX = 1.0, scaleY = 1.0;
+
+    ScreenMap() = default;
+    explicit ScreenMap(const GraphView& view)
+        : minX(view.minX), minY(view.minY),
+          scaleX(2.0 / (view.maxX - view.minX)), scaleY(2.0 / (view.maxY - view.minY)) {}
+
+    float x(double value) const { return static_cast<float>((value - minX) * scaleX - 1.0); }
+    float y(double value) const { return static_cast<float>((value - minY) * scaleY - 1.0); }
+};
 
 #endif /*_ASSIST_H_*/
\ No newline at end of file
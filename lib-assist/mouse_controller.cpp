@@ -45,13 +45,13 @@ void MouseController::handleCursorPos(double xpos, double ypos) {
     if (!dragging || !panCallback) return;
 
     // Convert both old and new screen positions to world coordinates
-    float oldWX, oldWY, newWX, newWY;
+    double oldWX, oldWY, newWX, newWY;
     screenToWorld(lastX, lastY, oldWX, oldWY);
     screenToWorld(xpos, ypos, newWX, newWY);
 
     // Invert: dragging right should move the view left
-    float dx = oldWX - newWX;
-    float dy = oldWY - newWY;
+    double dx = oldWX - newWX;
+    double dy = oldWY - newWY;
 
     panCallback(dx, dy);
 
@@ -68,13 +68,13 @@ void MouseController::handleScroll(double xoffset, double yoffset) {
     double cursorX, cursorY;
     glfwGetCursorPos(window, &cursorX, &cursorY);
 
-    float worldX, worldY;
+    double worldX, worldY;
     screenToWorld(cursorX, cursorY, worldX, worldY);
 
     zoomAtCallback(worldX, worldY, factor);
 }
 
-void MouseController::screenToWorld(double sx, double sy, float& wx, float& wy) const {
+void MouseController::screenToWorld(double sx, double sy, double& wx, double& wy) const {
     int width, height;
     glfwGetWindowSize(window, &width, &height);
     float aspect = static_cast<float>(width) / static_cast<float>(height);
@@ -91,6 +91,6 @@ void MouseController::screenToWorld(double sx, double sy, float& wx, float& wy)
     }
 
     // NDC to world
-    wx = view->minX + (ndcX + 1.0f) / 2.0f * (view->maxX - view->minX);
-    wy = view->minY + (ndcY + 1.0f) / 2.0f * (view->maxY - view->minY);
+    wx = view->minX + (ndcX + 1.0) / 2.0 * (view->maxX - view->minX);
+    wy = view->minY + (ndcY + 1.0) / 2.0 * (view->maxY - view->minY);
 }
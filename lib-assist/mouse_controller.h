@@ -8,8 +8,8 @@
 class MouseController {
 
     public:
-        using PanCallback = std::function<void(float dx, float dy)>;
-        using ZoomAtCallback = std::function<void(float worldX, float worldY, float factor)>;
+        using PanCallback = std::function<void(double dx, double dy)>;
+        using ZoomAtCallback = std::function<void(double worldX, double worldY, float factor)>;
 
         MouseController(GLFWwindow* window, const GraphView* view);
 
@@ -36,7 +36,7 @@ class MouseController {
         ZoomAtCallback zoomAtCallback;
 
         // Convert screen pixel coordinates to world coordinates
-        void screenToWorld(double sx, double sy, float& wx, float& wy) const;
+        void screenToWorld(double sx, double sy, double& wx, double& wy) const;
 };
 
 #endif /* _MOUSE_CONTROLLER_H_ */
@@ -1,8 +1,13 @@
 #include "Curve2d.h"
+#include "ImplicitGenerator.h"
+#include <ExpressionCache.h>
+#include <cmath>
+#include <utility>
 
 // Constructor
 Curve2D::Curve2D(const char* eq, float lineWidth, RenderColor color) 
-    : Line2D(lineWidth, color), equation(eq) {
+    : Line2D(lineWidth, color), equation(eq),
+      expression(ExpressionCache::global().get(equation, FAST_MATH)) {
     // Set up in parent constructor
 }
 
@@ -11,18 +16,51 @@ Curve2D::~Curve2D() {
     // Base class destructor will be called automatically
 }
 
-// TODO: Plug in function from helper if unused by other classes
-// Generate vertex data in relation to GraphView
-void Curve2D::generate(GraphView view) {
-    strips = generateGraphPoints(equation.c_str(), view);
+// Generate vertex data in relation to GraphView.
+// Reuses the compiled expression; view changes never re-parse.
+// Equations ("x^2 + y^2 = 1") are contoured, y = f(x) is tessellated.
+GeometryBuilder Curve2D::geometryBuilder(GraphView view) const {
+    return [expression = expression, view](CurveGeometry& geometry, const CancelToken& cancel) {
+        if (expression->isImplicit()) {
+            // Tiles keep their size on screen; the grid has no tolerance to tighten
+            ContourOptions options;
+            options.tiles = static_cast<int>(std::ceil(options.tiles * (1.0 + 2.0 * GEOMETRY_MARGIN)));
+            options.cancel = &cancel;
+            generateImplicitPoints(*expression, view, options, geometry.strips);
+        } else {
+            TessellationOptions options;
+            options.tolerance /= GEOMETRY_DETAIL;
+            options.initialSegments = static_cast<int>(std::ceil(options.initialSegments * (1.0 + 2.0 * GEOMETRY_MARGIN)));
+            options.cancel = &cancel;
+            generateGraphPoints(*expression, view, options, geometry.strips);
+        }
+    };
 }
 
 // Setters and Getters
 // -------------------
 void Curve2D::setEquation(const char* eq) {
+    if (equation == eq) return;
     equation = eq;
+    expression = ExpressionCache::global().get(equation, FAST_MATH);
+    ++revision;
+}
+
+// Take over an equation compiled off the UI thread (see EquationEditor).
+// The old strips stay on screen but no longer cover any view, so the
+// caller's rebuild (a geometry job, as for any view change) can't be
+// cancelled by a pan before it lands.
+void Curve2D::applyEquation(EquationResult&& result) {
+    equation = std::move(result.equation);
+    expression = std::move(result.expression);
+    built = false;
+    ++revision;
 }
 
 const std::string& Curve2D::getEquation() const {
     return equation;
 }
+
+const Expression& Curve2D::getExpression() const {
+    return *expression;
+}
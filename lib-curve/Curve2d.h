@@ -2,6 +2,8 @@
 #define _CURVE2D_H_
 
 #include "Line2d.h"
+#include "EquationEditor.h"
+#include <memory>
 #include <string>
 
 
@@ -9,15 +11,18 @@ class Curve2D : public Line2D
 {
     protected:
         std::string equation;
+        std::shared_ptr<const Expression> expression;  // compiled once per setEquation (FAST_MATH), may be shared
+
+        GeometryBuilder geometryBuilder(GraphView view) const override;
 
     public:
         Curve2D(const char* equation, float lineWidth = 2.0f, RenderColor color = {0.0f, 0.0f, 0.0f});
         ~Curve2D() override;
 
-        void generate(GraphView view) override;  // Generate vertex data
-
         void setEquation(const char* equation);
+        void applyEquation(EquationResult&& result);  // swap in a finished build, then rebuild
         const std::string& getEquation() const;
+        const Expression& getExpression() const;
 };
 
 
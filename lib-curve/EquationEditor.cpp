@@ -0,0 +1,68 @@
+#include "EquationEditor.h"
+#include <ExpressionCache.h>
+#include <ThreadPool.h>
+
+// Runs on the worker: the parse, and the checks the generators would
+// otherwise only make once the curve's geometry job runs
+static EquationResult buildEquation(std::string equation) {
+    EquationResult result;
+    result.equation = std::move(equation);
+    result.expression = ExpressionCache::global().get(result.equation, FAST_MATH);
+
+    if (!result.expression->isValid()) {
+        result.error = result.expression->getError();
+        return result;
+    }
+    for (const std::string& name : result.expression->getProgram().getVariables()) {
+        if (name != "x" && !(name == "y" && result.expression->isImplicit())) {
+            result.error = "Invalid equation: Variable " + name + " does not exist in the symbol table";
+            break;
+        }
+    }
+    return result;
+}
+
+// One worker for every editor. Unlike a std::async future, a promise's
+// future doesn't wait for its task when destroyed.
+static ThreadPool& buildPool() {
+    static ThreadPool pool(1);
+    return pool;
+}
+
+EquationEditor::EquationEditor(const std::string& equation, std::chrono::milliseconds debounce)
+    : debounce(debounce), text(equation),
+      key(ExpressionCache::normalize(equation)), builtKey(key) {
+}
+
+void EquationEditor::edit(const std::string& equation) {
+    if (equation == text) return;
+    text = equation;
+    key = ExpressionCache::normalize(text);
+    lastEdit = std::chrono::steady_clock::now();
+
+    // Back to what is already built (or building): nothing to do
+    pending = key != builtKey;
+}
+
+bool EquationEditor::poll(EquationResult& result) {
+    bool ready = false;
+    if (build.valid() && build.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        result = build.get();
+        ready = true;
+    }
+
+    if (pending && !build.valid() && std::chrono::steady_clock::now() - lastEdit >= debounce) {
+        pending = false;
+        builtKey = key;
+        auto promise = std::make_shared<std::promise<EquationResult>>();
+        build = promise->get_future();
+        buildPool().submit([promise, equation = text] {
+            promise->set_value(buildEquation(equation));
+        });
+    }
+    return ready;
+}
+
+bool EquationEditor::isBusy() const {
+    return pending || build.valid();
+}
@@ -0,0 +1,51 @@
+#ifndef _EQUATION_EDITOR_H_
+#define _EQUATION_EDITOR_H_
+
+#include <Expression.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+// A compiled equation, ready to swap into a curve
+struct EquationResult {
+    std::string equation;
+    std::shared_ptr<const Expression> expression;
+    std::string error;                          // empty when the equation plots
+};
+
+// Turns the text of an equation box into curves without stalling the UI.
+// Edits settle for <debounce> before a build starts; the parse then runs
+// on a worker thread shared by all editors, one build per editor at a
+// time. An editor destroyed mid-build returns at once; its build finishes
+// on the worker and is dropped. The curve's geometry is built afterwards
+// like any other rebuild (Curve2D::applyEquation, GraphScene::rebuild). Edits
+// that leave the token stream unchanged (spacing, "sinx" / "sin x") never
+// rebuild, and texts seen before reuse their compiled expression through
+// ExpressionCache. Call poll() once a frame from the UI thread.
+class EquationEditor {
+    private:
+        std::chrono::milliseconds debounce;
+        std::string text;               // latest edit
+        std::string key;                // its normalized token stream
+        std::string builtKey;           // token stream of the build in flight, or of the last one
+        std::chrono::steady_clock::time_point lastEdit;
+        bool pending = false;           // an edit is waiting out the debounce
+        std::future<EquationResult> build;
+
+    public:
+        explicit EquationEditor(const std::string& equation,
+                                std::chrono::milliseconds debounce = std::chrono::milliseconds(150));
+
+        // The text changed; build it once it settles
+        void edit(const std::string& equation);
+
+        // Start a settled build, and collect a finished one into <result>.
+        // Returns whether <result> was written.
+        bool poll(EquationResult& result);
+
+        // Whether an edit is waiting or a build is running
+        bool isBusy() const;
+};
+
+#endif /* _EQUATION_EDITOR_H_ */
@@ -0,0 +1,85 @@
+#include "GeometryJobs.h"
+#include <config.h>
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+GeometryJobs::GeometryJobs()
+    : GeometryJobs(std::max(1u, std::thread::hardware_concurrency() / 2)) {
+}
+
+GeometryJobs::GeometryJobs(size_t threadCount)
+    : workers(std::max<size_t>(1, threadCount)) {
+}
+
+GeometryJobs::~GeometryJobs() {
+    for (auto& [line, slot] : slots) {
+        slot.latest->fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void GeometryJobs::request(Line2D* line, GraphView view) {
+    Slot& slot = slots[line];
+    if (!slot.latest) slot.latest = std::make_shared<std::atomic<uint64_t>>(0);
+
+    // Moving the ticket on cancels the job in flight, if any
+    slot.latest->store(++nextTicket, std::memory_order_relaxed);
+    slot.view = view;
+    slot.waiting = true;
+    if (slot.running == 0) start(line, slot);
+}
+
+// Snapshot the line here, on the UI thread, and run the job on a worker
+void GeometryJobs::start(Line2D* line, Slot& slot) {
+    uint64_t ticket = slot.latest->load(std::memory_order_relaxed);
+    slot.running = ticket;
+    slot.waiting = false;
+
+    GeometryJob job = line->makeGeometryJob(slot.view);
+    CancelToken token(slot.latest, ticket);
+    workers.submit([this, job = std::move(job), token, line, ticket]() {
+        Finished result{line, ticket, false, {}, {}};
+        try {
+            result.geometry = job(token);
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        } catch (...) {
+            result.error = "unknown error";
+        }
+        result.cancelled = token.isCancelled();
+        finished.push(std::move(result));
+    });
+}
+
+void GeometryJobs::cancel(const Line2D* line) {
+    auto it = slots.find(const_cast<Line2D*>(line));
+    if (it == slots.end()) return;
+    it->second.latest->fetch_add(1, std::memory_order_relaxed);  // cancel the job in flight
+    slots.erase(it);
+}
+
+std::vector<Line2D*> GeometryJobs::poll() {
+    std::vector<Line2D*> changed;
+    for (Finished& result : finished.drain()) {
+        auto it = slots.find(result.line);
+        if (it == slots.end() || it->second.running != result.ticket) continue;  // cancelled
+        Slot& slot = it->second;
+        slot.running = 0;
+
+        if (!result.error.empty()) {
+            WARN("[Geometry] Rebuild failed, keeping the last geometry: " << result.error);
+        } else if (!result.cancelled && result.ticket == slot.latest->load(std::memory_order_relaxed)) {
+            if (result.line->applyGeometry(std::move(result.geometry))) {
+                changed.push_back(result.line);
+            }
+        }
+        if (slot.waiting) start(result.line, slot);
+    }
+    return changed;
+}
+
+bool GeometryJobs::isBusy() const {
+    return std::any_of(slots.begin(), slots.end(), [](const auto& entry) {
+        return entry.second.running != 0 || entry.second.waiting;
+    });
+}
@@ -0,0 +1,70 @@
+#ifndef _GEOMETRY_JOBS_H_
+#define _GEOMETRY_JOBS_H_
+
+#include "Line2d.h"
+#include <CancelToken.h>
+#include <MpscQueue.h>
+#include <ThreadPool.h>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Rebuilds lines' geometry off the UI thread. request() snapshots a line
+// (Line2D::makeGeometryJob) and hands the job to a worker; finished
+// geometry comes back through a lock-free queue, and poll() swaps it in.
+// Each line has at most one job running. A newer request cancels it
+// (see CancelToken) and starts once it has wound down, so a drag never
+// piles up views nobody will see. Only the newest request is applied.
+// All calls but the jobs themselves belong on the UI thread.
+class GeometryJobs {
+    private:
+        struct Slot {
+            std::shared_ptr<std::atomic<uint64_t>> latest;  // ticket of the newest request
+            uint64_t running = 0;       // ticket of the job in flight, 0 if none
+            bool waiting = false;       // the newest request hasn't started yet
+            GraphView view;             // view of the newest request
+        };
+
+        struct Finished {
+            Line2D* line;
+            uint64_t ticket;
+            bool cancelled;
+            CurveGeometry geometry;
+            std::string error;          // what the job threw, if it did
+        };
+
+        std::unordered_map<Line2D*, Slot> slots;
+        uint64_t nextTicket = 0;
+        MpscQueue<Finished> finished;
+        ThreadPool workers;             // last, so it joins before the queue goes
+
+        void start(Line2D* line, Slot& slot);
+
+    public:
+        // Half the hardware threads, at least one: jobs spread their own
+        // loops over ThreadPool::global()
+        GeometryJobs();
+        explicit GeometryJobs(size_t threadCount);
+        ~GeometryJobs();                // cancels what is still running, then waits for it
+
+        GeometryJobs(const GeometryJobs&) = delete;
+        GeometryJobs& operator=(const GeometryJobs&) = delete;
+
+        // Rebuild <line> for <view>, replacing any earlier request for it
+        void request(Line2D* line, GraphView view);
+
+        // Drop <line>'s requests: its geometry covers the view after all,
+        // or it is about to be destroyed. A job still running holds its own
+        // snapshot and is discarded when it ends.
+        void cancel(const Line2D* line);
+
+        // Apply finished, current geometry and start waiting requests.
+        // Returns the lines whose geometry changed, to be uploaded.
+        std::vector<Line2D*> poll();
+
+        // Whether any request is still running or waiting
+        bool isBusy() const;
+};
+
+#endif /* _GEOMETRY_JOBS_H_ */
@@ -0,0 +1,331 @@
+#include "ImplicitGenerator.h"
+#include "SymbolTable.h"
+#include <ThreadPool.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+// The view is split into tiles, and each tile into cells whose corners
+// are sampled row by row in batches. A cell is split while its corners
+// change sign or its interval bound still holds zero; a cell whose bound
+// excludes zero is dropped without further samples. Cells that reach the
+// finest level with a sign change go through marching squares.
+//
+// Every vertex lies on an edge of the finest grid. Edges are named by
+// integer grid coordinates, so cells from different tiles agree on them
+// exactly and segments are joined into strips by edge, not by position.
+
+// Crossing of the curve with an edge of the finest grid
+struct Crossing {
+    uint64_t edge;
+    float x, y;         // screen coordinates
+};
+
+struct ContourSegment {
+    Crossing a, b;
+};
+
+// [lo, hi] rounded outward to floats, for the float interval evaluator:
+// rounded to nearest, a cell's bound could miss a crossing on its edge
+static Interval floatRange(double lo, double hi) {
+    float flo = static_cast<float>(lo);
+    float fhi = static_cast<float>(hi);
+    if (flo > lo) flo = std::nextafter(flo, -std::numeric_limits<float>::infinity());
+    if (fhi < hi) fhi = std::nextafter(fhi, std::numeric_limits<float>::infinity());
+    return {flo, fhi};
+}
+
+// Finest grid over the view
+struct ContourGrid {
+    GraphView view;
+    ScreenMap screen;       // the view's mapping to screen coordinates
+    double stepX, stepY;    // size of a finest cell
+    int size;               // finest cells per side
+
+    double x(int i) const { return view.minX + i * stepX; }
+    double y(int j) const { return view.minY + j * stepY; }
+
+    // Horizontal edge (i, j)-(i+1, j) or vertical edge (i, j)-(i, j+1)
+    uint64_t edgeId(int i, int j, bool vertical) const {
+        return ((static_cast<uint64_t>(j) * (size + 1) + i) << 1) | (vertical ? 1u : 0u);
+    }
+};
+
+// One tile's state and output. Tiles share nothing but <expr> and <grid>.
+struct ContourTile {
+    const Expression& expr;
+    const ContourGrid& grid;
+    int xSlot, ySlot;
+    std::vector<float> frame;
+    std::vector<Interval> ranges;
+    std::vector<ContourSegment> segments;
+    ContourStats stats;
+
+    // f along the row y = <y>, at each of xs[0..count)
+    void row(double y, const float* xs, float* out, size_t count) {
+        if (ySlot >= 0) frame[ySlot] = static_cast<float>(y);
+        expr.evaluateBatch(frame.data(), xSlot, xs, out, count);
+        stats.evaluations += count;
+    }
+
+    // f along the column x = <x>, at each of ys[0..count)
+    void column(double x, const float* ys, float* out, size_t count) {
+        if (xSlot >= 0) frame[xSlot] = static_cast<float>(x);
+        expr.evaluateBatch(frame.data(), ySlot, ys, out, count);
+        stats.evaluations += count;
+    }
+
+    // Bound on f over the cell (i, j)-(i + span, j + span)
+    Interval enclose(int i, int j, int span) {
+        if (xSlot >= 0) ranges[xSlot] = floatRange(grid.x(i), grid.x(i + span));
+        if (ySlot >= 0) ranges[ySlot] = floatRange(grid.y(j), grid.y(j + span));
+        ++stats.intervalEvaluations;
+        return expr.evaluateInterval(ranges.data());
+    }
+
+    void refine(int i, int j, int span, const float* f, bool bounded);
+    void march(int i, int j, const float* f);
+};
+
+// Crossing on the edge from grid point (i0, j0), value fa, to (i1, j1), value fb
+static Crossing crossing(const ContourGrid& grid, uint64_t edge,
+                         int i0, int j0, float fa, int i1, int j1, float fb) {
+    double t = static_cast<double>(fa) / (static_cast<double>(fa) - fb);
+    double x = grid.x(i0) + t * (grid.x(i1) - grid.x(i0));
+    double y = grid.y(j0) + t * (grid.y(j1) - grid.y(j0));
+    return {edge, grid.screen.x(x), grid.screen.y(y)};
+}
+
+// Marching squares on a finest cell. Corners: f[0] = (i, j), f[1] = (i+1, j),
+// f[2] = (i, j+1), f[3] = (i+1, j+1); "inside" means f > 0.
+void ContourTile::march(int i, int j, const float* f) {
+    ++stats.cells;
+    bool in[4] = {f[0] > 0.0f, f[1] > 0.0f, f[2] > 0.0f, f[3] > 0.0f};
+
+    // Crossings on the bottom, right, top and left edges, in that order
+    Crossing found[4];
+    bool cut[4] = {in[0] != in[1], in[1] != in[3], in[2] != in[3], in[0] != in[2]};
+    if (cut[0]) found[0] = crossing(grid, grid.edgeId(i, j, false),     i, j, f[0], i + 1, j, f[1]);
+    if (cut[1]) found[1] = crossing(grid, grid.edgeId(i + 1, j, true),  i + 1, j, f[1], i + 1, j + 1, f[3]);
+    if (cut[2]) found[2] = crossing(grid, grid.edgeId(i, j + 1, false), i, j + 1, f[2], i + 1, j + 1, f[3]);
+    if (cut[3]) found[3] = crossing(grid, grid.edgeId(i, j, true),      i, j, f[0], i, j + 1, f[2]);
+
+    int count = cut[0] + cut[1] + cut[2] + cut[3];
+    if (count == 2) {
+        const Crossing* ends[2];
+        int n = 0;
+        for (int e = 0; e < 4; ++e) {
+            if (cut[e]) ends[n++] = &found[e];
+        }
+        segments.push_back({*ends[0], *ends[1]});
+    } else if (count == 4) {
+        // Saddle: the center decides which diagonal is connected. If it
+        // sides with (i, j), the cuts go around (i+1, j) and (i, j+1).
+        bool center = (f[0] + f[1] + f[2] + f[3]) > 0.0f;
+        if (center == in[0]) {
+            segments.push_back({found[0], found[1]});
+            segments.push_back({found[2], found[3]});
+        } else {
+            segments.push_back({found[0], found[3]});
+            segments.push_back({found[1], found[2]});
+        }
+    }
+}
+
+// Cell (i, j)-(i + span, j + span) of the finest grid, corners as in march().
+// <bounded>: f is known to have no pole in the cell.
+void ContourTile::refine(int i, int j, int span, const float* f, bool bounded) {
+    bool finite = std::isfinite(f[0]) && std::isfinite(f[1]) && std::isfinite(f[2]) && std::isfinite(f[3]);
+    bool in = f[0] > 0.0f;
+    bool change = finite && ((f[1] > 0.0f) != in || (f[2] > 0.0f) != in || (f[3] > 0.0f) != in);
+
+    if (!change) {
+        // Equal signs can still hide a zero in between; only the bound
+        // rules it out
+        if (span == 1) return;
+        Interval range = enclose(i, j, span);
+        if (!range.contains(0.0f)) return;
+        bounded = bounded || range.isBounded();
+    } else if (span == 1) {
+        // A sign change across a pole isn't a crossing
+        if (bounded || enclose(i, j, span).isBounded()) march(i, j, f);
+        return;
+    }
+
+    // Sample the middle row and the two remaining edge midpoints
+    int half = span / 2;
+    float xs[3] = {static_cast<float>(grid.x(i)), static_cast<float>(grid.x(i + half)),
+                   static_cast<float>(grid.x(i + span))};
+    float ys[2] = {static_cast<float>(grid.y(j)), static_cast<float>(grid.y(j + span))};
+    float mid[3];
+    float edge[2];
+    row(grid.y(j + half), xs, mid, 3);
+    column(grid.x(i + half), ys, edge, 2);
+
+    const float lowerLeft[4]  = {f[0], edge[0], mid[0], mid[1]};
+    const float lowerRight[4] = {edge[0], f[1], mid[1], mid[2]};
+    const float upperLeft[4]  = {mid[0], mid[1], f[2], edge[1]};
+    const float upperRight[4] = {mid[1], mid[2], edge[1], f[3]};
+    refine(i, j, half, lowerLeft, bounded);
+    refine(i + half, j, half, lowerRight, bounded);
+    refine(i, j + half, half, upperLeft, bounded);
+    refine(i + half, j + half, half, upperRight, bounded);
+}
+
+// Join segments that share a crossing into strips. Each edge is shared by
+// at most two cells, each with at most one segment ending on it.
+static void linkSegments(const std::vector<ContourSegment>& segments, StripBuffer& strips) {
+    std::unordered_map<uint64_t, std::pair<int, int>> byEdge;   // edge -> up to two segments
+    byEdge.reserve(segments.size() * 2);
+    for (int s = 0; s < static_cast<int>(segments.size()); ++s) {
+        for (uint64_t edge : {segments[s].a.edge, segments[s].b.edge}) {
+            auto inserted = byEdge.emplace(edge, std::make_pair(s, -1));
+            if (!inserted.second) inserted.first->second.second = s;
+        }
+    }
+
+    // The segment other than <s> ending on <edge>, or -1
+    auto neighbour = [&](uint64_t edge, int s) {
+        const auto& pair = byEdge.at(edge);
+        return pair.first == s ? pair.second : pair.first;
+    };
+
+    std::vector<bool> used(segments.size(), false);
+    std::vector<const Crossing*> chain;
+
+    for (int start = 0; start < static_cast<int>(segments.size()); ++start) {
+        if (used[start]) continue;
+        used[start] = true;
+
+        // Walk forward from b, then backward from a unless the walk closed a loop
+        chain.assign({&segments[start].a, &segments[start].b});
+        bool closed = false;
+        for (int s = start;;) {
+            uint64_t edge = chain.back()->edge;
+            int n = neighbour(edge, s);
+            if (n < 0) break;
+            if (n == start) { closed = true; chain.push_back(chain.front()); break; }
+            if (used[n]) break;
+            used[n] = true;
+            const ContourSegment& seg = segments[n];
+            chain.push_back(seg.a.edge == edge ? &seg.b : &seg.a);
+            s = n;
+        }
+        if (!closed) {
+            std::vector<const Crossing*> before;
+            for (int s = start;;) {
+                uint64_t edge = before.empty() ? chain.front()->edge : before.back()->edge;
+                int n = neighbour(edge, s);
+                if (n < 0 || used[n]) break;
+                used[n] = true;
+                const ContourSegment& seg = segments[n];
+                before.push_back(seg.a.edge == edge ? &seg.b : &seg.a);
+                s = n;
+            }
+            chain.insert(chain.begin(), before.rbegin(), before.rend());
+        }
+
+        strips.startStrip();
+        for (const Crossing* c : chain) {
+            strips.addVertex(c->x, c->y);
+        }
+    }
+    strips.finish();
+}
+
+StripBuffer generateImplicitPoints(
+    const Expression& expr, GraphView view,
+    const ContourOptions& options, ContourStats* stats
+) {
+    StripBuffer strips;
+    generateImplicitPoints(expr, view, options, strips, stats);
+    return strips;
+}
+
+void generateImplicitPoints(
+    const Expression& expr, GraphView view,
+    const ContourOptions& options, StripBuffer& strips, ContourStats* stats
+) {
+    strips.clear();
+    if (!expr.isValid()) {
+        throw std::runtime_error("Invalid equation: " + expr.getError());
+    }
+
+    // Same layout trick as generateGraphPoints(): a table shaped like the program
+    SymbolTable symbols;
+    for (const std::string& name : expr.getProgram().getVariables()) {
+        if (name != "x" && name != "y") {
+            throw std::runtime_error("Invalid equation: Variable " + name + " does not exist in the symbol table");
+        }
+        symbols.AddEntry(name);
+    }
+
+    const int tiles = std::max(1, options.tiles);
+    const int tileCells = std::max(1, options.tileCells);
+    const int cellSpan = 1 << std::max(0, options.maxDepth);
+    const int tileSpan = tileCells * cellSpan;
+
+    ContourGrid grid;
+    grid.view = view;
+    grid.screen = ScreenMap(view);
+    grid.size = tiles * tileSpan;
+    grid.stepX = (view.maxX - view.minX) / grid.size;
+    grid.stepY = (view.maxY - view.minY) / grid.size;
+
+    std::vector<ContourTile> results;
+    results.reserve(static_cast<size_t>(tiles) * tiles);
+    for (int t = 0; t < tiles * tiles; ++t) {
+        results.push_back({expr, grid, symbols.GetIndex("x"), symbols.GetIndex("y"),
+                           std::vector<float>(symbols.GetCount(), 0.0f),
+                           std::vector<Interval>(symbols.GetCount()), {}, {}});
+    }
+
+    ThreadPool::global().parallelFor(results.size(), [&](size_t t) {
+        if (options.cancel && options.cancel->isCancelled()) return;
+        ContourTile& tile = results[t];
+        int i0 = static_cast<int>(t % tiles) * tileSpan;
+        int j0 = static_cast<int>(t / tiles) * tileSpan;
+
+        // Most tiles of a typical view provably miss the curve
+        Interval range = tile.enclose(i0, j0, tileSpan);
+        if (!range.contains(0.0f)) return;
+
+        const int n = tileCells + 1;
+        std::vector<float> xs(n);
+        std::vector<float> values(static_cast<size_t>(n) * n);
+        for (int c = 0; c < n; ++c) {
+            xs[c] = static_cast<float>(grid.x(i0 + c * cellSpan));
+        }
+        for (int r = 0; r < n; ++r) {
+            tile.row(grid.y(j0 + r * cellSpan), xs.data(), &values[static_cast<size_t>(r) * n], n);
+        }
+
+        for (int r = 0; r < tileCells; ++r) {
+            for (int c = 0; c < tileCells; ++c) {
+                const float* below = &values[static_cast<size_t>(r) * n + c];
+                const float* above = below + n;
+                const float corners[4] = {below[0], below[1], above[0], above[1]};
+                tile.refine(i0 + c * cellSpan, j0 + r * cellSpan, cellSpan, corners, range.isBounded());
+            }
+        }
+    });
+
+    // Gather in tile order, so the output doesn't depend on scheduling
+    ContourStats localStats;
+    ContourStats& counts = stats ? *stats : localStats;
+    counts = ContourStats();
+    std::vector<ContourSegment> segments;
+    if (options.cancel && options.cancel->isCancelled()) return;
+    for (const ContourTile& tile : results) {
+        segments.insert(segments.end(), tile.segments.begin(), tile.segments.end());
+        counts.evaluations += tile.stats.evaluations;
+        counts.intervalEvaluations += tile.stats.intervalEvaluations;
+        counts.cells += tile.stats.cells;
+    }
+
+    linkSegments(segments, strips);
+    counts.vertices += strips.vertexCount();
+}
@@ -0,0 +1,38 @@
+#ifndef _IMPLICIT_GENERATOR_H_
+#define _IMPLICIT_GENERATOR_H_
+
+#include "StripBuffer.h"
+#include <assist.h>
+#include <CancelToken.h>
+#include <Expression.h>
+#include <vector>
+
+struct ContourOptions {
+    int tiles = 8;          // tiles per side of the view, contoured in parallel
+    int tileCells = 8;      // cells per side of a tile, sampled up front
+    int maxDepth = 4;       // quadtree levels below a tile's cells
+    const CancelToken* cancel = nullptr;  // checked once a tile; cancelled runs return no strips
+};
+
+// What one contouring cost
+struct ContourStats {
+    size_t evaluations = 0;          // points evaluated
+    size_t intervalEvaluations = 0;  // Expression::evaluateInterval() calls
+    size_t cells = 0;                // finest cells run through marching squares
+    size_t vertices = 0;             // vertices emitted
+};
+
+// Contour the zero set of an equation F(x, y) = G(x, y) (see
+// Expression::isImplicit()) over <view>. Strips come out in the same
+// layout as generateGraphPoints(). Throws if <expr> is invalid or reads
+// variables other than x and y.
+StripBuffer generateImplicitPoints(
+    const Expression& expr, GraphView view,
+    const ContourOptions& options = ContourOptions(), ContourStats* stats = nullptr);
+
+// Same, into <strips>: cleared first, its capacity kept
+void generateImplicitPoints(
+    const Expression& expr, GraphView view,
+    const ContourOptions& options, StripBuffer& strips, ContourStats* stats = nullptr);
+
+#endif /* _IMPLICIT_GENERATOR_H_ */
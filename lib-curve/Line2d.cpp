@@ -1,10 +1,15 @@
 #include "Line2d.h"
+#include <chrono>
+#include <utility>
 
-// Constructor
+// Constructor. GL objects wait for the first upload(), so a line can be
+// made and built without a context.
 Line2D::Line2D(float lineWidth, RenderColor color) 
     : VAO(0), VBO(0), lineWidth(lineWidth), color(color) {
-    
-    // Configure VAO and VBO
+}
+
+// Configure VAO and VBO
+static void createBuffers(unsigned int& VAO, unsigned int& VBO) {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     
@@ -30,40 +35,82 @@ Line2D::~Line2D() {
 }
 
 // Generate vertex data in relation to GraphView
-void Line2D::generate(GraphView view) {
-    strips = generateGraphPoints("x", view); // Default to y=x line
+GeometryBuilder Line2D::geometryBuilder(GraphView view) const {
+    return [view](CurveGeometry& geometry, const CancelToken& cancel) {
+        TessellationOptions options;
+        options.tolerance /= GEOMETRY_DETAIL;
+        options.cancel = &cancel;
+        generateGraphPoints(Expression::parse("x"), view, options, geometry.strips); // Default to y=x line
+    };
 }
 
-// Upload vertex data — flatten all sub-strips into a single VBO
-// and record draw ranges for each strip.
-void Line2D::upload() {
-    vboData.clear();
-    drawRanges.clear();
-
-    int vertexOffset = 0;
-    for (const auto& strip : strips) {
-        int vertexCount = static_cast<int>(strip.size()) / 3;
-        if (vertexCount < 2) continue;  // need at least 2 points for a line
-        drawRanges.push_back({vertexOffset, vertexCount});
-        vboData.insert(vboData.end(), strip.begin(), strip.end());
-        vertexOffset += vertexCount;
-    }
+// The spare buffer rides along with the job and comes back as the new
+// strips, so a curve's two buffers trade places build after build
+GeometryJob Line2D::makeGeometryJob(GraphView view) {
+    CurveGeometry seed;
+    seed.strips = std::move(spare);
+    spare = StripBuffer();
+    seed.strips.clear();
+    seed.view = padView(view, GEOMETRY_MARGIN);
+    seed.target = view;
+    seed.revision = revision;
+
+    return [builder = geometryBuilder(seed.view), seed = std::move(seed)](const CancelToken& cancel) mutable {
+        auto start = std::chrono::steady_clock::now();
+        CurveGeometry geometry = std::move(seed);
+        builder(geometry, cancel);
+        geometry.buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return geometry;
+    };
+}
 
-    if (vboData.empty()) return;
+bool Line2D::applyGeometry(CurveGeometry&& geometry) {
+    if (geometry.revision != revision) return false;
+    spare = std::exchange(strips, std::move(geometry.strips));
+    builtView = geometry.view;
+    targetView = geometry.target;
+    built = true;
+    buildTime = geometry.buildTime;
+    return true;
+}
+
+bool Line2D::covers(GraphView view) const {
+    if (!built) return false;
+    double zoomX = (targetView.maxX - targetView.minX) / (view.maxX - view.minX);
+    double zoomY = (targetView.maxY - targetView.minY) / (view.maxY - view.minY);
+    return zoomX <= GEOMETRY_ZOOM_IN && zoomY <= GEOMETRY_ZOOM_IN && containsView(builtView, view);
+}
+
+// CPU half of update(), on the calling thread. GraphScene runs the same
+// jobs in the background instead (see GeometryJobs).
+void Line2D::build(GraphView view) {
+    applyGeometry(makeGeometryJob(view)(CancelToken()));
+}
 
+// Upload vertex data, straight from the strip buffer. The VBO keeps a
+// quarter of headroom, so a pan that adds a few vertices overwrites it in
+// place rather than reallocating.
+void Line2D::upload() {
+    if (strips.vertices.empty()) return;
+    if (VAO == 0) createBuffers(VAO, VBO);
+
+    size_t bytes = strips.vertices.size() * sizeof(float);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vboData.size() * sizeof(float),
-                 vboData.data(), GL_DYNAMIC_DRAW);
+    if (bytes > vboCapacity) {
+        vboCapacity = bytes + bytes / 4;
+        glBufferData(GL_ARRAY_BUFFER, vboCapacity, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, strips.vertices.data());
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 // Render each sub-strip as an independent GL_LINE_STRIP
 void Line2D::render() {
-    if (drawRanges.empty() || !visible) return;
+    if (strips.empty() || !visible || VAO == 0) return;
 
     glBindVertexArray(VAO);
     glLineWidth(lineWidth);
-    for (const auto& [start, count] : drawRanges) {
+    for (const auto& [start, count] : strips.ranges) {
         glDrawArrays(GL_LINE_STRIP, start, count);
     }
     glBindVertexArray(0);
@@ -71,7 +118,7 @@ void Line2D::render() {
 
 // Regenerate and re-upload, Rinse and repeat
 void Line2D::update(GraphView view) {
-    generate(view);
+    build(view);
     upload();
 }
 
@@ -114,4 +161,16 @@ bool Line2D::isVisible() const {
 
 void Line2D::setVisible(bool v) {
     visible = v;
-}
\ No newline at end of file
+}
+
+double Line2D::getBuildTime() const {
+    return buildTime;
+}
+
+GraphView Line2D::getBuiltView() const {
+    return builtView;
+}
+
+uint64_t Line2D::getRevision() const {
+    return revision;
+}
@@ -2,7 +2,11 @@
 #define _LINE2D_H_
 
 #include "VertexGenerator.h"
+#include <CancelToken.h>
 #include <glad/glad.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
 
 enum class LineType {
     Straight,
@@ -10,26 +14,78 @@ enum class LineType {
     Dotted
 };
 
+// Lines are built past the view and finer than it needs, so the vertex
+// shader can follow pans and modest zooms by itself (see Line2D::covers).
+// Vertices stay relative to the padded view rather than world space: far
+// from the origin, world coordinates have no float digits left for a pixel.
+constexpr double GEOMETRY_MARGIN = 0.5;     // of the view's size, added on each side
+constexpr double GEOMETRY_ZOOM_IN = 1.5;    // zoom in this far before the tolerance would break
+
+// Builders divide screen-space tolerances by this: the padded view is
+// (1 + 2 * margin) times as large, and may be zoomed into by ZOOM_IN
+constexpr double GEOMETRY_DETAIL = (1.0 + 2.0 * GEOMETRY_MARGIN) * GEOMETRY_ZOOM_IN;
+
+// Geometry a job built for one view, ready to swap into its line
+struct CurveGeometry {
+    StripBuffer strips;                         // for <view>
+    GraphView view;                             // <target>, padded by GEOMETRY_MARGIN
+    GraphView target;                           // the view it was requested for
+    uint64_t revision = 0;                      // Line2D revision the job was made from
+    double buildTime = 0.0;                     // ms
+    std::shared_ptr<const std::vector<std::vector<double>>> worldStrips;  // ParametricCurve2D's samples, for the next pan
+};
+
+// Builds a line's geometry from a snapshot of it, on any thread. Checks
+// the token between steps; a cancelled job's geometry is incomplete.
+using GeometryJob = std::function<CurveGeometry(const CancelToken&)>;
+
+// What a line puts into its jobs: fills in the strips of a geometry that
+// comes with a cleared, recycled buffer
+using GeometryBuilder = std::function<void(CurveGeometry&, const CancelToken&)>;
+
 class Line2D {
 
     protected:
-        std::vector<std::vector<float>> strips;  // sub-strips of valid vertices
-        std::vector<float> vboData;               // flattened VBO data
-        std::vector<std::pair<int,int>> drawRanges; // {startVertex, count} per strip
+        StripBuffer strips;                       // the VBO's data and draw ranges
+        StripBuffer spare;                        // last geometry's buffer, for the next job to fill
         unsigned int VAO, VBO;
+        size_t vboCapacity = 0;                   // bytes allocated for VBO
         float lineWidth;
         RenderColor color;
         LineType lineType = LineType::Straight;
         bool visible = true;
+        double buildTime = 0.0;                   // milliseconds the current geometry took
+        GraphView builtView;                      // view the current strips were built for
+        GraphView targetView;                     // view they were requested for
+        bool built = false;                       // there is geometry at all
+        uint64_t revision = 0;                    // bumped whenever the line itself changes
+
+        // The builder behind makeGeometryJob(): captures what it needs by
+        // value. <view> is already padded; tolerances need GEOMETRY_DETAIL.
+        virtual GeometryBuilder geometryBuilder(GraphView view) const;
 
     public:
         Line2D(float lineWidth = 1.0f, RenderColor color = {0.0f, 0.0f, 0.0f});
         virtual ~Line2D();
 
-        virtual void generate(GraphView view);  // Generate vertex data
-        void upload();                          // Upload to GPU
+        // Snapshot of this line that builds its geometry for <view> and its
+        // margin, timed, into the spare buffer. Make it on the UI thread; run it anywhere,
+        // even after the line is gone.
+        GeometryJob makeGeometryJob(GraphView view);
+        // Swap in a job's geometry, unless the line changed since the job
+        // was made. Returns whether it was taken. No GL.
+        virtual bool applyGeometry(CurveGeometry&& geometry);
+
+        // Whether the current geometry still serves <view> once the vertex
+        // shader has moved it there: inside the built range, and not zoomed
+        // in past GEOMETRY_ZOOM_IN. The margin alone limits zooming out,
+        // to 1 + 2 * GEOMETRY_MARGIN.
+        bool covers(GraphView view) const;
+
+        void build(GraphView view);             // run a job here and apply it
+        void upload();                          // Upload to GPU (GL thread only)
         void render();                          // Draw the line/curve
-        void update(GraphView view);            // Regenerate and reupload
+        void update(GraphView view);            // build() and upload()
 
         void setColor(float r, float g, float b);
         RenderColor getColor() const;
@@ -40,6 +96,9 @@ class Line2D {
         void setLineType(LineType type);
         bool isVisible() const;
         void setVisible(bool v);
+        double getBuildTime() const;            // ms, to spot the slow equation
+        GraphView getBuiltView() const;         // what the uploaded vertices are relative to
+        uint64_t getRevision() const;
 };
 
 #endif /* _LINE2D_H_ */
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "ParametricCurve2d.h"
+#include <ExpressionCache.h>
+#include <cmath>
+
+// Constructor
+ParametricCurve2D::ParametricCurve2D(const char* xEq, const char* yEq, double tMin, double tMax,
+                                     float lineWidth, RenderColor color)
+    : Line2D(lineWidth, color), xEquation(xEq), yEquation(yEq),
+      xExpression(ExpressionCache::global().get(xEquation)),
+      yExpression(ExpressionCache::global().get(yEquation)),
+      tMin(tMin), tMax(tMax) {
+    // Set up in parent constructor
+}
+
+// Destructor
+ParametricCurve2D::~ParametricCurve2D() {
+    // Base class destructor will be called automatically
+}
+
+// Whether two view spans are the same up to the rounding a pan brings:
+// max - min moves by an ulp or so as the view's position changes
+static bool sameSpan(double span, double sampled) {
+    return sampled != 0.0 && std::abs(span / sampled - 1.0) < 1e-9;
+}
+
+// Generate vertex data in relation to GraphView.
+// Sampling depends only on the view's size, so a pan past the margin just
+// remaps the cached world-space samples; a zoom re-tessellates.
+GeometryBuilder ParametricCurve2D::geometryBuilder(GraphView view) const {
+    double spanX = view.maxX - view.minX;
+    double spanY = view.maxY - view.minY;
+    auto cached = (worldStrips && sameSpan(spanX, sampledSpanX) && sameSpan(spanY, sampledSpanY)) ? worldStrips : nullptr;
+
+    return [xExpression = xExpression, yExpression = yExpression, tMin = tMin, tMax = tMax,
+            cached, view](CurveGeometry& geometry, const CancelToken& cancel) {
+        geometry.worldStrips = cached;
+        if (!geometry.worldStrips) {
+            ParametricOptions options;
+            options.tolerance /= GEOMETRY_DETAIL;
+            options.cancel = &cancel;
+            geometry.worldStrips = std::make_shared<const std::vector<std::vector<double>>>(
+                tessellateParametric(*xExpression, *yExpression, tMin, tMax, view, options));
+        }
+        mapStripsToScreen(*geometry.worldStrips, view, geometry.strips);
+    };
+}
+
+bool ParametricCurve2D::applyGeometry(CurveGeometry&& geometry) {
+    if (geometry.revision != revision) return false;
+    worldStrips = std::move(geometry.worldStrips);
+    sampledSpanX = geometry.view.maxX - geometry.view.minX;
+    sampledSpanY = geometry.view.maxY - geometry.view.minY;
+    return Line2D::applyGeometry(std::move(geometry));
+}
+
+// Setters and Getters
+// -------------------
+void ParametricCurve2D::setEquations(const char* xEq, const char* yEq) {
+    if (xEquation == xEq && yEquation == yEq) return;
+    xEquation = xEq;
+    yEquation = yEq;
+    xExpression = ExpressionCache::global().get(xEquation);
+    yExpression = ExpressionCache::global().get(yEquation);
+    worldStrips.reset();  // resample on the next job
+    ++revision;
+}
+
+void ParametricCurve2D::setRange(double newMin, double newMax) {
+    if (tMin == newMin && tMax == newMax) return;
+    tMin = newMin;
+    tMax = newMax;
+    worldStrips.reset();
+    ++revision;
+}
+
+const std::string& ParametricCurve2D::getXEquation() const {
+    return xEquation;
+}
+
+const std::string& ParametricCurve2D::getYEquation() const {
+    return yEquation;
+}
+
+double ParametricCurve2D::getTMin() const {
+    return tMin;
+}
+
+double ParametricCurve2D::getTMax() const {
+    return tMax;
+}
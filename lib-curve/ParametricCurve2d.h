@@ -0,0 +1,44 @@
+#ifndef _PARAMETRIC_CURVE2D_H_
+#define _PARAMETRIC_CURVE2D_H_
+
+#include "Line2d.h"
+#include "ParametricGenerator.h"
+#include <memory>
+#include <string>
+
+
+// Curve traced by (x(t), y(t)) for t in [tMin, tMax]
+class ParametricCurve2D : public Line2D
+{
+    protected:
+        std::string xEquation;
+        std::string yEquation;
+        std::shared_ptr<const Expression> xExpression;  // compiled once per setEquations, may be shared
+        std::shared_ptr<const Expression> yExpression;
+        double tMin, tMax;
+
+        // World-space samples, reused while only the view's position changes.
+        // Shared with jobs in flight, so never modified in place.
+        std::shared_ptr<const std::vector<std::vector<double>>> worldStrips;
+        double sampledSpanX = 0.0;
+        double sampledSpanY = 0.0;
+
+        GeometryBuilder geometryBuilder(GraphView view) const override;
+
+    public:
+        ParametricCurve2D(const char* xEquation, const char* yEquation, double tMin, double tMax,
+                          float lineWidth = 2.0f, RenderColor color = {0.0f, 0.0f, 0.0f});
+        ~ParametricCurve2D() override;
+
+        bool applyGeometry(CurveGeometry&& geometry) override;  // keeps the samples too
+
+        void setEquations(const char* xEquation, const char* yEquation);
+        void setRange(double tMin, double tMax);
+        const std::string& getXEquation() const;
+        const std::string& getYEquation() const;
+        double getTMin() const;
+        double getTMax() const;
+};
+
+
+#endif /* _PARAMETRIC_CURVE2D_H_ */
@@ -0,0 +1,261 @@
+#include "ParametricGenerator.h"
+#include "SymbolTable.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Same level-by-level refinement as adaptiveTessellate() in
+// VertexGenerator.cpp, but with both coordinates varying: a segment of
+// t is flat when its probes at 1/4, 1/2 and 3/4 lie within tolerance of
+// the chord on screen. Each level's probes go through x(t) and y(t) as
+// one block of t, in double. A flat piece is only kept once interval
+// evaluation proves both coordinates bounded on it, so a pole between
+// probes still breaks the strip.
+
+enum ParametricState {
+    PENDING_PIECE,
+    EMIT_PIECE,         // emit the start point into the current strip
+    BREAK_PIECE         // emit the start point if defined, then end the current strip
+};
+
+struct PathSample {
+    double t, x, y;
+    bool finite() const { return std::isfinite(x) && std::isfinite(y); }
+};
+
+struct PathPiece {
+    PathSample p1, p2;
+    ParametricState state;
+};
+
+// [t1, t2] rounded outward to floats, for the float interval evaluator
+static Interval floatRange(double t1, double t2) {
+    float lo = static_cast<float>(t1);
+    float hi = static_cast<float>(t2);
+    if (lo > t1) lo = std::nextafter(lo, -std::numeric_limits<float>::infinity());
+    if (hi < t2) hi = std::nextafter(hi, std::numeric_limits<float>::infinity());
+    return {lo, hi};
+}
+
+// One expression in t, with its frame laid out like its program
+struct ParametricAxis {
+    const Expression& expr;
+    std::vector<double> frame;
+    std::vector<float> intervalFrame;   // <frame> for Expression::evaluateInterval()
+    int tSlot;
+
+    ParametricAxis(const Expression& e) : expr(e) {
+        if (!expr.isValid()) {
+            throw std::runtime_error("Invalid equation: " + expr.getError());
+        }
+        SymbolTable symbols;
+        for (const std::string& name : expr.getProgram().getVariables()) {
+            if (name != "t") {
+                throw std::runtime_error("Invalid equation: Variable " + name + " does not exist in the symbol table");
+            }
+            symbols.AddEntry(name);
+        }
+        frame.assign(symbols.GetCount(), 0.0);
+        intervalFrame.assign(symbols.GetCount(), 0.0f);
+        tSlot = symbols.GetIndex("t");
+    }
+
+    void evaluate(const std::vector<double>& ts, std::vector<double>& out) {
+        out.resize(ts.size());
+        expr.evaluateBatch(frame.data(), tSlot, ts.data(), out.data(), ts.size());
+    }
+
+    // Whether the expression provably has no pole on [t1, t2]. As in
+    // VertexGenerator.cpp, where floats are too coarse to tell the range
+    // from its neighbourhood the samples have the final say.
+    bool isBounded(double t1, double t2, ParametricStats& counts) const {
+        Interval range = floatRange(t1, t2);
+        if (static_cast<double>(range.hi) - range.lo > 4.0 * (t2 - t1)) {
+            return true;
+        }
+        ++counts.intervalEvaluations;
+        return expr.evaluateInterval(intervalFrame.data(), tSlot, range).isBounded();
+    }
+};
+
+// Screen-space distance of (x, y) from the chord of <piece>
+static double chordDistance(const PathPiece& piece, double x, double y, double scaleX, double scaleY) {
+    double cdx = (piece.p2.x - piece.p1.x) * scaleX;
+    double cdy = (piece.p2.y - piece.p1.y) * scaleY;
+    double chordLen = std::sqrt(cdx * cdx + cdy * cdy);
+
+    double pxs = (x - piece.p1.x) * scaleX;
+    double pys = (y - piece.p1.y) * scaleY;
+    if (chordLen > 1e-12) {
+        return std::abs(cdx * pys - cdy * pxs) / chordLen;
+    }
+    return std::sqrt(pxs * pxs + pys * pys);
+}
+
+std::vector<std::vector<double>> tessellateParametric(
+    const Expression& xExpr, const Expression& yExpr,
+    double tMin, double tMax, GraphView view,
+    const ParametricOptions& options, ParametricStats* stats
+) {
+    ParametricAxis xAxis(xExpr);
+    ParametricAxis yAxis(yExpr);
+
+    ParametricStats localStats;
+    ParametricStats& counts = stats ? *stats : localStats;
+    counts = ParametricStats();
+
+    const double scaleX = 2.0 / (view.maxX - view.minX);
+    const double scaleY = 2.0 / (view.maxY - view.minY);
+    const int maxDepth = options.maxDepth;
+    const int numSegments = std::max(1, options.initialSegments);
+
+    std::vector<double> ts(numSegments + 1);
+    std::vector<double> xs;
+    std::vector<double> ys;
+    double step = (tMax - tMin) / numSegments;
+    for (int i = 0; i < numSegments; ++i) ts[i] = tMin + i * step;
+    ts[numSegments] = tMax;
+    xAxis.evaluate(ts, xs);
+    yAxis.evaluate(ts, ys);
+    counts.evaluations += ts.size();
+
+    std::vector<PathPiece> pieces;
+    pieces.reserve(numSegments);
+    for (int i = 0; i < numSegments; ++i) {
+        pieces.push_back({{ts[i], xs[i], ys[i]}, {ts[i + 1], xs[i + 1], ys[i + 1]}, PENDING_PIECE});
+    }
+    const PathSample last = {ts[numSegments], xs[numSegments], ys[numSegments]};
+
+    std::vector<PathPiece> next;
+    for (int depth = 0; depth <= maxDepth; ++depth) {
+        if (options.cancel && options.cancel->isCancelled()) return {};
+
+        // Gather this level's probes
+        ts.clear();
+        for (const PathPiece& piece : pieces) {
+            if (piece.state != PENDING_PIECE) continue;
+            bool fin1 = piece.p1.finite();
+            bool fin2 = piece.p2.finite();
+            double t1 = piece.p1.t;
+            double t2 = piece.p2.t;
+            if (fin1 && fin2) {
+                ts.push_back(t1 + 0.25 * (t2 - t1));
+                ts.push_back((t1 + t2) * 0.5);
+                ts.push_back(t1 + 0.75 * (t2 - t1));
+            } else if ((fin1 || fin2) && depth < maxDepth) {
+                ts.push_back((t1 + t2) * 0.5);
+            }
+        }
+        if (ts.empty()) break;
+
+        xAxis.evaluate(ts, xs);
+        yAxis.evaluate(ts, ys);
+        counts.evaluations += ts.size();
+
+        // Decide or split every pending piece, keeping t order
+        next.clear();
+        size_t p = 0;
+        for (const PathPiece& piece : pieces) {
+            if (piece.state != PENDING_PIECE) {
+                next.push_back(piece);
+                continue;
+            }
+
+            bool fin1 = piece.p1.finite();
+            bool fin2 = piece.p2.finite();
+            if (!fin1 && !fin2) {
+                next.push_back({piece.p1, piece.p2, BREAK_PIECE});
+                continue;
+            }
+
+            // One end undefined: close in on the domain boundary
+            if (!fin1 || !fin2) {
+                if (depth < maxDepth) {
+                    PathSample mid = {ts[p], xs[p], ys[p]};
+                    p += 1;
+                    next.push_back({piece.p1, mid, PENDING_PIECE});
+                    next.push_back({mid, piece.p2, PENDING_PIECE});
+                } else {
+                    next.push_back({piece.p1, piece.p2, fin1 ? EMIT_PIECE : BREAK_PIECE});
+                }
+                continue;
+            }
+
+            double error = 0.0;
+            for (size_t k = p; k < p + 3; ++k) {
+                double distance = std::isfinite(xs[k]) && std::isfinite(ys[k])
+                    ? chordDistance(piece, xs[k], ys[k], scaleX, scaleY)
+                    : std::numeric_limits<double>::infinity();
+                error = std::max(error, distance);
+            }
+            PathSample mid = {ts[p + 1], xs[p + 1], ys[p + 1]};
+            p += 3;
+
+            bool flat = error <= options.tolerance;
+            bool bounded = flat && xAxis.isBounded(piece.p1.t, piece.p2.t, counts) &&
+                           yAxis.isBounded(piece.p1.t, piece.p2.t, counts);
+            if (flat && bounded) {
+                next.push_back({piece.p1, piece.p2, EMIT_PIECE});
+            } else if (depth < maxDepth) {
+                next.push_back({piece.p1, mid, PENDING_PIECE});
+                next.push_back({mid, piece.p2, PENDING_PIECE});
+            } else {
+                // Still bent at this resolution, or straddling a pole
+                next.push_back({piece.p1, piece.p2, BREAK_PIECE});
+            }
+        }
+        pieces.swap(next);
+    }
+
+    std::vector<std::vector<double>> strips;
+    bool inStrip = false;
+    auto emit = [&](const PathSample& s) {
+        if (!inStrip) {
+            strips.emplace_back();
+            inStrip = true;
+        }
+        strips.back().push_back(s.x);
+        strips.back().push_back(s.y);
+    };
+    for (const PathPiece& piece : pieces) {
+        if (piece.state == EMIT_PIECE || piece.p1.finite()) emit(piece.p1);
+        if (piece.state != EMIT_PIECE) inStrip = false;
+    }
+    if (last.finite()) emit(last);
+
+    strips.erase(
+        std::remove_if(strips.begin(), strips.end(),
+                       [](const std::vector<double>& s) { return s.size() < 4; }),
+        strips.end()
+    );
+
+    for (const auto& s : strips) counts.vertices += s.size() / 2;
+    return strips;
+}
+
+StripBuffer mapStripsToScreen(
+    const std::vector<std::vector<double>>& worldStrips, GraphView view
+) {
+    StripBuffer strips;
+    mapStripsToScreen(worldStrips, view, strips);
+    return strips;
+}
+
+void mapStripsToScreen(
+    const std::vector<std::vector<double>>& worldStrips, GraphView view, StripBuffer& strips
+) {
+    const ScreenMap screen(view);
+    size_t vertexCount = 0;
+    for (const std::vector<double>& world : worldStrips) vertexCount += world.size() / 2;
+
+    strips.clear();
+    strips.reserve(vertexCount, worldStrips.size());
+    for (const std::vector<double>& world : worldStrips) {
+        strips.startStrip();
+        for (size_t k = 0; k + 1 < world.size(); k += 2) {
+            strips.addVertex(screen.x(world[k]), screen.y(world[k + 1]));
+        }
+    }
+    strips.finish();
+}
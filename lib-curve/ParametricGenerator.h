@@ -0,0 +1,45 @@
+#ifndef _PARAMETRIC_GENERATOR_H_
+#define _PARAMETRIC_GENERATOR_H_
+
+#include "StripBuffer.h"
+#include <assist.h>
+#include <CancelToken.h>
+#include <Expression.h>
+#include <vector>
+
+struct ParametricOptions {
+    float tolerance = 0.001f;   // max distance of the curve from a chord, in screen units
+    int maxDepth = 12;          // subdivision levels below the initial segments
+    int initialSegments = 256;  // enough to catch every lobe of a busy Lissajous figure
+    const CancelToken* cancel = nullptr;  // checked once a level; cancelled runs return no strips
+};
+
+// What one tessellation cost
+struct ParametricStats {
+    size_t evaluations = 0;     // values of t, each evaluated for both x and y
+    size_t intervalEvaluations = 0;  // Expression::evaluateInterval() calls
+    size_t vertices = 0;        // vertices emitted
+};
+
+// World-space polyline through (x(t), y(t)) for t in [tMin, tMax], two
+// doubles per vertex, broken where either coordinate is undefined or
+// has a pole.
+// Sampled adaptively on screen-space chord error at <view>'s scale. Only
+// the view's size matters, not its position: the result stays valid
+// while panning. Throws if an expression is invalid or reads anything
+// but t.
+std::vector<std::vector<double>> tessellateParametric(
+    const Expression& xExpr, const Expression& yExpr,
+    double tMin, double tMax, GraphView view,
+    const ParametricOptions& options = ParametricOptions(), ParametricStats* stats = nullptr);
+
+// World-space strips from tessellateParametric() as screen-space vertices,
+// in the layout of generateGraphPoints()
+StripBuffer mapStripsToScreen(
+    const std::vector<std::vector<double>>& worldStrips, GraphView view);
+
+// Same, into <strips>: cleared first, its capacity kept
+void mapStripsToScreen(
+    const std::vector<std::vector<double>>& worldStrips, GraphView view, StripBuffer& strips);
+
+#endif /* _PARAMETRIC_GENERATOR_H_ */
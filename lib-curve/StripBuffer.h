@@ -0,0 +1,60 @@
+#ifndef _STRIP_BUFFER_H_
+#define _STRIP_BUFFER_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Line strips in one contiguous buffer, already in the VBO's layout (x, y, z
+// per vertex), with a {first vertex, vertex count} range per strip for
+// glDrawArrays. clear() keeps the capacity, so a buffer reused for the next
+// build of the same curve stops allocating once it has grown to fit.
+struct StripBuffer {
+    std::vector<float> vertices;
+    std::vector<std::pair<int, int>> ranges;
+
+    void clear() {
+        vertices.clear();
+        ranges.clear();
+    }
+
+    void reserve(size_t vertexCount, size_t stripCount) {
+        vertices.reserve(vertexCount * 3);
+        ranges.reserve(stripCount);
+    }
+
+    // End the current strip and start another. A strip of fewer than two
+    // vertices draws nothing and is taken back.
+    void startStrip() {
+        dropShortStrip();
+        ranges.push_back({static_cast<int>(vertexCount()), 0});
+    }
+
+    void addVertex(float x, float y) {
+        vertices.push_back(x);
+        vertices.push_back(y);
+        vertices.push_back(0.0f);
+        ++ranges.back().second;
+    }
+
+    // After the last strip
+    void finish() { dropShortStrip(); }
+
+    size_t vertexCount() const { return vertices.size() / 3; }
+    size_t stripCount() const { return ranges.size(); }
+    bool empty() const { return ranges.empty(); }
+
+    bool operator==(const StripBuffer& other) const {
+        return vertices == other.vertices && ranges == other.ranges;
+    }
+
+    private:
+        void dropShortStrip() {
+            if (!ranges.empty() && ranges.back().second < 2) {
+                vertices.resize(ranges.back().first * 3);
+                ranges.pop_back();
+            }
+        }
+};
+
+#endif /* _STRIP_BUFFER_H_ */
@@ -1,158 +1,437 @@
 #include "VertexGenerator.h"
 #include "SymbolTable.h"
+#include <ThreadPool.h>
 #include <algorithm>
 #include <limits>
 
-static inline bool isFinite(float v) { return std::isfinite(v); }
+// The tessellator runs in float or double (see ScalarPrecision); vertices
+// are always float, relative to the view.
+template <typename T>
+static inline bool isFinite(T v) { return std::isfinite(v); }
 
 // Push a vertex into the current strip, or start new sub-strip.
 static inline void emitVertex(
-    float x, float y,
-    GraphView view,
-    std::vector<std::vector<float>>& strips,
+    double x, double y,
+    const ScreenMap& screen,
+    StripBuffer& strips,
     bool& inStrip
 ) {
     if (!inStrip) {
-        strips.emplace_back();    // start a new sub-strip
+        strips.startStrip();
         inStrip = true;
     }
-    auto& s = strips.back();
-    s.push_back(mapToScreen(x, view.minX, view.maxX));
-    s.push_back(mapToScreen(y, view.minY, view.maxY));
-    s.push_back(0.0f);
+    strips.addVertex(screen.x(x), screen.y(y));
 }
 
-static float computeScreenError(
-    Expression& expr,
-    SymbolTable& symbols,
-    float x1, float y1,
-    float x2, float y2,
-    float scaleX, float scaleY
-) {
-    float cdx = (x2 - x1) * scaleX;
-    float cdy = (y2 - y1) * scaleY;
-    float chordLen = std::sqrt(cdx * cdx + cdy * cdy);
+// One piece of the x-range during level-by-level refinement.
+// PENDING segments still need a decision, the others are final.
+enum SegmentState {
+    PENDING_SEGMENT,
+    EMIT_SEGMENT,       // emit (x1, y1) into the current strip
+    BREAK_SEGMENT,      // end the current strip
+    EDGE_SEGMENT        // emit (x1, y1), then end the current strip
+};
 
-    float maxError = 0.0f;
-    for (float t : {0.25f, 0.5f, 0.75f}) {
-        float xs = x1 + t * (x2 - x1);
-        symbols.SetValue("x", xs);
-        float ys = expr.evaluate(symbols);
+// f and, for DERIVATIVE_METRIC, f' and f'' at x
+template <typename T>
+struct Sample {
+    T x, y;
+    T dy, ddy;
+};
 
-        if (!isFinite(ys)) return std::numeric_limits<float>::infinity();
+template <typename T>
+struct Segment {
+    Sample<T> p1, p2;
+    SegmentState state;
+    bool bounded;       // f is known to be bounded on [x1, x2]
+};
 
-        float pxs = (xs - x1) * scaleX;
-        float pys = (ys - y1) * scaleY;
+// [x1, x2] rounded outward to floats, for the float interval evaluator
+static Interval floatRange(double x1, double x2) {
+    float lo = static_cast<float>(x1);
+    float hi = static_cast<float>(x2);
+    if (lo > x1) lo = std::nextafter(lo, -std::numeric_limits<float>::infinity());
+    if (hi < x2) hi = std::nextafter(hi, std::numeric_limits<float>::infinity());
+    return {lo, hi};
+}
 
-        float dist;
-        if (chordLen > 1e-12f) {
-            dist = std::abs(cdx * pys - cdy * pxs) / chordLen;
-        } else {
-            dist = std::sqrt(pxs * pxs + pys * pys);
+// Everything a tessellation pass reads, and what it counts
+template <typename T>
+struct TessellationContext {
+    const Expression& expr;
+    const T* frame;
+    const float* intervalFrame;     // <frame> for Expression::evaluateInterval()
+    int xSlot;
+    double minY, maxY;
+    T scaleX, scaleY;
+    const TessellationOptions& options;
+    TessellationStats& stats;
+
+    // Interval evaluation is float only. In double the range is widened
+    // to floats, which loosens the enclosure but keeps it valid.
+    Interval enclose(T x1, T x2) const {
+        ++stats.intervalEvaluations;
+        return expr.evaluateInterval(intervalFrame, xSlot, floatRange(x1, x2));
+    }
+
+    Interval enclose(const Segment<T>& seg) const { return enclose(seg.p1.x, seg.p2.x); }
+
+    // Whether f provably has no pole on [x1, x2]. Where floats are too
+    // coarse to tell the range from its neighbourhood, a pole nearby
+    // proves nothing and the samples have the final say.
+    bool isBounded(T x1, T x2) const {
+        Interval range = floatRange(x1, x2);
+        if (static_cast<double>(range.hi) - range.lo > 4.0 * (static_cast<double>(x2) - x1)) {
+            return true;
         }
-        maxError = std::max(maxError, dist);
+        return enclose(x1, x2).isBounded();
     }
-    return maxError;
+
+    bool isBounded(const Segment<T>& seg) const { return isBounded(seg.p1.x, seg.p2.x); }
+};
+
+// Screen-space distance of (x, y) from the chord of <seg>
+template <typename T>
+static T chordDistance(const Segment<T>& seg, T x, T y, T scaleX, T scaleY) {
+    T cdx = (seg.p2.x - seg.p1.x) * scaleX;
+    T cdy = (seg.p2.y - seg.p1.y) * scaleY;
+    T chordLen = std::sqrt(cdx * cdx + cdy * cdy);
+
+    T pxs = (x - seg.p1.x) * scaleX;
+    T pys = (y - seg.p1.y) * scaleY;
+    if (chordLen > T(1e-12)) {
+        return std::abs(cdx * pys - cdy * pxs) / chordLen;
+    }
+    return std::sqrt(pxs * pxs + pys * pys);
 }
 
-static void adaptiveTessellate(
-    Expression& expr,
-    SymbolTable& symbols,
-    float x1, float y1,
-    float x2, float y2,
-    GraphView view,
-    std::vector<std::vector<float>>& strips,
-    bool& inStrip,
-    float scaleX, float scaleY,
-    float tolerance,
-    int depth,
-    int maxDepth
+// Max screen-space distance of the probes (at t = 0.25, 0.5, 0.75) from the chord
+template <typename T>
+static T computeScreenError(
+    const Segment<T>& seg,
+    const T* probeX, const T* probeY,
+    T scaleX, T scaleY
 ) {
-    bool fin1 = isFinite(y1);
-    bool fin2 = isFinite(y2);
-
-    // TODO: Evaluation at AT points cannot yeild infinite values.
-    //       Strips can't break and artificat lines occur at asymptotes.
-    // Both endpoints non-finite → entire segment is outside the domain.
-    if (!fin1 && !fin2) {
-        inStrip = false;   // break the strip
-        return;
+    T maxError = T(0);
+    for (int i = 0; i < 3; ++i) {
+        if (!isFinite(probeY[i])) return std::numeric_limits<T>::infinity();
+        maxError = std::max(maxError, chordDistance(seg, probeX[i], probeY[i], scaleX, scaleY));
     }
+    return maxError;
+}
+
+// Screen-space deviation of the curve from the chord, estimated from the
+// endpoint derivatives with no further evaluation. The cubic Hermite
+// interpolant strays from the chord by at most max|f'(end) - slope| * dx / 4,
+// a parabola of curvature f'' by |f''| dx^2 / 8. Either catches what the
+// other misses (matching slopes over a bump, an inflection point).
+template <typename T>
+static T computeDerivativeError(const Segment<T>& seg, T scaleX, T scaleY) {
+    T dx = seg.p2.x - seg.p1.x;
+    T slope = (seg.p2.y - seg.p1.y) / dx;
+    T hermite = std::max(std::abs(seg.p1.dy - slope), std::abs(seg.p2.dy - slope)) * dx * T(0.25);
+    T curvature = std::max(std::abs(seg.p1.ddy), std::abs(seg.p2.ddy)) * dx * dx * T(0.125);
+    if (!isFinite(hermite) || !isFinite(curvature)) return std::numeric_limits<T>::infinity();
+
+    // Vertical deviation, projected onto the chord's normal
+    T deviation = std::max(hermite, curvature);
+    return chordDistance(seg, seg.p1.x, seg.p1.y + deviation, scaleX, scaleY);
+}
 
-    // TODO: Same issue. Code auto skips to normal AT implementation.
-    // One endpoint non-finite → domain boundary inside, subdivide to find it.
-    if (!fin1 || !fin2) {
-        if (depth < maxDepth) {
-            float xMid = (x1 + x2) * 0.5f;
-            symbols.SetValue("x", xMid);
-            float yMid = expr.evaluate(symbols);
-            adaptiveTessellate(expr, symbols, x1, y1, xMid, yMid, view, strips, inStrip, scaleX, scaleY, tolerance, depth + 1, maxDepth);
-            adaptiveTessellate(expr, symbols, xMid, yMid, x2, y2, view, strips, inStrip, scaleX, scaleY, tolerance, depth + 1, maxDepth);
+// Adaptive tessellation, one subdivision level at a time.
+// Every probe of a level goes to the expression in a single batch call,
+// and the midpoint probe doubles as the split point of the next level.
+// Interval bounds (Expression::evaluateInterval) settle what sampling
+// can't: segments provably off-screen are dropped without probing, and
+// a segment is only drawn straight if it provably has no pole.
+template <typename T>
+static void adaptiveTessellate(const TessellationContext<T>& ctx, std::vector<Segment<T>>& segments) {
+    const TessellationOptions& options = ctx.options;
+    const bool derivatives = options.metric == DERIVATIVE_METRIC;
+    const int maxDepth = options.maxDepth;
+
+    std::vector<Segment<T>> next;
+    std::vector<T> probeX;
+    std::vector<T> probeY;
+    std::vector<DualNumber<T>> probeD;
+
+    auto probeSample = [&](size_t i) -> Sample<T> {
+        if (derivatives) return {probeX[i], probeD[i].value, probeD[i].d1, probeD[i].d2};
+        return {probeX[i], probeY[i], T(0), T(0)};
+    };
+
+    for (int depth = 0; depth <= maxDepth; ++depth) {
+        if (options.cancel && options.cancel->isCancelled()) return;
+
+        // Gather this level's probes
+        probeX.clear();
+        bool pending = false;
+        for (Segment<T>& seg : segments) {
+            if (seg.state != PENDING_SEGMENT) continue;
+            pending = true;
+
+            bool fin1 = isFinite(seg.p1.y);
+            bool fin2 = isFinite(seg.p2.y);
+            T x1 = seg.p1.x;
+            T x2 = seg.p2.x;
+            T xMid = (x1 + x2) * T(0.5);
+
+            // Both ends off the same side of the screen: if the whole segment
+            // provably stays there, keep (x1, y1) so the line leading in is
+            // drawn and end the strip, with no probes and no subdivision.
+            if (fin1 && fin2 && ((seg.p1.y > ctx.maxY && seg.p2.y > ctx.maxY) ||
+                                 (seg.p1.y < ctx.minY && seg.p2.y < ctx.minY))) {
+                Interval range = ctx.enclose(seg);
+                if (range.lo > ctx.maxY || range.hi < ctx.minY) {
+                    seg.state = EDGE_SEGMENT;
+                    continue;
+                }
+            }
+
+            if (fin1 && fin2 && !derivatives) {
+                probeX.push_back(x1 + T(0.25) * (x2 - x1));
+                probeX.push_back(xMid);
+                probeX.push_back(x1 + T(0.75) * (x2 - x1));
+            } else if (fin1 && fin2) {
+                // The endpoints already say whether this segment is flat, so
+                // it only costs a probe if it has to be split
+                T error = computeDerivativeError(seg, ctx.scaleX, ctx.scaleY);
+                bool flat = error <= options.tolerance;
+                if (flat && !seg.bounded) {
+                    seg.bounded = ctx.isBounded(seg);
+                }
+                if (flat && seg.bounded) {
+                    seg.state = EMIT_SEGMENT;
+                } else if (depth < maxDepth) {
+                    probeX.push_back(xMid);
+                } else if (!seg.bounded) {
+                    seg.state = EDGE_SEGMENT;       // stop the strip at the pole
+                } else {
+                    // A finite error this late is a jump, an infinite one a
+                    // vertical tangent (sqrt(x) at 0) on a tiny segment
+                    seg.state = isFinite(error) ? BREAK_SEGMENT : EMIT_SEGMENT;
+                }
+            } else if ((fin1 || fin2) && depth < maxDepth) {
+                probeX.push_back(xMid);
+            }
+        }
+        if (!pending) break;
+
+        if (derivatives) {
+            probeD.resize(probeX.size());
+            ctx.expr.evaluateDualBatch(ctx.frame, ctx.xSlot, probeX.data(), probeD.data(), probeX.size());
         } else {
-            // Max depth reached — emit whichever endpoint is finite
-            if (fin1) emitVertex(x1, y1, view, strips, inStrip);
-            else      inStrip = false;
+            probeY.resize(probeX.size());
+            ctx.expr.evaluateBatch(ctx.frame, ctx.xSlot, probeX.data(), probeY.data(), probeX.size());
         }
-        return;
-    }
+        ctx.stats.evaluations += probeX.size();
 
-    float error = computeScreenError(expr, symbols, x1, y1, x2, y2, scaleX, scaleY);
+        // Decide or split every pending segment, keeping x order
+        next.clear();
+        size_t p = 0;
+        for (Segment<T>& seg : segments) {
+            if (seg.state != PENDING_SEGMENT) {
+                next.push_back(seg);
+                continue;
+            }
 
-    if (error > tolerance && depth < maxDepth) {
-        float xMid = (x1 + x2) * 0.5f;
-        symbols.SetValue("x", xMid);
-        float yMid = expr.evaluate(symbols);
-        adaptiveTessellate(expr, symbols, x1, y1, xMid, yMid, view, strips, inStrip, scaleX, scaleY, tolerance, depth + 1, maxDepth);
-        adaptiveTessellate(expr, symbols, xMid, yMid, x2, y2, view, strips, inStrip, scaleX, scaleY, tolerance, depth + 1, maxDepth);
-    } else if (error <= tolerance) {
-        emitVertex(x1, y1, view, strips, inStrip);
-    } else {
-        inStrip = false;
+            bool fin1 = isFinite(seg.p1.y);
+            bool fin2 = isFinite(seg.p2.y);
+
+            // Both endpoints non-finite → entire segment is outside the domain.
+            if (!fin1 && !fin2) {
+                next.push_back({seg.p1, seg.p2, BREAK_SEGMENT, seg.bounded});
+                continue;
+            }
+
+            // One endpoint non-finite → domain boundary inside, subdivide to find it.
+            // Derivative-driven segments still pending here get split as well.
+            if (!fin1 || !fin2 || derivatives) {
+                if (depth < maxDepth) {
+                    Sample<T> mid = probeSample(p);
+                    p += 1;
+                    next.push_back({seg.p1, mid, PENDING_SEGMENT, seg.bounded});
+                    next.push_back({mid, seg.p2, PENDING_SEGMENT, seg.bounded});
+                } else {
+                    // Max depth reached — emit whichever endpoint is finite
+                    next.push_back({seg.p1, seg.p2, fin1 ? EMIT_SEGMENT : BREAK_SEGMENT, seg.bounded});
+                }
+                continue;
+            }
+
+            T error = computeScreenError(seg, &probeX[p], &probeY[p], ctx.scaleX, ctx.scaleY);
+            Sample<T> mid = probeSample(p + 1);
+            p += 3;
+
+            // Samples that line up can still straddle a pole (tan(x) or
+            // e^(1/x) at a steep enough zoom). A flat segment is only drawn
+            // if the expression is bounded over it; otherwise keep splitting,
+            // and at the last level stop the strip right at the pole.
+            bool flat = error <= options.tolerance;
+            if (flat && !seg.bounded) {
+                seg.bounded = ctx.isBounded(seg);
+            }
+            if (flat && !seg.bounded) {
+                flat = false;
+                if (depth == maxDepth) {
+                    next.push_back({seg.p1, seg.p2, EDGE_SEGMENT, seg.bounded});
+                    continue;
+                }
+            }
+
+            if (flat) {
+                next.push_back({seg.p1, seg.p2, EMIT_SEGMENT, seg.bounded});
+            } else if (depth < maxDepth) {
+                next.push_back({seg.p1, mid, PENDING_SEGMENT, seg.bounded});
+                next.push_back({mid, seg.p2, PENDING_SEGMENT, seg.bounded});
+            } else {
+                next.push_back({seg.p1, seg.p2, BREAK_SEGMENT, seg.bounded});
+            }
+        }
+        segments.swap(next);
     }
 }
 
-std::vector<std::vector<float>> generateGraphPoints(const char* equation, GraphView view) {
-    std::vector<std::vector<float>> strips;
-    Expression expr = Expression::parse(equation);
-    if (!expr.isValid()) {
-        throw std::runtime_error("Invalid equation: " + expr.getError());
-    }
+StripBuffer generateGraphPoints(const char* equation, GraphView view) {
+    return generateGraphPoints(Expression::parse(equation), view);
+}
 
-    SymbolTable symbols;
-    symbols.AddEntry("x");
+StripBuffer generateGraphPoints(const Expression& expr, GraphView view) {
+    return generateGraphPoints(expr, view, TessellationOptions());
+}
+
+StripBuffer generateGraphPoints(
+    const Expression& expr, GraphView view,
+    const TessellationOptions& options, TessellationStats* stats
+) {
+    StripBuffer strips;
+    generateGraphPoints(expr, view, options, strips, stats);
+    return strips;
+}
+
+bool needsDoublePrecision(GraphView view, const TessellationOptions& options) {
+    // Float spacing around the view against the size of a tolerance on screen
+    auto unresolved = [&](double lo, double hi) {
+        double magnitude = std::max(std::abs(lo), std::abs(hi));
+        double resolution = (hi - lo) * options.tolerance * 0.125;
+        return magnitude * std::numeric_limits<float>::epsilon() > resolution;
+    };
+    return unresolved(view.minX, view.maxX) || unresolved(view.minY, view.maxY);
+}
+
+template <typename T>
+static void tessellate(
+    const Expression& expr, GraphView view, const SymbolTable& symbols,
+    const TessellationOptions& options, TessellationStats& counts, StripBuffer& strips
+) {
+
+    const int xSlot = symbols.GetIndex("x");
+    std::vector<T> frame(symbols.GetCount(), T(0));
+
+    auto makeContext = [&](TessellationStats& chunkCounts) {
+        return TessellationContext<T>{
+            expr, frame.data(), symbols.GetFrame(), xSlot,
+            view.minY, view.maxY,
+            static_cast<T>(2.0 / (view.maxX - view.minX)), static_cast<T>(2.0 / (view.maxY - view.minY)),
+            options, chunkCounts
+        };
+    };
+    TessellationContext<T> ctx = makeContext(counts);
+
+    const int numSegments = std::max(1, options.initialSegments);
+    double step = (view.maxX - view.minX) / numSegments;
 
-    float scaleX = 2.0f / (view.maxX - view.minX);
-    float scaleY = 2.0f / (view.maxY - view.minY);
+    // Evaluate all segment endpoints, plus the right edge, in one batch
+    std::vector<Sample<T>> samples(numSegments + 2);
+    std::vector<T> xs(numSegments + 2);
+    for (int i = 0; i <= numSegments; ++i) {
+        xs[i] = static_cast<T>(view.minX + i * step);
+    }
+    xs[numSegments + 1] = static_cast<T>(view.maxX);
+    if (options.metric == DERIVATIVE_METRIC) {
+        std::vector<DualNumber<T>> ds(xs.size());
+        expr.evaluateDualBatch(frame.data(), xSlot, xs.data(), ds.data(), xs.size());
+        for (size_t i = 0; i < xs.size(); ++i) samples[i] = {xs[i], ds[i].value, ds[i].d1, ds[i].d2};
+    } else {
+        std::vector<T> ys(xs.size());
+        expr.evaluateBatch(frame.data(), xSlot, xs.data(), ys.data(), xs.size());
+        for (size_t i = 0; i < xs.size(); ++i) samples[i] = {xs[i], ys[i], T(0), T(0)};
+    }
+    counts.evaluations += xs.size();
 
-    const float tolerance = 0.001f;
-    const int   maxDepth  = 12;
-    const int numSegments = 64;
-    float step = (view.maxX - view.minX) / numSegments;
+    // Bounded over the whole view means bounded over every segment,
+    // which spares most curves any further pole checks
+    bool bounded = ctx.isBounded(xs[0], xs[numSegments + 1]);
+
+    // Initial segments refine independently of each other, so runs of
+    // them go to the pool. Each lane of a batch is evaluated on its own,
+    // so how probes are grouped doesn't change a bit of the result.
+    const int numChunks = std::min(numSegments, std::max(1, options.chunks));
+    std::vector<std::vector<Segment<T>>> chunks(numChunks);
+    std::vector<TessellationStats> chunkCounts(numChunks);
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::global();
+    pool.parallelFor(chunks.size(), [&](size_t c) {
+        int first = static_cast<int>(c * numSegments / numChunks);
+        int last = static_cast<int>((c + 1) * numSegments / numChunks);
+        std::vector<Segment<T>>& segments = chunks[c];
+        segments.reserve(last - first);
+        for (int i = first; i < last; ++i) {
+            segments.push_back({samples[i], samples[i + 1], PENDING_SEGMENT, bounded});
+        }
+        adaptiveTessellate(makeContext(chunkCounts[c]), segments);
+    });
+    if (options.cancel && options.cancel->isCancelled()) return;
 
+    // Stitch in x order: a strip carries on across chunk boundaries
+    // exactly as it does across segments
+    const ScreenMap screen(view);
     bool inStrip = false;
+    for (int c = 0; c < numChunks; ++c) {
+        counts.evaluations += chunkCounts[c].evaluations;
+        counts.intervalEvaluations += chunkCounts[c].intervalEvaluations;
+        for (const Segment<T>& seg : chunks[c]) {
+            if (seg.state == EMIT_SEGMENT || (seg.state == EDGE_SEGMENT && isFinite(seg.p1.y))) {
+                emitVertex(seg.p1.x, seg.p1.y, screen, strips, inStrip);
+            }
+            if (seg.state != EMIT_SEGMENT) inStrip = false;
+        }
+    }
 
-    for (int i = 0; i < numSegments; ++i) {
-        float x1 = view.minX + i * step;
-        float x2 = view.minX + (i + 1) * step;
-        symbols.SetValue("x", x1);
-        float y1 = expr.evaluate(symbols);
-        symbols.SetValue("x", x2);
-        float y2 = expr.evaluate(symbols);
-        adaptiveTessellate(expr, symbols, x1, y1, x2, y2, view, strips, inStrip, scaleX, scaleY, tolerance, 0, maxDepth);
+    const Sample<T>& last = samples[numSegments + 1];
+    if (isFinite(last.y)) {
+        emitVertex(last.x, last.y, screen, strips, inStrip);
     }
+    strips.finish();
+
+    counts.vertices += strips.vertexCount();
+}
 
-    float finalX = view.maxX;
-    symbols.SetValue("x", finalX);
-    float finalY = expr.evaluate(symbols);
-    if (isFinite(finalY)) {
-        emitVertex(finalX, finalY, view, strips, inStrip);
+void generateGraphPoints(
+    const Expression& expr, GraphView view,
+    const TessellationOptions& options, StripBuffer& strips, TessellationStats* stats
+) {
+    strips.clear();
+    if (!expr.isValid()) {
+        throw std::runtime_error("Invalid equation: " + expr.getError());
+    }
+
+    // <expr> may be shared, so it can't be bound to our table. Lay the
+    // table out like the program instead; only its layout is used.
+    SymbolTable symbols;
+    for (const std::string& name : expr.getProgram().getVariables()) {
+        if (name != "x") {
+            throw std::runtime_error("Invalid equation: Variable " + name + " does not exist in the symbol table");
+        }
+        symbols.AddEntry(name);
     }
 
-    strips.erase(
-        std::remove_if(strips.begin(), strips.end(),
-                       [](const std::vector<float>& s) { return s.size() < 6; }),
-        strips.end()
-    );
+    TessellationStats localStats;
+    TessellationStats& counts = stats ? *stats : localStats;
+    counts = TessellationStats();
 
-    return strips;
+    bool wide = options.precision == DOUBLE_PRECISION ||
+                (options.precision == AUTO_PRECISION && needsDoublePrecision(view, options));
+    counts.doublePrecision = wide;
+    if (wide) tessellate<double>(expr, view, symbols, options, counts, strips);
+    else      tessellate<float>(expr, view, symbols, options, counts, strips);
 }
@@ -1,11 +1,69 @@
 #ifndef _VERTEX_GENERATOR_H_
 #define _VERTEX_GENERATOR_H_
 
+#include "StripBuffer.h"
 #include <assist.h>
+#include <CancelToken.h>
 #include <Expression.h>
+#include <ThreadPool.h>
 #include <vector>
 #include <cmath>
 
-std::vector<std::vector<float>> generateGraphPoints(const char* equation, GraphView view);
+// How the tessellator measures a segment's deviation from the curve
+enum ErrorMetric {
+    PROBE_METRIC,       // sample f at 1/4, 1/2, 3/4 of every segment
+    DERIVATIVE_METRIC   // bound it from f' and f'' at the endpoints (see Dual.h). Fewer
+                        // evaluations, but duals run one point at a time, so no faster yet
+};
 
-#endif /* _VERTEX_GENERATOR_H_ */
\ No newline at end of file
+// Scalar type the tessellator samples in. Double keeps deep zooms far
+// from the origin, where neighbouring floats are farther apart than a
+// pixel, from collapsing into steps.
+enum ScalarPrecision {
+    AUTO_PRECISION,     // double only where needsDoublePrecision()
+    FLOAT_PRECISION,
+    DOUBLE_PRECISION
+};
+
+struct TessellationOptions {
+    ErrorMetric metric = PROBE_METRIC;
+    ScalarPrecision precision = AUTO_PRECISION;
+    float tolerance = 0.001f;   // max distance of the curve from a line, in screen units
+    int maxDepth = 12;          // subdivision levels below the initial segments
+    int initialSegments = 64;
+    int chunks = 8;             // runs of initial segments refined in parallel; same output for any value
+    ThreadPool* pool = nullptr; // runs the chunks; ThreadPool::global() if null
+    const CancelToken* cancel = nullptr;  // checked once a level; cancelled runs return no strips
+};
+
+// What one tessellation cost
+struct TessellationStats {
+    size_t evaluations = 0;          // points evaluated, with derivatives for DERIVATIVE_METRIC
+    size_t intervalEvaluations = 0;  // Expression::evaluateInterval() calls
+    size_t vertices = 0;             // vertices emitted
+    bool doublePrecision = false;    // sampled in double
+};
+
+// Whether float is too coarse for <view>: true once the float spacing
+// around the view's bounds approaches the tolerance in world units
+bool needsDoublePrecision(GraphView view, const TessellationOptions& options);
+
+// Parse <equation> and tessellate it over <view>
+StripBuffer generateGraphPoints(const char* equation, GraphView view);
+
+// Tessellate an already compiled y = f(x) over <view>. Throws if it is
+// invalid or reads variables other than x.
+StripBuffer generateGraphPoints(const Expression& expr, GraphView view);
+
+// Same, with explicit settings. Fills <stats> if given.
+StripBuffer generateGraphPoints(
+    const Expression& expr, GraphView view,
+    const TessellationOptions& options, TessellationStats* stats = nullptr);
+
+// Same, into <strips>: cleared first, its capacity kept. Fed the previous
+// build's buffer, a steady pan emits without allocating.
+void generateGraphPoints(
+    const Expression& expr, GraphView view,
+    const TessellationOptions& options, StripBuffer& strips, TessellationStats* stats = nullptr);
+
+#endif /* _VERTEX_GENERATOR_H_ */
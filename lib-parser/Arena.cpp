@@ -0,0 +1,66 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+Arena::Arena(size_t chunkSize)
+    : cursor(nullptr), limit(nullptr), chunkSize(chunkSize),
+      allocationCount(0), bytesUsed(0), bytesReserved(0) {}
+
+Arena::Arena(Arena&& other) noexcept
+    : chunks(std::move(other.chunks)), cursor(other.cursor), limit(other.limit),
+      chunkSize(other.chunkSize), allocationCount(other.allocationCount),
+      bytesUsed(other.bytesUsed), bytesReserved(other.bytesReserved) {
+    other.chunks.clear();
+    other.cursor = other.limit = nullptr;
+    other.allocationCount = other.bytesUsed = other.bytesReserved = 0;
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        chunks = std::move(other.chunks);
+        cursor = other.cursor;
+        limit = other.limit;
+        chunkSize = other.chunkSize;
+        allocationCount = other.allocationCount;
+        bytesUsed = other.bytesUsed;
+        bytesReserved = other.bytesReserved;
+
+        other.chunks.clear();
+        other.cursor = other.limit = nullptr;
+        other.allocationCount = other.bytesUsed = other.bytesReserved = 0;
+    }
+    return *this;
+}
+
+// Start a new chunk big enough for <minimum> bytes at any alignment.
+// Oversized requests get a chunk of their own.
+void Arena::grow(size_t minimum) {
+    size_t size = std::max(chunkSize, minimum + alignof(std::max_align_t));
+    chunks.push_back(std::make_unique<char[]>(size));
+    cursor = chunks.back().get();
+    limit = cursor + size;
+    bytesReserved += size;
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(cursor);
+    uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    if (!cursor || aligned + bytes > reinterpret_cast<uintptr_t>(limit)) {
+        grow(bytes + alignment);
+        address = reinterpret_cast<uintptr_t>(cursor);
+        aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    cursor = reinterpret_cast<char*>(aligned + bytes);
+    allocationCount++;
+    bytesUsed += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+std::string_view Arena::copyString(std::string_view text) {
+    char* copy = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(copy, text.data(), text.size());
+    return std::string_view(copy, text.size());
+}
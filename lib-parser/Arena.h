@@ -0,0 +1,59 @@
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump allocator for everything a parse produces. Objects are carved out of
+// a few large chunks and all released together when the arena dies; nothing
+// is freed individually and destructors are never run, so only trivially
+// destructible types may be created in it.
+class Arena {
+    private:
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* cursor;
+        char* limit;
+        size_t chunkSize;
+
+        size_t allocationCount;
+        size_t bytesUsed;
+        size_t bytesReserved;
+
+        void grow(size_t minimum);
+
+    public:
+        static constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+        explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+        // Moving keeps every pointer into the arena valid (chunks don't move)
+        Arena(Arena&& other) noexcept;
+        Arena& operator=(Arena&& other) noexcept;
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T, typename... Args>
+        T* create(Args&&... args) {
+            static_assert(std::is_trivially_destructible<T>::value,
+                          "Arena never runs destructors");
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Copy <text> into the arena
+        std::string_view copyString(std::string_view text);
+
+        // Allocation statistics since construction
+        size_t getAllocationCount() const { return allocationCount; }
+        size_t getBytesUsed() const { return bytesUsed; }
+        size_t getBytesReserved() const { return bytesReserved; }
+        size_t getChunkCount() const { return chunks.size(); }
+};
+
+#endif /* _ARENA_H_ */
@@ -0,0 +1,583 @@
+#include "Bytecode.h"
+#include "VectorOps.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+// Programs at most this deep run on a stack array, deeper ones on the heap
+static constexpr int INLINE_STACK_SIZE = 64;
+
+
+// Token -> OpCode mapping
+// -----------------------
+static OpCode getUnaryOpCode(TokenType type) {
+    switch (type) {
+        case MINUS_TOKEN:       return OP_NEG;
+        case SIN_TOKEN:         return OP_SIN;
+        case COS_TOKEN:         return OP_COS;
+        case TAN_TOKEN:         return OP_TAN;
+        case COT_TOKEN:         return OP_COT;
+        case SEC_TOKEN:         return OP_SEC;
+        case CSC_TOKEN:         return OP_CSC;
+        case ARCSIN_TOKEN:      return OP_ARCSIN;
+        case ARCCOS_TOKEN:      return OP_ARCCOS;
+        case ARCTAN_TOKEN:      return OP_ARCTAN;
+        case ARCCOT_TOKEN:      return OP_ARCCOT;
+        case ARCSEC_TOKEN:      return OP_ARCSEC;
+        case ARCCSC_TOKEN:      return OP_ARCCSC;
+        case LOG_TOKEN:         return OP_LOG;
+        case LN_TOKEN:          return OP_LN;
+        case SQRT_TOKEN:        return OP_SQRT;
+        case FACTORIAL_TOKEN:   return OP_FACTORIAL;
+        case ABS_TOKEN:         return OP_ABS;
+        case FLOOR_TOKEN:       return OP_FLOOR;
+        case CEIL_TOKEN:        return OP_CEIL;
+        default:
+            throw std::runtime_error("Cannot compile unary operator: " + TokenClass::GetTokenTypeName(type));
+    }
+}
+
+static OpCode getBinaryOpCode(TokenType type) {
+    switch (type) {
+        case PLUS_TOKEN:    return OP_ADD;
+        case MINUS_TOKEN:   return OP_SUB;
+        case TIMES_TOKEN:   return OP_MUL;
+        case DIVIDE_TOKEN:  return OP_DIV;
+        case EXP_TOKEN:     return OP_POW;
+        default:
+            throw std::runtime_error("Cannot compile binary operator: " + TokenClass::GetTokenTypeName(type));
+    }
+}
+
+bool isUnaryOp(OpCode op) {
+    return op >= OP_NEG && op <= OP_CEIL;
+}
+
+bool isBinaryOp(OpCode op) {
+    return op >= OP_ADD && op <= OP_POW;
+}
+
+
+// Serialization
+// -------------
+// Layout: u32 code count, u32 constant count, u32 variable count,
+// i32 stack depth, u8 math mode, then code (8-byte Instruction records,
+// padding zeroed), constants, wide constants, and each variable name as
+// u32 length + bytes.
+template <typename T>
+static void appendRaw(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Bounds-checked reads over a blob
+struct BlobReader {
+    const uint8_t* data;
+    const uint8_t* end;
+
+    void read(void* dst, size_t size) {
+        if (size > static_cast<size_t>(end - data)) {
+            throw std::runtime_error("Truncated program data");
+        }
+        std::memcpy(dst, data, size);
+        data += size;
+    }
+
+    template <typename T>
+    T read() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+};
+
+void Program::serialize(std::vector<uint8_t>& out) const {
+    appendRaw(out, static_cast<uint32_t>(code.size()));
+    appendRaw(out, static_cast<uint32_t>(constants.size()));
+    appendRaw(out, static_cast<uint32_t>(variables.size()));
+    appendRaw(out, static_cast<int32_t>(stackDepth));
+    appendRaw(out, static_cast<uint8_t>(mathMode));
+
+    for (const Instruction& instruction : code) {
+        uint8_t record[sizeof(Instruction)] = {};
+        record[offsetof(Instruction, op)] = instruction.op;
+        std::memcpy(record + offsetof(Instruction, arg), &instruction.arg, sizeof(uint32_t));
+        out.insert(out.end(), record, record + sizeof(record));
+    }
+
+    const uint8_t* floats = reinterpret_cast<const uint8_t*>(constants.data());
+    out.insert(out.end(), floats, floats + constants.size() * sizeof(float));
+    const uint8_t* doubles = reinterpret_cast<const uint8_t*>(wideConstants.data());
+    out.insert(out.end(), doubles, doubles + wideConstants.size() * sizeof(double));
+
+    for (const std::string& name : variables) {
+        appendRaw(out, static_cast<uint32_t>(name.size()));
+        out.insert(out.end(), name.begin(), name.end());
+    }
+}
+
+Program Program::deserialize(const uint8_t* data, size_t size) {
+    BlobReader reader{data, data + size};
+    Program program;
+
+    uint32_t codeCount = reader.read<uint32_t>();
+    uint32_t constantCount = reader.read<uint32_t>();
+    uint32_t variableCount = reader.read<uint32_t>();
+    program.stackDepth = reader.read<int32_t>();
+    uint8_t mode = reader.read<uint8_t>();
+    if (mode > FAST_MATH) {
+        throw std::runtime_error("Unknown math mode in program data");
+    }
+    program.mathMode = static_cast<MathMode>(mode);
+
+    // Check the counts against what's left before allocating for them
+    size_t remaining = static_cast<size_t>(reader.end - reader.data);
+    if (codeCount > remaining / sizeof(Instruction) ||
+        constantCount > remaining / (sizeof(float) + sizeof(double)) ||
+        variableCount > remaining / sizeof(uint32_t)) {
+        throw std::runtime_error("Truncated program data");
+    }
+
+    program.code.resize(codeCount);
+    reader.read(program.code.data(), codeCount * sizeof(Instruction));
+    program.constants.resize(constantCount);
+    reader.read(program.constants.data(), constantCount * sizeof(float));
+    program.wideConstants.resize(constantCount);
+    reader.read(program.wideConstants.data(), constantCount * sizeof(double));
+
+    program.variables.resize(variableCount);
+    for (std::string& name : program.variables) {
+        uint32_t length = reader.read<uint32_t>();
+        if (length > static_cast<size_t>(reader.end - reader.data)) {
+            throw std::runtime_error("Truncated program data");
+        }
+        name.assign(reinterpret_cast<const char*>(reader.data), length);
+        reader.data += length;
+    }
+    if (reader.data != reader.end) {
+        throw std::runtime_error("Trailing bytes after program data");
+    }
+
+    // Replay the stack effect of every instruction
+    int depth = 0;
+    int maxDepth = 0;
+    for (const Instruction& instruction : program.code) {
+        if (instruction.op == OP_CONST || instruction.op == OP_VAR) {
+            uint32_t limit = (instruction.op == OP_CONST) ? constantCount : variableCount;
+            if (instruction.arg >= limit) {
+                throw std::runtime_error("Operand out of range in program data");
+            }
+            depth++;
+        } else if (isUnaryOp(instruction.op)) {
+            if (depth < 1) throw std::runtime_error("Stack underflow in program data");
+        } else if (isBinaryOp(instruction.op)) {
+            if (depth < 2) throw std::runtime_error("Stack underflow in program data");
+            depth--;
+        } else {
+            throw std::runtime_error("Unknown opcode in program data");
+        }
+        maxDepth = std::max(maxDepth, depth);
+    }
+    if ((!program.code.empty() && depth != 1) || maxDepth != program.stackDepth) {
+        throw std::runtime_error("Unbalanced stack in program data");
+    }
+
+    return program;
+}
+
+
+// Compilation
+// -----------
+Program Program::compile(const Node& root) {
+    Program program;
+    program.emit(root, 0);
+    return program;
+}
+
+void Program::bind(const SymbolTable& symbols) {
+    std::vector<int> slots(variables.size());
+    for (size_t i = 0; i < variables.size(); ++i) {
+        slots[i] = symbols.GetIndex(variables[i]);
+        if (slots[i] == -1) {
+            throw std::runtime_error("Variable " + variables[i] + " does not exist in the symbol table");
+        }
+    }
+
+    for (Instruction& instruction : code) {
+        if (instruction.op == OP_VAR) {
+            instruction.arg = static_cast<uint32_t>(slots[instruction.arg]);
+        }
+    }
+
+    // The frame layout is now the symbol table's
+    variables.clear();
+    for (size_t i = 0; i < symbols.GetCount(); ++i) {
+        variables.push_back(symbols.GetLabel(static_cast<int>(i)));
+    }
+}
+
+// Post-order walk. <depth> is the stack slot the node's result lands in.
+void Program::emit(const Node& node, int depth) {
+    stackDepth = std::max(stackDepth, depth + 1);
+
+    switch (node.getType()) {
+        case CONSTANT_NODE: {
+            const auto& constant = static_cast<const ConstantNode&>(node);
+            code.push_back({OP_CONST, static_cast<uint32_t>(constants.size())});
+            constants.push_back(constant.getValue());
+            wideConstants.push_back(constant.getWideValue());
+            break;
+        }
+        case VARIABLE_NODE: {
+            std::string_view name = static_cast<const VariableNode&>(node).getName();
+            auto it = std::find(variables.begin(), variables.end(), name);
+            uint32_t slot = static_cast<uint32_t>(it - variables.begin());
+            if (it == variables.end()) {
+                variables.emplace_back(name);
+            }
+            code.push_back({OP_VAR, slot});
+            break;
+        }
+        case UNARY_NODE: {
+            const auto& unary = static_cast<const UnaryOpNode&>(node);
+            emit(unary.getOperand(), depth);
+            code.push_back({getUnaryOpCode(unary.getOpType()), 0});
+            break;
+        }
+        case BINARY_NODE: {
+            const auto& binary = static_cast<const BinaryOpNode&>(node);
+            emit(binary.getLeft(), depth);
+            emit(binary.getRight(), depth + 1);
+            code.push_back({getBinaryOpCode(binary.getOpType()), 0});
+            break;
+        }
+    }
+}
+
+
+// Interpreter
+// -----------
+// Instantiated for float and for double, which reads wideConstants
+template <typename T>
+static T execute(const Instruction* code, size_t count,
+                 const T* constants, const T* frame, T* stack) {
+    T* top = stack - 1;
+
+    for (const Instruction* ip = code, *end = code + count; ip != end; ++ip) {
+        switch (ip->op) {
+            case OP_CONST:      *++top = constants[ip->arg]; break;
+            case OP_VAR:        *++top = frame[ip->arg]; break;
+
+            case OP_NEG:        *top = op_negate(*top); break;
+            case OP_SIN:        *top = op_sin(*top); break;
+            case OP_COS:        *top = op_cos(*top); break;
+            case OP_TAN:        *top = op_tan(*top); break;
+            case OP_COT:        *top = op_cot(*top); break;
+            case OP_SEC:        *top = op_sec(*top); break;
+            case OP_CSC:        *top = op_csc(*top); break;
+            case OP_ARCSIN:     *top = op_arcsin(*top); break;
+            case OP_ARCCOS:     *top = op_arccos(*top); break;
+            case OP_ARCTAN:     *top = op_arctan(*top); break;
+            case OP_ARCCOT:     *top = op_arccot(*top); break;
+            case OP_ARCSEC:     *top = op_arcsec(*top); break;
+            case OP_ARCCSC:     *top = op_arccsc(*top); break;
+            case OP_LOG:        *top = op_log(*top); break;
+            case OP_LN:         *top = op_ln(*top); break;
+            case OP_SQRT:       *top = op_sqrt(*top); break;
+            case OP_FACTORIAL:  *top = op_factorial(*top); break;
+            case OP_ABS:        *top = op_abs(*top); break;
+            case OP_FLOOR:      *top = op_floor(*top); break;
+            case OP_CEIL:       *top = op_ceil(*top); break;
+
+            case OP_ADD:        top[-1] = op_add(top[-1], top[0]); --top; break;
+            case OP_SUB:        top[-1] = op_sub(top[-1], top[0]); --top; break;
+            case OP_MUL:        top[-1] = op_mul(top[-1], top[0]); --top; break;
+            case OP_DIV:        top[-1] = op_div(top[-1], top[0]); --top; break;
+            case OP_POW:        top[-1] = op_pow(top[-1], top[0]); --top; break;
+
+            case LAST_OP:       break;
+        }
+    }
+
+    return *top;
+}
+
+template <typename T>
+static T runStack(const std::vector<Instruction>& code, const std::vector<T>& constants,
+                  int stackDepth, const T* frame) {
+    if (stackDepth <= INLINE_STACK_SIZE) {
+        T stack[INLINE_STACK_SIZE];
+        return execute(code.data(), code.size(), constants.data(), frame, stack);
+    }
+
+    std::vector<T> stack(stackDepth);
+    return execute(code.data(), code.size(), constants.data(), frame, stack.data());
+}
+
+float Program::run(const float* frame) const {
+    return runStack(code, constants, stackDepth, frame);
+}
+
+double Program::run(const double* frame) const {
+    return runStack(code, wideConstants, stackDepth, frame);
+}
+
+
+// Interval interpreter
+// --------------------
+// Same walk as execute(), on intervals. Not a hot path: runs once per
+// tessellation segment, not per sample.
+static Interval executeInterval(const Instruction* code, size_t count,
+                                const float* constants, const Interval* frame, Interval* stack) {
+    Interval* top = stack - 1;
+
+    for (const Instruction* ip = code, *end = code + count; ip != end; ++ip) {
+        switch (ip->op) {
+            case OP_CONST:      *++top = Interval::point(constants[ip->arg]); break;
+            case OP_VAR:        *++top = frame[ip->arg]; break;
+
+            case OP_NEG:        *top = iv_negate(*top); break;
+            case OP_SIN:        *top = iv_sin(*top); break;
+            case OP_COS:        *top = iv_cos(*top); break;
+            case OP_TAN:        *top = iv_tan(*top); break;
+            case OP_COT:        *top = iv_cot(*top); break;
+            case OP_SEC:        *top = iv_sec(*top); break;
+            case OP_CSC:        *top = iv_csc(*top); break;
+            case OP_ARCSIN:     *top = iv_arcsin(*top); break;
+            case OP_ARCCOS:     *top = iv_arccos(*top); break;
+            case OP_ARCTAN:     *top = iv_arctan(*top); break;
+            case OP_ARCCOT:     *top = iv_arccot(*top); break;
+            case OP_ARCSEC:     *top = iv_arcsec(*top); break;
+            case OP_ARCCSC:     *top = iv_arccsc(*top); break;
+            case OP_LOG:        *top = iv_log(*top); break;
+            case OP_LN:         *top = iv_ln(*top); break;
+            case OP_SQRT:       *top = iv_sqrt(*top); break;
+            case OP_FACTORIAL:  *top = iv_factorial(*top); break;
+            case OP_ABS:        *top = iv_abs(*top); break;
+            case OP_FLOOR:      *top = iv_floor(*top); break;
+            case OP_CEIL:       *top = iv_ceil(*top); break;
+
+            case OP_ADD:        top[-1] = iv_add(top[-1], top[0]); --top; break;
+            case OP_SUB:        top[-1] = iv_sub(top[-1], top[0]); --top; break;
+            case OP_MUL:        top[-1] = iv_mul(top[-1], top[0]); --top; break;
+            case OP_DIV:        top[-1] = iv_div(top[-1], top[0]); --top; break;
+            case OP_POW:        top[-1] = iv_pow(top[-1], top[0]); --top; break;
+
+            case LAST_OP:       break;
+        }
+    }
+
+    return *top;
+}
+
+Interval Program::runInterval(const Interval* frame) const {
+    if (stackDepth <= INLINE_STACK_SIZE) {
+        Interval stack[INLINE_STACK_SIZE];
+        return executeInterval(code.data(), code.size(), constants.data(), frame, stack);
+    }
+
+    std::vector<Interval> stack(stackDepth);
+    return executeInterval(code.data(), code.size(), constants.data(), frame, stack.data());
+}
+
+
+// Dual interpreter
+// ----------------
+// Same walk again, carrying derivatives along (forward-mode AD)
+template <typename T>
+static DualNumber<T> executeDual(const Instruction* code, size_t count, const T* constants,
+                                 const DualNumber<T>* frame, DualNumber<T>* stack) {
+    DualNumber<T>* top = stack - 1;
+
+    for (const Instruction* ip = code, *end = code + count; ip != end; ++ip) {
+        switch (ip->op) {
+            case OP_CONST:      *++top = DualNumber<T>::constant(constants[ip->arg]); break;
+            case OP_VAR:        *++top = frame[ip->arg]; break;
+
+            case OP_NEG:        *top = dual_negate(*top); break;
+            case OP_SIN:        *top = dual_sin(*top); break;
+            case OP_COS:        *top = dual_cos(*top); break;
+            case OP_TAN:        *top = dual_tan(*top); break;
+            case OP_COT:        *top = dual_cot(*top); break;
+            case OP_SEC:        *top = dual_sec(*top); break;
+            case OP_CSC:        *top = dual_csc(*top); break;
+            case OP_ARCSIN:     *top = dual_arcsin(*top); break;
+            case OP_ARCCOS:     *top = dual_arccos(*top); break;
+            case OP_ARCTAN:     *top = dual_arctan(*top); break;
+            case OP_ARCCOT:     *top = dual_arccot(*top); break;
+            case OP_ARCSEC:     *top = dual_arcsec(*top); break;
+            case OP_ARCCSC:     *top = dual_arccsc(*top); break;
+            case OP_LOG:        *top = dual_log(*top); break;
+            case OP_LN:         *top = dual_ln(*top); break;
+            case OP_SQRT:       *top = dual_sqrt(*top); break;
+            case OP_FACTORIAL:  *top = dual_factorial(*top); break;
+            case OP_ABS:        *top = dual_abs(*top); break;
+            case OP_FLOOR:      *top = dual_floor(*top); break;
+            case OP_CEIL:       *top = dual_ceil(*top); break;
+
+            case OP_ADD:        top[-1] = dual_add(top[-1], top[0]); --top; break;
+            case OP_SUB:        top[-1] = dual_sub(top[-1], top[0]); --top; break;
+            case OP_MUL:        top[-1] = dual_mul(top[-1], top[0]); --top; break;
+            case OP_DIV:        top[-1] = dual_div(top[-1], top[0]); --top; break;
+            case OP_POW:        top[-1] = dual_pow(top[-1], top[0]); --top; break;
+
+            case LAST_OP:       break;
+        }
+    }
+
+    return *top;
+}
+
+template <typename T>
+static DualNumber<T> runDualStack(const std::vector<Instruction>& code, const std::vector<T>& constants,
+                                  int stackDepth, const DualNumber<T>* frame) {
+    if (stackDepth <= INLINE_STACK_SIZE) {
+        DualNumber<T> stack[INLINE_STACK_SIZE];
+        return executeDual(code.data(), code.size(), constants.data(), frame, stack);
+    }
+
+    std::vector<DualNumber<T>> stack(stackDepth);
+    return executeDual(code.data(), code.size(), constants.data(), frame, stack.data());
+}
+
+Dual Program::runDual(const Dual* frame) const {
+    return runDualStack(code, constants, stackDepth, frame);
+}
+
+DualNumber<double> Program::runDual(const DualNumber<double>* frame) const {
+    return runDualStack(code, wideConstants, stackDepth, frame);
+}
+
+
+// Batch interpreter
+// -----------------
+// Same program, but each stack slot is a column of BATCH_WIDTH lanes and
+// every instruction runs over the whole column before the next one.
+template <typename T, typename Func>
+static inline void applyUnary(T* a, size_t n, Func func) {
+    for (size_t i = 0; i < n; ++i) a[i] = func(a[i]);
+}
+
+// FastMath kernels exist for float only; the double path stays on libm
+template <typename T, typename Func>
+static inline void applyTranscendental(T* a, size_t n, bool /*fast*/, void (* /*kernel*/)(float*, size_t), Func exact) {
+    applyUnary(a, n, exact);
+}
+
+template <typename Func>
+static inline void applyTranscendental(float* a, size_t n, bool fast, void (*kernel)(float*, size_t), Func exact) {
+    if (fast) kernel(a, n);
+    else      applyUnary(a, n, exact);
+}
+
+// <sharedBase>: every lane of <a> holds the same value, by construction
+template <typename T>
+static inline void applyPow(T* a, const T* b, size_t n, bool /*fast*/, bool /*sharedBase*/) {
+    vec_pow(a, b, n);
+}
+
+static inline void applyPow(float* a, const float* b, size_t n, bool fast, bool sharedBase) {
+    if (!fast)           vec_pow(a, b, n);
+    else if (sharedBase) fast_pow_shared_base(a, b, n);
+    else                 fast_pow(a, b, n);
+}
+
+template <typename T>
+static void executeBatch(const Instruction* code, size_t count,
+                         const T* constants, const T* frame,
+                         uint32_t varying, const T* values, size_t lanes,
+                         bool fast, T* stack) {
+    T* top = nullptr;
+    auto push = [&]() { top = top ? top + BATCH_WIDTH : stack; return top; };
+
+    // Bit d is set while stack slot d holds the same value in every lane
+    // because of what the program computed there, whatever the inputs.
+    // Slots past 63 count as varying.
+    uint64_t uniform = 0;
+    auto slot = [&]() { return static_cast<size_t>(top - stack) / BATCH_WIDTH; };
+    auto isUniform = [&](size_t d) { return d < 64 && ((uniform >> d) & 1) != 0; };
+    auto setUniform = [&](size_t d, bool same) {
+        if (d < 64) uniform = (uniform & ~(uint64_t(1) << d)) | (static_cast<uint64_t>(same) << d);
+    };
+    auto pop = [&]() {
+        top -= BATCH_WIDTH;
+        setUniform(slot(), isUniform(slot()) && isUniform(slot() + 1));
+    };
+
+    for (const Instruction* ip = code, *end = code + count; ip != end; ++ip) {
+        switch (ip->op) {
+            case OP_CONST:
+                vec_fill(push(), constants[ip->arg], lanes);
+                setUniform(slot(), true);
+                break;
+            case OP_VAR:
+                if (ip->arg == varying) std::memcpy(push(), values, lanes * sizeof(T));
+                else                    vec_fill(push(), frame[ip->arg], lanes);
+                setUniform(slot(), ip->arg != varying);
+                break;
+
+            case OP_NEG:        vec_negate(top, lanes); break;
+            case OP_SIN:        applyTranscendental(top, lanes, fast, fast_sin, op_sin<T>); break;
+            case OP_COS:        applyTranscendental(top, lanes, fast, fast_cos, op_cos<T>); break;
+            case OP_TAN:        applyTranscendental(top, lanes, fast, fast_tan, op_tan<T>); break;
+            case OP_COT:        applyUnary(top, lanes, op_cot<T>); break;
+            case OP_SEC:        applyUnary(top, lanes, op_sec<T>); break;
+            case OP_CSC:        applyUnary(top, lanes, op_csc<T>); break;
+            case OP_ARCSIN:     applyUnary(top, lanes, op_arcsin<T>); break;
+            case OP_ARCCOS:     applyUnary(top, lanes, op_arccos<T>); break;
+            case OP_ARCTAN:     applyUnary(top, lanes, op_arctan<T>); break;
+            case OP_ARCCOT:     applyUnary(top, lanes, op_arccot<T>); break;
+            case OP_ARCSEC:     applyUnary(top, lanes, op_arcsec<T>); break;
+            case OP_ARCCSC:     applyUnary(top, lanes, op_arccsc<T>); break;
+            case OP_LOG:        applyTranscendental(top, lanes, fast, fast_log10, op_log<T>); break;
+            case OP_LN:         applyTranscendental(top, lanes, fast, fast_ln, op_ln<T>); break;
+            case OP_SQRT:       vec_sqrt(top, lanes); break;
+            case OP_FACTORIAL:  applyUnary(top, lanes, op_factorial<T>); break;
+            case OP_ABS:        vec_abs(top, lanes); break;
+            case OP_FLOOR:      applyUnary(top, lanes, op_floor<T>); break;
+            case OP_CEIL:       applyUnary(top, lanes, op_ceil<T>); break;
+
+            case OP_ADD:        vec_add(top - BATCH_WIDTH, top, lanes); pop(); break;
+            case OP_SUB:        vec_sub(top - BATCH_WIDTH, top, lanes); pop(); break;
+            case OP_MUL:        vec_mul(top - BATCH_WIDTH, top, lanes); pop(); break;
+            case OP_DIV:        vec_div(top - BATCH_WIDTH, top, lanes); pop(); break;
+            case OP_POW:
+                applyPow(top - BATCH_WIDTH, top, lanes, fast, isUniform(slot() - 1));
+                pop();
+                break;
+
+            case LAST_OP:       break;
+        }
+    }
+}
+
+template <typename T>
+static void runBatchColumns(const std::vector<Instruction>& code, const std::vector<T>& constants,
+                            int stackDepth, MathMode mode, const T* frame, uint32_t varying,
+                            const T* values, T* out, size_t count) {
+    std::vector<T> heapStack;
+    T inlineStack[INLINE_STACK_SIZE * BATCH_WIDTH];
+    T* stack = inlineStack;
+    if (stackDepth > INLINE_STACK_SIZE) {
+        heapStack.resize(static_cast<size_t>(stackDepth) * BATCH_WIDTH);
+        stack = heapStack.data();
+    }
+
+    for (size_t start = 0; start < count; start += BATCH_WIDTH) {
+        size_t lanes = std::min(BATCH_WIDTH, count - start);
+        executeBatch(code.data(), code.size(), constants.data(), frame,
+                     varying, values + start, lanes, mode == FAST_MATH, stack);
+        std::memcpy(out + start, stack, lanes * sizeof(T));
+    }
+}
+
+void Program::runBatch(const float* frame, uint32_t varying,
+                       const float* values, float* out, size_t count) const {
+    runBatchColumns(code, constants, stackDepth, mathMode, frame, varying, values, out, count);
+}
+
+void Program::runBatch(const double* frame, uint32_t varying,
+                       const double* values, double* out, size_t count) const {
+    runBatchColumns(code, wideConstants, stackDepth, EXACT_MATH, frame, varying, values, out, count);
+}
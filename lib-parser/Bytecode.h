@@ -0,0 +1,118 @@
+#ifndef _BYTECODE_H_
+#define _BYTECODE_H_
+
+#include "Node.h"
+#include "Interval.h"
+#include "Dual.h"
+#include "FastMath.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Instruction set of the compiled expression program.
+// The program is postfix: operands are pushed, operators pop their
+// arguments and push the result back. Serialized programs store these
+// values: bump EXPRESSION_BLOB_VERSION (Expression.h) when changing them.
+enum OpCode : uint8_t {
+    // Loads
+    OP_CONST,           // push constants[arg]
+    OP_VAR,             // push frame[arg]
+
+    // Unary operations (pop 1, push 1)
+    OP_NEG,
+    OP_SIN, OP_COS, OP_TAN,
+    OP_COT, OP_SEC, OP_CSC,
+    OP_ARCSIN, OP_ARCCOS, OP_ARCTAN,
+    OP_ARCCOT, OP_ARCSEC, OP_ARCCSC,
+    OP_LOG, OP_LN, OP_SQRT, OP_FACTORIAL,
+    OP_ABS, OP_FLOOR, OP_CEIL,
+
+    // Binary operations (pop 2, push 1)
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,
+
+    LAST_OP
+};
+
+// Lanes processed together by Program::runBatch()
+constexpr size_t BATCH_WIDTH = 16;
+
+// Marks "no varying slot" for Program::runBatch()
+constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+struct Instruction {
+    OpCode op;
+    uint32_t arg;       // constant index for OP_CONST, frame slot for OP_VAR
+};
+
+// Program::serialize() writes code as raw Instruction records
+static_assert(sizeof(Instruction) == 8, "Instruction layout is part of the blob format");
+
+// Flat, contiguous form of an expression tree.
+// Evaluated by a non-virtual switch interpreter over a small value stack.
+class Program {
+    private:
+        std::vector<Instruction> code;
+        std::vector<float> constants;
+        std::vector<double> wideConstants;   // same literals, parsed in double
+        std::vector<std::string> variables;  // frame layout: slot -> name
+        int stackDepth = 0;
+        MathMode mathMode = EXACT_MATH;
+
+        void emit(const Node& node, int depth);
+
+    public:
+        Program() = default;
+
+        // Lower an AST into postfix bytecode
+        static Program compile(const Node& root);
+
+        // Re-point OP_VAR slots at <symbols>' layout so run() can take
+        // symbols.GetFrame() directly. Throws if a variable is missing.
+        void bind(const SymbolTable& symbols);
+
+        // Run the program. <frame> holds one value per entry of getVariables().
+        float run(const float* frame) const;
+        double run(const double* frame) const;
+
+        // Run the program over <count> inputs, BATCH_WIDTH lanes at a time.
+        // Slot <varying> reads values[i] in lane i, every other slot reads <frame>.
+        // The float overload follows getMathMode(); double always uses libm.
+        void runBatch(const float* frame, uint32_t varying,
+                      const float* values, float* out, size_t count) const;
+        void runBatch(const double* frame, uint32_t varying,
+                      const double* values, double* out, size_t count) const;
+
+        // Enclosure of every value the program takes with each variable
+        // ranging over its interval in <frame> (see Interval.h)
+        Interval runInterval(const Interval* frame) const;
+
+        // Value and derivatives, with respect to whichever frame entries
+        // carry non-zero derivatives (see Dual.h)
+        Dual runDual(const Dual* frame) const;
+        DualNumber<double> runDual(const DualNumber<double>* frame) const;
+
+        // Append the program to <out>: counts, then the code, constant
+        // and variable arrays as raw bytes in host byte order
+        void serialize(std::vector<uint8_t>& out) const;
+
+        // Rebuild a program from serialize()'s bytes. Every opcode, operand
+        // and the stack balance is checked, so a bad blob can't make run()
+        // read out of bounds. Throws on malformed input.
+        static Program deserialize(const uint8_t* data, size_t size);
+
+        // Transcendentals in runBatch(float): libm or the FastMath kernels
+        void setMathMode(MathMode mode) { mathMode = mode; }
+        MathMode getMathMode() const { return mathMode; }
+
+        bool empty() const { return code.empty(); }
+        const std::vector<Instruction>& getCode() const { return code; }
+        const std::vector<float>& getConstants() const { return constants; }
+        const std::vector<double>& getWideConstants() const { return wideConstants; }
+        const std::vector<std::string>& getVariables() const { return variables; }
+        int getStackDepth() const { return stackDepth; }
+};
+
+bool isUnaryOp(OpCode op);
+bool isBinaryOp(OpCode op);
+
+#endif /* _BYTECODE_H_ */
@@ -0,0 +1,271 @@
+#include "Dual.h"
+#include "Operations.h"
+#include <cmath>
+
+static constexpr double LN10 = 2.30258509299404568402;
+
+
+// Chain rule
+// ----------
+template <typename T>
+static inline bool isConstant(DualNumber<T> a) { return a.d1 == T(0) && a.d2 == T(0); }
+
+// g * d, where a zero derivative wins over an infinite g
+template <typename T>
+static inline T scale(T g, T d) { return d == T(0) ? T(0) : g * d; }
+
+// f(g(x)) with g = a: f' = g1 * a', f'' = g2 * a'^2 + g1 * a''
+template <typename T>
+static inline DualNumber<T> chain(DualNumber<T> a, T value, T g1, T g2) {
+    if (isConstant(a)) return DualNumber<T>::constant(value);
+    return {value, scale(g1, a.d1), scale(g2, a.d1 * a.d1) + scale(g1, a.d2)};
+}
+
+// Digamma and trigamma (derivatives of ln Gamma), for factorial.
+// Recurrence up to x >= 6, then the asymptotic series. Reflection
+// keeps large negative arguments from looping.
+static double digamma(double x) {
+    if (x < 0.0) {
+        return digamma(1.0 - x) - M_PI / std::tan(M_PI * x);
+    }
+    double result = 0.0;
+    for (; x < 6.0; x += 1.0) result -= 1.0 / x;
+    double r = 1.0 / (x * x);
+    return result + std::log(x) - 0.5 / x
+         - r * (1.0 / 12.0 - r * (1.0 / 120.0 - r * (1.0 / 252.0)));
+}
+
+static double trigamma(double x) {
+    if (x < 0.0) {
+        double s = std::sin(M_PI * x);
+        return M_PI * M_PI / (s * s) - trigamma(1.0 - x);
+    }
+    double result = 0.0;
+    for (; x < 6.0; x += 1.0) result += 1.0 / (x * x);
+    double r = 1.0 / (x * x);
+    return result + 1.0 / x + r / 2.0
+         + r / x * (1.0 / 6.0 - r * (1.0 / 30.0 - r * (1.0 / 42.0 - r * (1.0 / 30.0))));
+}
+
+
+// Binary kernels
+// --------------
+template <typename T>
+DualNumber<T> dual_add(DualNumber<T> a, DualNumber<T> b) {
+    return {op_add(a.value, b.value), a.d1 + b.d1, a.d2 + b.d2};
+}
+
+template <typename T>
+DualNumber<T> dual_sub(DualNumber<T> a, DualNumber<T> b) {
+    return {op_sub(a.value, b.value), a.d1 - b.d1, a.d2 - b.d2};
+}
+
+template <typename T>
+DualNumber<T> dual_mul(DualNumber<T> a, DualNumber<T> b) {
+    T value = op_mul(a.value, b.value);
+    if (isConstant(a) && isConstant(b)) return DualNumber<T>::constant(value);
+    return {
+        value,
+        scale(a.value, b.d1) + scale(b.value, a.d1),
+        scale(a.value, b.d2) + T(2) * a.d1 * b.d1 + scale(b.value, a.d2)
+    };
+}
+
+// q = a / b: q' = (a' - q b') / b, q'' = (a'' - 2 q' b' - q b'') / b
+template <typename T>
+DualNumber<T> dual_div(DualNumber<T> a, DualNumber<T> b) {
+    T q = op_div(a.value, b.value);
+    if (isConstant(a) && isConstant(b)) return DualNumber<T>::constant(q);
+    T d1 = (a.d1 - scale(q, b.d1)) / b.value;
+    T d2 = (a.d2 - T(2) * d1 * b.d1 - scale(q, b.d2)) / b.value;
+    return {q, d1, d2};
+}
+
+template <typename T>
+DualNumber<T> dual_pow(DualNumber<T> a, DualNumber<T> b) {
+    T value = op_pow(a.value, b.value);
+
+    // Constant exponent: power rule, which also holds for negative bases
+    if (isConstant(b)) {
+        T n = b.value;
+        T g1 = (n == T(0)) ? T(0) : n * std::pow(a.value, n - T(1));
+        T g2 = (n == T(0) || n == T(1)) ? T(0) : n * (n - T(1)) * std::pow(a.value, n - T(2));
+        return chain(a, value, g1, g2);
+    }
+
+    // a^b = e^(b ln a): with h = b ln a, f' = f h' and f'' = f (h'^2 + h'')
+    T lnA = std::log(a.value);
+    T h1 = scale(lnA, b.d1) + scale(b.value / a.value, a.d1);
+    T h2 = scale(lnA, b.d2) + T(2) * b.d1 * a.d1 / a.value
+         + scale(b.value / a.value, a.d2 - a.d1 * a.d1 / a.value);
+    return {value, value * h1, value * (h1 * h1 + h2)};
+}
+
+
+// Unary kernels
+// -------------
+template <typename T>
+DualNumber<T> dual_negate(DualNumber<T> a) {
+    return {op_negate(a.value), -a.d1, -a.d2};
+}
+
+template <typename T>
+DualNumber<T> dual_sin(DualNumber<T> a) {
+    T s = op_sin(a.value);
+    return chain(a, s, std::cos(a.value), -s);
+}
+
+template <typename T>
+DualNumber<T> dual_cos(DualNumber<T> a) {
+    T c = op_cos(a.value);
+    return chain(a, c, -std::sin(a.value), -c);
+}
+
+template <typename T>
+DualNumber<T> dual_tan(DualNumber<T> a) {
+    T t = op_tan(a.value);
+    T g1 = T(1) + t * t;
+    return chain(a, t, g1, T(2) * t * g1);
+}
+
+template <typename T>
+DualNumber<T> dual_cot(DualNumber<T> a) {
+    T c = op_cot(a.value);
+    T g1 = -(T(1) + c * c);
+    return chain(a, c, g1, T(-2) * c * g1);
+}
+
+template <typename T>
+DualNumber<T> dual_sec(DualNumber<T> a) {
+    T s = op_sec(a.value);
+    T t = std::tan(a.value);
+    return chain(a, s, s * t, s * (t * t + s * s));
+}
+
+template <typename T>
+DualNumber<T> dual_csc(DualNumber<T> a) {
+    T s = op_csc(a.value);
+    T c = std::cos(a.value) / std::sin(a.value);
+    return chain(a, s, -s * c, s * (c * c + s * s));
+}
+
+template <typename T>
+DualNumber<T> dual_arcsin(DualNumber<T> a) {
+    T u = a.value;
+    T r = T(1) / std::sqrt(T(1) - u * u);
+    return chain(a, op_arcsin(u), r, u * r * r * r);
+}
+
+template <typename T>
+DualNumber<T> dual_arccos(DualNumber<T> a) {
+    T u = a.value;
+    T r = T(1) / std::sqrt(T(1) - u * u);
+    return chain(a, op_arccos(u), -r, -u * r * r * r);
+}
+
+template <typename T>
+DualNumber<T> dual_arctan(DualNumber<T> a) {
+    T u = a.value;
+    T r = T(1) / (T(1) + u * u);
+    return chain(a, op_arctan(u), r, T(-2) * u * r * r);
+}
+
+template <typename T>
+DualNumber<T> dual_arccot(DualNumber<T> a) {
+    T u = a.value;
+    T r = T(1) / (T(1) + u * u);
+    return chain(a, op_arccot(u), -r, T(2) * u * r * r);
+}
+
+// op_arcsec(a) is acos(1 / a), op_arccsc(a) is asin(1 / a)
+template <typename T>
+DualNumber<T> dual_arcsec(DualNumber<T> a) {
+    return dual_arccos(dual_div(DualNumber<T>::constant(T(1)), a));
+}
+
+template <typename T>
+DualNumber<T> dual_arccsc(DualNumber<T> a) {
+    return dual_arcsin(dual_div(DualNumber<T>::constant(T(1)), a));
+}
+
+template <typename T>
+DualNumber<T> dual_log(DualNumber<T> a) {
+    T u = a.value;
+    T g1 = T(1) / (u * static_cast<T>(LN10));
+    return chain(a, op_log(u), g1, -g1 / u);
+}
+
+template <typename T>
+DualNumber<T> dual_ln(DualNumber<T> a) {
+    T u = a.value;
+    return chain(a, op_ln(u), T(1) / u, T(-1) / (u * u));
+}
+
+template <typename T>
+DualNumber<T> dual_sqrt(DualNumber<T> a) {
+    T u = a.value;
+    T s = op_sqrt(u);
+    return chain(a, s, T(0.5) / s, T(-0.25) / (s * u));
+}
+
+template <typename T>
+DualNumber<T> dual_abs(DualNumber<T> a) {
+    T u = a.value;
+    T sign = (u > T(0)) ? T(1) : (u < T(0)) ? T(-1) : T(0);
+    return chain(a, op_abs(u), sign, T(0));
+}
+
+// Piecewise constant: zero derivatives everywhere but the jumps
+template <typename T>
+DualNumber<T> dual_floor(DualNumber<T> a) {
+    return DualNumber<T>::constant(op_floor(a.value));
+}
+
+template <typename T>
+DualNumber<T> dual_ceil(DualNumber<T> a) {
+    return DualNumber<T>::constant(op_ceil(a.value));
+}
+
+// d/du Gamma(u + 1) = Gamma psi, d2/du2 = Gamma (psi^2 + psi')
+template <typename T>
+DualNumber<T> dual_factorial(DualNumber<T> a) {
+    T value = op_factorial(a.value);
+    double x = static_cast<double>(a.value) + 1.0;
+    double psi = digamma(x);
+    T g1 = static_cast<T>(value * psi);
+    T g2 = static_cast<T>(value * (psi * psi + trigamma(x)));
+    return chain(a, value, g1, g2);
+}
+
+
+// Instantiations
+// --------------
+#define INSTANTIATE_DUAL_KERNELS(T)                                           \
+    template DualNumber<T> dual_negate(DualNumber<T>);                        \
+    template DualNumber<T> dual_sin(DualNumber<T>);                           \
+    template DualNumber<T> dual_cos(DualNumber<T>);                           \
+    template DualNumber<T> dual_tan(DualNumber<T>);                           \
+    template DualNumber<T> dual_cot(DualNumber<T>);                           \
+    template DualNumber<T> dual_sec(DualNumber<T>);                           \
+    template DualNumber<T> dual_csc(DualNumber<T>);                           \
+    template DualNumber<T> dual_arcsin(DualNumber<T>);                        \
+    template DualNumber<T> dual_arccos(DualNumber<T>);                        \
+    template DualNumber<T> dual_arctan(DualNumber<T>);                        \
+    template DualNumber<T> dual_arccot(DualNumber<T>);                        \
+    template DualNumber<T> dual_arcsec(DualNumber<T>);                        \
+    template DualNumber<T> dual_arccsc(DualNumber<T>);                        \
+    template DualNumber<T> dual_log(DualNumber<T>);                           \
+    template DualNumber<T> dual_ln(DualNumber<T>);                            \
+    template DualNumber<T> dual_sqrt(DualNumber<T>);                          \
+    template DualNumber<T> dual_abs(DualNumber<T>);                           \
+    template DualNumber<T> dual_floor(DualNumber<T>);                         \
+    template DualNumber<T> dual_ceil(DualNumber<T>);                          \
+    template DualNumber<T> dual_factorial(DualNumber<T>);                     \
+    template DualNumber<T> dual_add(DualNumber<T>, DualNumber<T>);            \
+    template DualNumber<T> dual_sub(DualNumber<T>, DualNumber<T>);            \
+    template DualNumber<T> dual_mul(DualNumber<T>, DualNumber<T>);            \
+    template DualNumber<T> dual_div(DualNumber<T>, DualNumber<T>);            \
+    template DualNumber<T> dual_pow(DualNumber<T>, DualNumber<T>);
+
+INSTANTIATE_DUAL_KERNELS(float)
+INSTANTIATE_DUAL_KERNELS(double)
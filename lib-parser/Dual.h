@@ -0,0 +1,55 @@
+#ifndef _DUAL_H_
+#define _DUAL_H_
+
+// Value of f together with its first and second derivative with respect
+// to one input (forward-mode automatic differentiation, truncated at
+// second order). Dual kernels apply the chain rule: the value is exactly
+// what the matching op_* kernel returns, the derivatives follow the
+// analytic rules. Where f isn't differentiable (floor, abs at 0, poles)
+// the derivatives are whatever the rule gives there, possibly inf or NaN.
+template <typename T>
+struct DualNumber {
+    T value;
+    T d1;               // f'
+    T d2;               // f''
+
+    static DualNumber constant(T c) { return {c, T(0), T(0)}; }
+    static DualNumber variable(T x) { return {x, T(1), T(0)}; }
+};
+
+using Dual = DualNumber<float>;
+
+// Kernels are instantiated for float and double (see Dual.cpp)
+
+// Unary kernels
+// -------------
+template <typename T> DualNumber<T> dual_negate(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_sin(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_cos(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_tan(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_cot(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_sec(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_csc(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_arcsin(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_arccos(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_arctan(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_arccot(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_arcsec(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_arccsc(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_log(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_ln(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_sqrt(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_abs(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_floor(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_ceil(DualNumber<T> a);
+template <typename T> DualNumber<T> dual_factorial(DualNumber<T> a);
+
+// Binary kernels
+// --------------
+template <typename T> DualNumber<T> dual_add(DualNumber<T> a, DualNumber<T> b);
+template <typename T> DualNumber<T> dual_sub(DualNumber<T> a, DualNumber<T> b);
+template <typename T> DualNumber<T> dual_mul(DualNumber<T> a, DualNumber<T> b);
+template <typename T> DualNumber<T> dual_div(DualNumber<T> a, DualNumber<T> b);
+template <typename T> DualNumber<T> dual_pow(DualNumber<T> a, DualNumber<T> b);
+
+#endif /* _DUAL_H_ */
@@ -1,13 +1,24 @@
 #include "Expression.h"
 #include <config.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 
-Expression::Expression() : root(nullptr), valid(false) {}
+// Frames up to this many variables are gathered on the stack
+static constexpr size_t INLINE_FRAME_SIZE = 16;
 
-Expression Expression::parse(const std::string& equation) {
+Expression::Expression() : root(nullptr), removedNodes(0), valid(false), implicit(false) {}
+
+Expression Expression::parse(const std::string& equation, bool optimize) {
     Expression expr;
     
     try {
-        expr.root = parseToAST(equation);
+        expr.root = parseToAST(equation, expr.arena, &expr.implicit);
+        if (optimize) {
+            expr.removedNodes = optimizeAST(expr.root, expr.arena);
+        }
+        expr.compile();
         expr.valid = true;
     } catch (const std::exception& e) {
         expr.valid = false;
@@ -17,11 +28,296 @@ Expression Expression::parse(const std::string& equation) {
     return expr;
 }
 
+void Expression::compile() {
+    // Nothing to lower: default-constructed, or loaded from a blob
+    if (!root) return;
+    MathMode mode = program.getMathMode();
+    program = Program::compile(*root);
+    program.setMathMode(mode);
+}
+
+// Serialization
+// -------------
+// Header: u32 magic, u32 checksum of everything after it, u16
+// version, u16 flags, u32 payload size. Payload: i32 removed node count,
+// u32 error length + bytes, then the program (see Program::serialize()).
+static constexpr uint32_t BLOB_MAGIC = 0x5845434D;     // "MCEX"
+static constexpr size_t BLOB_HEADER_SIZE = 16;
+static constexpr uint16_t BLOB_VALID = 1;
+static constexpr uint16_t BLOB_IMPLICIT = 2;
+
+// FNV-1a over 64-bit words rather than bytes (one multiply per eight
+// bytes), folded to 32 bits
+static uint32_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+std::vector<uint8_t> Expression::serialize() const {
+    std::vector<uint8_t> blob(BLOB_HEADER_SIZE);
+
+    int32_t removed = removedNodes;
+    uint32_t errorLength = static_cast<uint32_t>(errorMessage.size());
+    blob.insert(blob.end(), reinterpret_cast<const uint8_t*>(&removed),
+                reinterpret_cast<const uint8_t*>(&removed) + sizeof(removed));
+    blob.insert(blob.end(), reinterpret_cast<const uint8_t*>(&errorLength),
+                reinterpret_cast<const uint8_t*>(&errorLength) + sizeof(errorLength));
+    blob.insert(blob.end(), errorMessage.begin(), errorMessage.end());
+    program.serialize(blob);
+
+    uint16_t version = EXPRESSION_BLOB_VERSION;
+    uint16_t flags = (valid ? BLOB_VALID : 0) | (implicit ? BLOB_IMPLICIT : 0);
+    uint32_t payloadSize = static_cast<uint32_t>(blob.size() - BLOB_HEADER_SIZE);
+    std::memcpy(blob.data(), &BLOB_MAGIC, 4);
+    std::memcpy(blob.data() + 8, &version, 2);
+    std::memcpy(blob.data() + 10, &flags, 2);
+    std::memcpy(blob.data() + 12, &payloadSize, 4);
+
+    uint32_t sum = checksum(blob.data() + 8, blob.size() - 8);
+    std::memcpy(blob.data() + 4, &sum, 4);
+    return blob;
+}
+
+Expression Expression::deserialize(const uint8_t* data, size_t size) {
+    Expression expr;
+
+    try {
+        if (size < BLOB_HEADER_SIZE) {
+            throw std::runtime_error("Expression blob is truncated");
+        }
+        uint32_t magic, payloadSize, sum;
+        uint16_t version, flags;
+        std::memcpy(&magic, data, 4);
+        std::memcpy(&sum, data + 4, 4);
+        std::memcpy(&version, data + 8, 2);
+        std::memcpy(&flags, data + 10, 2);
+        std::memcpy(&payloadSize, data + 12, 4);
+
+        if (magic != BLOB_MAGIC) {
+            throw std::runtime_error("Not an expression blob");
+        }
+        if (version != EXPRESSION_BLOB_VERSION) {
+            throw std::runtime_error("Expression blob version " + std::to_string(version) +
+                                     " is not supported (expected " + std::to_string(EXPRESSION_BLOB_VERSION) + ")");
+        }
+        if (payloadSize != size - BLOB_HEADER_SIZE) {
+            throw std::runtime_error("Expression blob is truncated");
+        }
+        if (checksum(data + 8, size - 8) != sum) {
+            throw std::runtime_error("Expression blob checksum mismatch");
+        }
+        const uint8_t* payload = data + BLOB_HEADER_SIZE;
+
+        int32_t removed;
+        uint32_t errorLength;
+        if (payloadSize < sizeof(removed) + sizeof(errorLength)) {
+            throw std::runtime_error("Expression blob is truncated");
+        }
+        std::memcpy(&removed, payload, sizeof(removed));
+        std::memcpy(&errorLength, payload + sizeof(removed), sizeof(errorLength));
+        size_t offset = sizeof(removed) + sizeof(errorLength);
+        if (errorLength > payloadSize - offset) {
+            throw std::runtime_error("Expression blob is truncated");
+        }
+
+        std::string error(reinterpret_cast<const char*>(payload + offset), errorLength);
+        offset += errorLength;
+        expr.program = Program::deserialize(payload + offset, payloadSize - offset);
+        expr.removedNodes = removed;
+        expr.implicit = (flags & BLOB_IMPLICIT) != 0;
+        expr.valid = (flags & BLOB_VALID) != 0 && !expr.program.empty();
+        expr.errorMessage = error;
+    } catch (const std::exception& e) {
+        expr.program = Program();
+        expr.valid = false;
+        expr.errorMessage = e.what();
+    }
+
+    return expr;
+}
+
+void Expression::bind(const SymbolTable& symbols) {
+    program.bind(symbols);
+}
+
+float Expression::evaluate(const float* frame) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluate()' Cannot evaluate invalid or empty expression");
+        return 0.0f;
+    }
+    return program.run(frame);
+}
+
+double Expression::evaluate(const double* frame) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluate()' Cannot evaluate invalid or empty expression");
+        return 0.0;
+    }
+    return program.run(frame);
+}
+
 float Expression::evaluate(SymbolTable& symbols) const {
-    if (!valid || !root) {
+    if (!valid || program.empty()) {
         WARN("IN:'Expression.cpp evaluate()' Cannot evaluate invalid or empty expression");
         return 0.0f;
     }
+
+    // Gather the program's variables into a flat frame
+    const std::vector<std::string>& names = program.getVariables();
+    if (names.size() <= INLINE_FRAME_SIZE) {
+        float frame[INLINE_FRAME_SIZE];
+        for (size_t i = 0; i < names.size(); ++i) {
+            frame[i] = symbols.GetValue(names[i]);
+        }
+        return program.run(frame);
+    }
+
+    std::vector<float> frame(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        frame[i] = symbols.GetValue(names[i]);
+    }
+    return program.run(frame.data());
+}
+
+void Expression::evaluateBatch(const float* frame, int slot,
+                               const float* values, float* out, size_t count) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateBatch()' Cannot evaluate invalid or empty expression");
+        std::fill(out, out + count, 0.0f);
+        return;
+    }
+    uint32_t varying = (slot < 0) ? NO_SLOT : static_cast<uint32_t>(slot);
+    program.runBatch(frame, varying, values, out, count);
+}
+
+void Expression::evaluateBatch(const double* frame, int slot,
+                               const double* values, double* out, size_t count) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateBatch()' Cannot evaluate invalid or empty expression");
+        std::fill(out, out + count, 0.0);
+        return;
+    }
+    uint32_t varying = (slot < 0) ? NO_SLOT : static_cast<uint32_t>(slot);
+    program.runBatch(frame, varying, values, out, count);
+}
+
+void Expression::evaluateBatch(SymbolTable& symbols, const float* xs, float* out, size_t count) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateBatch()' Cannot evaluate invalid or empty expression");
+        std::fill(out, out + count, 0.0f);
+        return;
+    }
+
+    // x comes from <xs>, everything else is gathered once for the whole batch
+    const std::vector<std::string>& names = program.getVariables();
+    std::vector<float> frame(names.size(), 0.0f);
+    uint32_t varying = NO_SLOT;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == "x") varying = static_cast<uint32_t>(i);
+        else                 frame[i] = symbols.GetValue(names[i]);
+    }
+
+    program.runBatch(frame.data(), varying, xs, out, count);
+}
+
+Interval Expression::evaluateInterval(const float* frame, int slot, Interval range) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateInterval()' Cannot evaluate invalid or empty expression");
+        return Interval::entire();
+    }
+
+    size_t count = program.getVariables().size();
+    std::vector<Interval> heapFrame;
+    Interval inlineFrame[INLINE_FRAME_SIZE] = {};
+    Interval* ranges = inlineFrame;
+    if (count > INLINE_FRAME_SIZE) {
+        heapFrame.resize(count);
+        ranges = heapFrame.data();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        ranges[i] = (static_cast<int>(i) == slot) ? range : Interval::point(frame[i]);
+    }
+    return program.runInterval(ranges);
+}
+
+Interval Expression::evaluateInterval(const Interval* ranges) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateInterval()' Cannot evaluate invalid or empty expression");
+        return Interval::entire();
+    }
+    return program.runInterval(ranges);
+}
+
+// Shared by the float and double overloads
+template <typename T>
+static void runDualBatch(const Program& program, const T* frame, int slot,
+                         const T* values, DualNumber<T>* out, size_t count) {
+    size_t size = program.getVariables().size();
+    std::vector<DualNumber<T>> heapFrame;
+    DualNumber<T> inlineFrame[INLINE_FRAME_SIZE] = {};
+    DualNumber<T>* duals = inlineFrame;
+    if (size > INLINE_FRAME_SIZE) {
+        heapFrame.resize(size);
+        duals = heapFrame.data();
+    }
+
+    // Only <slot> varies; everything else is a constant of the derivative
+    for (size_t i = 0; i < size; ++i) {
+        duals[i] = DualNumber<T>::constant(frame[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (slot >= 0) duals[slot] = DualNumber<T>::variable(values[i]);
+        out[i] = program.runDual(duals);
+    }
+}
+
+Dual Expression::evaluateDual(const float* frame, int slot, float value) const {
+    Dual out;
+    evaluateDualBatch(frame, slot, &value, &out, 1);
+    return out;
+}
+
+DualNumber<double> Expression::evaluateDual(const double* frame, int slot, double value) const {
+    DualNumber<double> out;
+    evaluateDualBatch(frame, slot, &value, &out, 1);
+    return out;
+}
+
+void Expression::evaluateDualBatch(const float* frame, int slot,
+                                   const float* values, Dual* out, size_t count) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateDualBatch()' Cannot evaluate invalid or empty expression");
+        std::fill(out, out + count, Dual::constant(0.0f));
+        return;
+    }
+    runDualBatch(program, frame, slot, values, out, count);
+}
+
+void Expression::evaluateDualBatch(const double* frame, int slot,
+                                   const double* values, DualNumber<double>* out, size_t count) const {
+    if (!valid || program.empty()) {
+        WARN("IN:'Expression.cpp evaluateDualBatch()' Cannot evaluate invalid or empty expression");
+        std::fill(out, out + count, DualNumber<double>::constant(0.0));
+        return;
+    }
+    runDualBatch(program, frame, slot, values, out, count);
+}
+
+float Expression::evaluateTree(SymbolTable& symbols) const {
+    if (!valid || !root) {
+        WARN("IN:'Expression.cpp evaluateTree()' Cannot evaluate invalid or empty expression");
+        return 0.0f;
+    }
     
     return root->evaluate(symbols);
 }
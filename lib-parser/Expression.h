@@ -4,27 +4,120 @@
 #include "Parser.h"
 #include "SymbolTable.h"
 #include "Node.h"
-#include <memory>
+#include "Bytecode.h"
+#include "Optimizer.h"
+#include "Arena.h"
+#include <cstdint>
 #include <string>
+#include <vector>
+
+// Version of the blob written by Expression::serialize(). Other versions
+// are rejected; the caller reparses the equation instead.
+constexpr uint16_t EXPRESSION_BLOB_VERSION = 1;
 
 class Expression {
 private:
-    std::unique_ptr<Node> root;
+    Arena arena;        // owns every node of root; declared first so it outlives it
+    Node* root;
+    Program program;
+    int removedNodes;
     bool valid;
+    bool implicit;      // parsed from "lhs = rhs"; root is lhs - rhs
     std::string errorMessage;
 
 public:
     Expression();
     
-    // Parse equation string into AST
-    static Expression parse(const std::string& equation);
+    // Parse equation string into AST, simplify it (see Optimizer.h), then compile it
+    static Expression parse(const std::string& equation, bool optimize = true);
+
+    // Lower the AST into bytecode. Called by parse().
+    void compile();
+
+    // The compiled form (optimized program, constants, variable layout)
+    // as a versioned, checksummed blob. Loading it skips scanning,
+    // parsing and optimizing, e.g. when restoring saved curves.
+    std::vector<uint8_t> serialize() const;
+
+    // Rebuild from serialize()'s blob. The AST isn't stored, so the result
+    // can't evaluateTree(). A blob that fails any check (magic, version,
+    // checksum, program validation) gives an invalid expression whose
+    // getError() says why.
+    static Expression deserialize(const uint8_t* data, size_t size);
+
+    // Lay the program's variables out like <symbols>, so that evaluation
+    // reads symbols.GetFrame() by index. Throws if a variable is missing.
+    void bind(const SymbolTable& symbols);
+
+    // Evaluate the compiled program on a flat frame laid out as
+    // getProgram().getVariables() (e.g. a bound table's GetFrame()).
+    // This is the hot path: no string lookups.
+    float evaluate(const float* frame) const;
+
+    // Same in double, with literals kept at double precision. For views
+    // too narrow for float to resolve (deep zoom).
+    double evaluate(const double* frame) const;
+
+    // Evaluate the compiled program, looking variables up by name
     float evaluate(SymbolTable& symbols) const;
+
+    // Evaluate for values[i], i < count, fed into frame slot <slot>; writes out[i].
+    // In float, transcendentals follow getMathMode().
+    void evaluateBatch(const float* frame, int slot,
+                       const float* values, float* out, size_t count) const;
+    void evaluateBatch(const double* frame, int slot,
+                       const double* values, double* out, size_t count) const;
+
+    // Evaluate for every x in xs[0..count), writing out[i].
+    // Variables other than x are looked up by name in <symbols>.
+    void evaluateBatch(SymbolTable& symbols, const float* xs, float* out, size_t count) const;
+
+    // Guaranteed enclosure [lo, hi] of the values taken while frame slot
+    // <slot> ranges over <range> (other slots hold <frame>'s values).
+    // Empty if the expression is undefined over the whole range.
+    Interval evaluateInterval(const float* frame, int slot, Interval range) const;
+
+    // Same with every variable ranging over its own interval in <ranges>
+    Interval evaluateInterval(const Interval* ranges) const;
+
+    // f, f' and f'' with respect to frame slot <slot>, at slot = <value>
+    Dual evaluateDual(const float* frame, int slot, float value) const;
+    DualNumber<double> evaluateDual(const double* frame, int slot, double value) const;
+
+    // evaluateDual() for values[i], i < count; writes out[i]
+    void evaluateDualBatch(const float* frame, int slot,
+                           const float* values, Dual* out, size_t count) const;
+    void evaluateDualBatch(const double* frame, int slot,
+                           const double* values, DualNumber<double>* out, size_t count) const;
+
+    // Evaluate by walking the AST. Slow; kept as a reference for tests.
+    float evaluateTree(SymbolTable& symbols) const;
     
     // Check if parsing succeeded
     bool isValid() const { return valid; }
+
+    // Whether this is an equation F(x, y) = G(x, y) rather than y = f(x).
+    // Evaluation then yields F - G, whose zero set is the curve.
+    bool isImplicit() const { return implicit; }
     
     // Get error message if parsing failed
     const std::string& getError() const { return errorMessage; }
+
+    const Program& getProgram() const { return program; }
+
+    // EXACT_MATH (libm, the default) or FAST_MATH (FastMath.h kernels, a
+    // few ULP) for batched float evaluation. Single-point, double, dual
+    // and interval evaluation always use libm.
+    void setMathMode(MathMode mode) { program.setMathMode(mode); }
+    MathMode getMathMode() const { return program.getMathMode(); }
+
+    // Number of AST nodes the optimizer removed
+    int getRemovedNodeCount() const { return removedNodes; }
+
+    // Arena allocations made while parsing and optimizing, and their size
+    size_t getAllocationCount() const { return arena.getAllocationCount(); }
+    size_t getAllocatedBytes() const { return arena.getBytesUsed(); }
+    const Arena& getArena() const { return arena; }
 };
 
 #endif /* _EXPRESSION_H */
@@ -0,0 +1,72 @@
+#include "ExpressionCache.h"
+#include "Scanner.h"
+
+ExpressionCache& ExpressionCache::global() {
+    static ExpressionCache cache;
+    return cache;
+}
+
+std::string ExpressionCache::normalize(const std::string& equation) {
+    std::string key;
+    key.reserve(equation.size());
+
+    try {
+        ScannerClass scanner(equation.data(), equation.data() + equation.size());
+        for (TokenView token = scanner.ScanToken(); token.type != EOF_TOKEN; token = scanner.ScanToken()) {
+            if (!key.empty()) key += ' ';
+            key.append(token.lexeme.data(), token.lexeme.size());
+        }
+    } catch (const std::exception&) {
+        // Won't parse either; keep the text so the error message matches it
+        size_t first = equation.find_first_not_of(" \t\r\n\v\f");
+        size_t last = equation.find_last_not_of(" \t\r\n\v\f");
+        key = (first == std::string::npos) ? std::string() : equation.substr(first, last - first + 1);
+    }
+    return key;
+}
+
+std::shared_ptr<const Expression> ExpressionCache::get(const std::string& equation, MathMode mode) {
+    // Modes are kept apart by a suffix no normalized equation can contain
+    std::string key = normalize(equation);
+    if (mode == FAST_MATH) key += std::string("\0fast", 5);
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::weak_ptr<const Expression>& entry = entries[key];
+    if (std::shared_ptr<const Expression> cached = entry.lock()) {
+        hits++;
+        return cached;
+    }
+
+    // Parsing under the lock keeps two threads from compiling the same text
+    misses++;
+    auto parsed = std::make_shared<Expression>(Expression::parse(equation));
+    parsed->setMathMode(mode);
+    std::shared_ptr<const Expression> expression = parsed;
+    entry = expression;
+
+    // Drop entries whose expressions are gone
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.expired()) it = entries.erase(it);
+        else                      ++it;
+    }
+    return expression;
+}
+
+size_t ExpressionCache::size() {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t live = 0;
+    for (const auto& entry : entries) {
+        if (!entry.second.expired()) live++;
+    }
+    return live;
+}
+
+size_t ExpressionCache::getHitCount() {
+    std::lock_guard<std::mutex> guard(lock);
+    return hits;
+}
+
+size_t ExpressionCache::getMissCount() {
+    std::lock_guard<std::mutex> guard(lock);
+    return misses;
+}
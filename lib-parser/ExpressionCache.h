@@ -0,0 +1,41 @@
+#ifndef _EXPRESSION_CACHE_H_
+#define _EXPRESSION_CACHE_H_
+
+#include "Expression.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Process-wide interning of parsed expressions. Equations that read the same
+// once normalized share one immutable, compiled Expression, however many
+// curves or viewports use them. Entries are held weakly: an expression is
+// freed when its last user lets go, and parsed again if it comes back.
+// Safe to use from several threads.
+class ExpressionCache {
+    private:
+        std::mutex lock;
+        std::unordered_map<std::string, std::weak_ptr<const Expression>> entries;
+        size_t hits = 0;
+        size_t misses = 0;
+
+    public:
+        // The cache shared by the whole process
+        static ExpressionCache& global();
+
+        // Parsed and compiled form of <equation>, evaluating in <mode>.
+        // Invalid equations are cached too; check isValid() on the result.
+        std::shared_ptr<const Expression> get(const std::string& equation, MathMode mode = EXACT_MATH);
+
+        // Cache key: the equation's tokens separated by single spaces, so
+        // spacing differences ("2*x" / "2 * x", "sinx" / "sin x") don't matter.
+        // Text that doesn't scan is only trimmed.
+        static std::string normalize(const std::string& equation);
+
+        // Live entries (expressions someone still holds)
+        size_t size();
+        size_t getHitCount();
+        size_t getMissCount();
+};
+
+#endif /* _EXPRESSION_CACHE_H_ */
@@ -0,0 +1,556 @@
+#include "FastMath.h"
+#include "Operations.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define FAST_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FAST_SSE2 1
+#endif
+
+#if defined(FAST_AVX2) || defined(FAST_SSE2)
+    #define FAST_SIMD 1
+#endif
+
+// Lane wrappers. Each kernel is written once against this interface:
+// F holds WIDTH floats, I as many int32s. Comparisons return all-ones /
+// all-zero masks in F. No fused multiply-add anywhere, so the scalar
+// tail rounds like the vector body.
+struct ScalarLanes {
+    using F = float;
+    using I = int32_t;
+    static constexpr size_t WIDTH = 1;
+
+    static F load(const float* p)       { return *p; }
+    static void store(float* p, F v)    { *p = v; }
+    static F set(float v)               { return v; }
+    static I seti(int32_t v)            { return v; }
+
+    static F add(F a, F b)              { return a + b; }
+    static F sub(F a, F b)              { return a - b; }
+    static F mul(F a, F b)              { return a * b; }
+    static F div(F a, F b)              { return a / b; }
+
+    static F asF(I i)                   { F f; std::memcpy(&f, &i, sizeof(f)); return f; }
+    static I asI(F f)                   { I i; std::memcpy(&i, &f, sizeof(i)); return i; }
+    static F bitand_(F a, F b)          { return asF(asI(a) & asI(b)); }
+    static F bitor_(F a, F b)           { return asF(asI(a) | asI(b)); }
+    static F bitxor_(F a, F b)          { return asF(asI(a) ^ asI(b)); }
+    static F andnot(F a, F b)           { return asF(~asI(a) & asI(b)); }
+    static F eq(F a, F b)               { return asF(a == b ? -1 : 0); }
+    static F lt(F a, F b)               { return asF(a < b ? -1 : 0); }
+    static F le(F a, F b)               { return asF(a <= b ? -1 : 0); }
+
+    static I iadd(I a, I b)             { return static_cast<I>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+    static I isub(I a, I b)             { return static_cast<I>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b)); }
+    static I iand(I a, I b)             { return a & b; }
+    static I iandnot(I a, I b)          { return ~a & b; }
+    static F ieq(I a, I b)              { return asF(a == b ? -1 : 0); }
+    template <int N> static I sll(I a)  { return static_cast<I>(static_cast<uint32_t>(a) << N); }
+    template <int N> static I srl(I a)  { return static_cast<I>(static_cast<uint32_t>(a) >> N); }
+
+    // Out of range and NaN give INT32_MIN, like cvttps/cvtps
+    static I truncate(F a) {
+        return (a > -2147483648.0f && a < 2147483648.0f) ? static_cast<I>(a) : INT32_MIN;
+    }
+    static I round(F a) {
+        return (a > -2147483648.0f && a < 2147483648.0f) ? static_cast<I>(std::nearbyint(a)) : INT32_MIN;
+    }
+    static F toFloat(I a)               { return static_cast<F>(a); }
+
+    static int movemask(F m)            { return asI(m) < 0 ? 1 : 0; }
+};
+
+#if defined(FAST_AVX2)
+struct VectorLanes {
+    using F = __m256;
+    using I = __m256i;
+    static constexpr size_t WIDTH = 8;
+
+    static F load(const float* p)       { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v)    { _mm256_storeu_ps(p, v); }
+    static F set(float v)               { return _mm256_set1_ps(v); }
+    static I seti(int32_t v)            { return _mm256_set1_epi32(v); }
+
+    static F add(F a, F b)              { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b)              { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b)              { return _mm256_mul_ps(a, b); }
+    static F div(F a, F b)              { return _mm256_div_ps(a, b); }
+
+    static F asF(I i)                   { return _mm256_castsi256_ps(i); }
+    static I asI(F f)                   { return _mm256_castps_si256(f); }
+    static F bitand_(F a, F b)          { return _mm256_and_ps(a, b); }
+    static F bitor_(F a, F b)           { return _mm256_or_ps(a, b); }
+    static F bitxor_(F a, F b)          { return _mm256_xor_ps(a, b); }
+    static F andnot(F a, F b)           { return _mm256_andnot_ps(a, b); }
+    static F eq(F a, F b)               { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static F lt(F a, F b)               { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static F le(F a, F b)               { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+
+    static I iadd(I a, I b)             { return _mm256_add_epi32(a, b); }
+    static I isub(I a, I b)             { return _mm256_sub_epi32(a, b); }
+    static I iand(I a, I b)             { return _mm256_and_si256(a, b); }
+    static I iandnot(I a, I b)          { return _mm256_andnot_si256(a, b); }
+    static F ieq(I a, I b)              { return asF(_mm256_cmpeq_epi32(a, b)); }
+    template <int N> static I sll(I a)  { return _mm256_slli_epi32(a, N); }
+    template <int N> static I srl(I a)  { return _mm256_srli_epi32(a, N); }
+
+    static I truncate(F a)              { return _mm256_cvttps_epi32(a); }
+    static I round(F a)                 { return _mm256_cvtps_epi32(a); }
+    static F toFloat(I a)               { return _mm256_cvtepi32_ps(a); }
+
+    static int movemask(F m)            { return _mm256_movemask_ps(m); }
+};
+#elif defined(FAST_SSE2)
+struct VectorLanes {
+    using F = __m128;
+    using I = __m128i;
+    static constexpr size_t WIDTH = 4;
+
+    static F load(const float* p)       { return _mm_loadu_ps(p); }
+    static void store(float* p, F v)    { _mm_storeu_ps(p, v); }
+    static F set(float v)               { return _mm_set1_ps(v); }
+    static I seti(int32_t v)            { return _mm_set1_epi32(v); }
+
+    static F add(F a, F b)              { return _mm_add_ps(a, b); }
+    static F sub(F a, F b)              { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b)              { return _mm_mul_ps(a, b); }
+    static F div(F a, F b)              { return _mm_div_ps(a, b); }
+
+    static F asF(I i)                   { return _mm_castsi128_ps(i); }
+    static I asI(F f)                   { return _mm_castps_si128(f); }
+    static F bitand_(F a, F b)          { return _mm_and_ps(a, b); }
+    static F bitor_(F a, F b)           { return _mm_or_ps(a, b); }
+    static F bitxor_(F a, F b)          { return _mm_xor_ps(a, b); }
+    static F andnot(F a, F b)           { return _mm_andnot_ps(a, b); }
+    static F eq(F a, F b)               { return _mm_cmpeq_ps(a, b); }
+    static F lt(F a, F b)               { return _mm_cmplt_ps(a, b); }
+    static F le(F a, F b)               { return _mm_cmple_ps(a, b); }
+
+    static I iadd(I a, I b)             { return _mm_add_epi32(a, b); }
+    static I isub(I a, I b)             { return _mm_sub_epi32(a, b); }
+    static I iand(I a, I b)             { return _mm_and_si128(a, b); }
+    static I iandnot(I a, I b)          { return _mm_andnot_si128(a, b); }
+    static F ieq(I a, I b)              { return asF(_mm_cmpeq_epi32(a, b)); }
+    template <int N> static I sll(I a)  { return _mm_slli_epi32(a, N); }
+    template <int N> static I srl(I a)  { return _mm_srli_epi32(a, N); }
+
+    static I truncate(F a)              { return _mm_cvttps_epi32(a); }
+    static I round(F a)                 { return _mm_cvtps_epi32(a); }
+    static F toFloat(I a)               { return _mm_cvtepi32_ps(a); }
+
+    static int movemask(F m)            { return _mm_movemask_ps(m); }
+};
+#endif
+
+// Shared pieces
+// -------------
+template <typename L>
+static inline typename L::F select(typename L::F mask, typename L::F a, typename L::F b) {
+    return L::bitor_(L::bitand_(mask, a), L::andnot(mask, b));
+}
+
+template <typename L>
+static inline typename L::F absLanes(typename L::F x) {
+    return L::andnot(L::set(-0.0f), x);
+}
+
+// Mask of lanes with lo <= x <= hi; NaN lanes are outside
+template <typename L>
+static inline typename L::F inside(typename L::F x, float lo, float hi) {
+    return L::bitand_(L::le(L::set(lo), x), L::le(x, L::set(hi)));
+}
+
+// 2^n for integer n in [-126, 127]
+template <typename L>
+static inline typename L::F pow2i(typename L::I n) {
+    return L::asF(L::template sll<23>(L::iadd(n, L::seti(127))));
+}
+
+// e^r for |r| <= ln(2)/2
+template <typename L>
+static inline typename L::F expPolynomial(typename L::F r) {
+    using F = typename L::F;
+    F y = L::set(1.9875691500e-4f);
+    y = L::add(L::mul(y, r), L::set(1.3981999507e-3f));
+    y = L::add(L::mul(y, r), L::set(8.3334519073e-3f));
+    y = L::add(L::mul(y, r), L::set(4.1665795894e-2f));
+    y = L::add(L::mul(y, r), L::set(1.6666665459e-1f));
+    y = L::add(L::mul(y, r), L::set(5.0000001201e-1f));
+    y = L::mul(y, L::mul(r, r));
+    return L::add(L::add(y, r), L::set(1.0f));
+}
+
+// Split x = 2^e * (1 + m), 1 + m in [sqrt(1/2), sqrt(2)), and return
+// ln(1 + m) as m + tail. x must be positive, finite and normal.
+template <typename L>
+static inline void logParts(typename L::F x, typename L::F& e, typename L::F& m, typename L::F& tail) {
+    using F = typename L::F;
+    using I = typename L::I;
+    I bits = L::asI(x);
+    I exponent = L::isub(L::template srl<23>(bits), L::seti(126));
+    F mantissa = L::asF(L::iadd(L::iand(bits, L::seti(0x007fffff)), L::seti(0x3f000000)));  // [0.5, 1)
+
+    // Below sqrt(1/2): use 2 * mantissa and one less exponent
+    F low = L::lt(mantissa, L::set(7.071067691e-1f));
+    e = L::sub(L::toFloat(exponent), L::bitand_(low, L::set(1.0f)));
+    m = L::add(L::sub(mantissa, L::set(1.0f)), L::bitand_(low, mantissa));
+
+    F z = L::mul(m, m);
+    F y = L::set(7.0376836292e-2f);
+    y = L::add(L::mul(y, m), L::set(-1.1514610310e-1f));
+    y = L::add(L::mul(y, m), L::set(1.1676998740e-1f));
+    y = L::add(L::mul(y, m), L::set(-1.2420140846e-1f));
+    y = L::add(L::mul(y, m), L::set(1.4249322787e-1f));
+    y = L::add(L::mul(y, m), L::set(-1.6668057665e-1f));
+    y = L::add(L::mul(y, m), L::set(2.0000714765e-1f));
+    y = L::add(L::mul(y, m), L::set(-2.4999993993e-1f));
+    y = L::add(L::mul(y, m), L::set(3.3333331174e-1f));
+    y = L::mul(L::mul(y, m), z);
+    tail = L::sub(y, L::mul(z, L::set(0.5f)));
+}
+
+// 2^(hi + lo) for hi with at most 24 significant bits and |lo| small.
+// <n> receives the power of two applied, for range checks.
+template <typename L>
+static inline typename L::F exp2Parts(typename L::F hi, typename L::F lo, typename L::F& n) {
+    using F = typename L::F;
+    using I = typename L::I;
+    I k = L::round(hi);
+    F f = L::add(L::sub(hi, L::toFloat(k)), lo);     // hi - k is exact
+
+    // lo can push f past one half
+    I k2 = L::round(f);
+    f = L::sub(f, L::toFloat(k2));
+    k = L::iadd(k, k2);
+
+    n = L::toFloat(k);
+    return L::mul(expPolynomial<L>(L::mul(f, L::set(6.931471825e-01f))), pow2i<L>(k));
+}
+
+// Split b into hi + lo, 12 significant bits each (Veltkamp), so that hi
+// and lo times a value of at most 12 bits are exact
+template <typename L>
+static inline void split12(typename L::F b, typename L::F& hi, typename L::F& lo) {
+    typename L::F c = L::mul(b, L::set(4097.0f));
+    hi = L::sub(c, L::sub(c, b));
+    lo = L::sub(b, hi);
+}
+
+
+// Kernels
+// -------
+// Each computes WIDTH lanes and sets <fix> on the lanes libm must redo.
+
+// sin and cos of x for |x| <= 8192 (Cephes sinf/cosf). x is reduced by
+// multiples of pi/2 with pi/4 split in five parts; the first four have
+// 10 significant bits, so j * part is exact for j < 2^14.
+template <typename L>
+static inline void sinCos(typename L::F x, typename L::F& s, typename L::F& c, typename L::F& fix) {
+    using F = typename L::F;
+    using I = typename L::I;
+    F signMask = L::set(-0.0f);
+    F ax = absLanes<L>(x);
+    fix = L::andnot(inside<L>(x, -8192.0f, 8192.0f), L::asF(L::seti(-1)));
+
+    // Octant, rounded up to even
+    I j = L::truncate(L::mul(ax, L::set(1.273239493e+00f)));
+    j = L::iand(L::iadd(j, L::seti(1)), L::seti(~1));
+    F y = L::toFloat(j);
+
+    F r = L::sub(ax, L::mul(y, L::set(7.851562500e-01f)));
+    r = L::sub(r, L::mul(y, L::set(2.419948578e-04f)));
+    r = L::sub(r, L::mul(y, L::set(-8.149072528e-08f)));
+    r = L::sub(r, L::mul(y, L::set(3.041122909e-11f)));
+    r = L::sub(r, L::mul(y, L::set(-2.572655732e-14f)));
+
+    F z = L::mul(r, r);
+    F polyCos = L::set(2.443315711809948e-5f);
+    polyCos = L::add(L::mul(polyCos, z), L::set(-1.388731625493765e-3f));
+    polyCos = L::add(L::mul(polyCos, z), L::set(4.166664568298827e-2f));
+    polyCos = L::mul(L::mul(polyCos, z), z);
+    polyCos = L::add(L::sub(polyCos, L::mul(z, L::set(0.5f))), L::set(1.0f));
+
+    F polySin = L::set(-1.9515295891e-4f);
+    polySin = L::add(L::mul(polySin, z), L::set(8.3321608736e-3f));
+    polySin = L::add(L::mul(polySin, z), L::set(-1.6666654611e-1f));
+    polySin = L::add(L::mul(L::mul(polySin, z), r), r);
+
+    // Octants 2 and 6 swap the polynomials; 4 to 7 flip sin, 2 to 5 flip cos
+    F useSin = L::ieq(L::iand(j, L::seti(2)), L::seti(0));
+    F sinSign = L::bitxor_(L::bitand_(x, signMask), L::asF(L::template sll<29>(L::iand(j, L::seti(4)))));
+    F cosSign = L::asF(L::template sll<29>(L::iandnot(L::isub(j, L::seti(2)), L::seti(4))));
+
+    s = L::bitxor_(select<L>(useSin, polySin, polyCos), sinSign);
+    c = L::bitxor_(select<L>(useSin, polyCos, polySin), cosSign);
+}
+
+struct SinKernel {
+    static float exact(float a) { return op_sin(a); }
+    template <typename L>
+    static typename L::F apply(typename L::F x, typename L::F& fix) {
+        typename L::F s, c;
+        sinCos<L>(x, s, c, fix);
+        return s;
+    }
+};
+
+struct CosKernel {
+    static float exact(float a) { return op_cos(a); }
+    template <typename L>
+    static typename L::F apply(typename L::F x, typename L::F& fix) {
+        typename L::F s, c;
+        sinCos<L>(x, s, c, fix);
+        return c;
+    }
+};
+
+struct TanKernel {
+    static float exact(float a) { return op_tan(a); }
+    template <typename L>
+    static typename L::F apply(typename L::F x, typename L::F& fix) {
+        typename L::F s, c;
+        sinCos<L>(x, s, c, fix);
+        return L::div(s, c);
+    }
+};
+
+// e^x for x in [-87, 88] (normal results); Cephes expf
+struct ExpKernel {
+    static float exact(float a) { return std::exp(a); }
+    template <typename L>
+    static typename L::F apply(typename L::F x, typename L::F& fix) {
+        using F = typename L::F;
+        fix = L::andnot(inside<L>(x, -87.0f, 88.0f), L::asF(L::seti(-1)));
+        x = select<L>(fix, L::set(0.0f), x);
+
+        F t = L::toFloat(L::round(L::mul(x, L::set(1.442695022e+00f))));
+        F r = L::sub(x, L::mul(t, L::set(0.693359375f)));      // exact: 9 bits times 8
+        r = L::sub(r, L::mul(t, L::set(-2.12194440e-4f)));
+        return L::mul(expPolynomial<L>(r), pow2i<L>(L::truncate(t)));
+    }
+};
+
+// ln(x) for positive, finite, normal x; Cephes logf
+struct LnKernel {
+    static float exact(float a) { return op_ln(a); }
+    template <typename L>
+    static typename L::F apply(typename L::F x, typename L::F& fix) {
+        using F = typename L::F;
+        fix = L::andnot(inside<L>(x, 1.17549435e-38f, 3.40282347e+38f), L::asF(L::seti(-1)));
+        x = select<L>(fix, L::set(1.0f), x);
+
+        F e, m, tail;
+        logParts<L>(x, e, m, tail);
+        F y = L::add(tail, L::mul(e, L::set(-2.12194440e-4f)));
+        return L::add(L::add(m, y), L::mul(e, L::set(0.693359375f)));
+    }
+};
+
+struct Log10Kernel {
+    static float exact(float a) { return op_log(a); }
+    template <typename L>
+    static typename L::F apply(typename L::F x, typename L::F& fix) {
+        return L::mul(LnKernel::apply<L>(x, fix), L::set(4.342944920e-01f));
+    }
+};
+
+// a^k for lanes where b is an integer k with |k| <= 3, by repeated
+// multiplication like libm's exact cases; <mask> marks those lanes.
+// Covers negative and non-finite a as well.
+template <typename L>
+static inline typename L::F powSmallInteger(typename L::F a, typename L::F b, typename L::F& mask) {
+    using F = typename L::F;
+    F k = L::toFloat(L::truncate(b));
+    mask = L::bitand_(L::eq(k, b), inside<L>(b, -3.0f, 3.0f));
+
+    F one = L::set(1.0f);
+    F square = L::mul(a, a);
+    F magnitude = absLanes<L>(k);
+    F y = select<L>(L::le(magnitude, L::set(2.5f)), square, L::mul(square, a));
+    y = select<L>(L::le(magnitude, L::set(1.5f)), a, y);
+    y = select<L>(L::le(magnitude, L::set(0.5f)), one, y);
+    return select<L>(L::lt(k, L::set(0.0f)), L::div(one, y), y);
+}
+
+// a^b for positive, finite, normal a and |b| <= 2^20, through
+// 2^(b * log2(a)) with log2(a) = e + log2(1 + m). The large terms of
+// b * e and b * m * log2(e) are carried exactly (Dekker products), so
+// the error left is that of b * tail, a few ULP up to |b| ~ 50.
+template <typename L>
+static inline typename L::F powLanes(typename L::F a, typename L::F b, typename L::F& fix) {
+    using F = typename L::F;
+    F aIn = a;
+    F bIn = b;
+    F bad = L::andnot(inside<L>(a, 1.17549435e-38f, 3.40282347e+38f), L::asF(L::seti(-1)));
+    bad = L::bitor_(bad, L::andnot(inside<L>(b, -1048576.0f, 1048576.0f), L::asF(L::seti(-1))));
+    a = select<L>(bad, L::set(1.0f), a);
+    b = select<L>(bad, L::set(0.0f), b);
+
+    F e, m, tail;
+    logParts<L>(a, e, m, tail);
+
+    F bHi, bLo, mHi, mLo;
+    split12<L>(b, bHi, bLo);
+    split12<L>(m, mHi, mLo);
+
+    // b * m = bm + bmError
+    F bm = L::mul(b, m);
+    F bmError = L::sub(L::mul(bHi, mHi), bm);
+    bmError = L::add(L::add(L::add(bmError, L::mul(bHi, mLo)), L::mul(bLo, mHi)), L::mul(bLo, mLo));
+
+    // bm * log2(e), log2(e) = 1.44287109375 (12 bits) - 1.7605e-4
+    F bmHi, bmLo;
+    split12<L>(bm, bmHi, bmLo);
+    F p1 = L::mul(bmHi, L::set(1.44287109375f));
+    F p2 = L::mul(bmLo, L::set(1.44287109375f));
+    F rest = L::add(L::mul(L::add(bmError, L::mul(b, tail)), L::set(1.442695022e+00f)),
+                    L::mul(bm, L::set(-1.760528539e-04f)));
+
+    // b * e = q1 + q2, both exact (e has at most 8 bits)
+    F q1 = L::mul(bHi, e);
+    F q2 = L::mul(bLo, e);
+
+    // Take the integer part off q1 + p1 first: with e != 0, |p1| <= |q1| / 2,
+    // so q1 - k is exact and the partial sums stay small
+    typename L::I k = L::round(L::add(L::add(q1, p1), L::add(q2, p2)));
+    F f = L::add(L::sub(q1, L::toFloat(k)), p1);
+    f = L::add(L::add(L::add(f, q2), p2), rest);
+
+    F n;
+    F result = exp2Parts<L>(L::toFloat(k), f, n);
+    fix = L::bitor_(bad, L::andnot(inside<L>(n, -125.0f, 125.0f), L::asF(L::seti(-1))));
+
+    F integer;
+    F power = powSmallInteger<L>(aIn, bIn, integer);
+    fix = L::andnot(integer, fix);
+    return select<L>(integer, power, result);
+}
+
+// Same with every lane sharing a base whose log2 is known to double
+// precision, split as logHi (12 bits) + logLo. |b| <= 2^20 keeps
+// b * log2(a) inside the integer conversions.
+template <typename L>
+static inline typename L::F powSharedBase(float logHi, float logLo, typename L::F b, typename L::F& fix) {
+    using F = typename L::F;
+    F bad = L::andnot(inside<L>(b, -1048576.0f, 1048576.0f), L::asF(L::seti(-1)));
+    b = select<L>(bad, L::set(0.0f), b);
+
+    F bHi, bLo;
+    split12<L>(b, bHi, bLo);
+    F hi = L::mul(bHi, L::set(logHi));
+    F lo = L::add(L::mul(bLo, L::set(logHi)), L::mul(b, L::set(logLo)));
+
+    F n;
+    F result = exp2Parts<L>(hi, lo, n);
+    fix = L::bitor_(bad, L::andnot(inside<L>(n, -125.0f, 125.0f), L::asF(L::seti(-1))));
+    return result;
+}
+
+
+// Drivers
+// -------
+template <typename Kernel>
+static void runUnary(float* a, size_t n) {
+    size_t i = 0;
+#if defined(FAST_SIMD)
+    using L = VectorLanes;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        float in[L::WIDTH];
+        L::F x = L::load(a + i);
+        L::store(in, x);
+        L::F fix;
+        L::store(a + i, Kernel::template apply<L>(x, fix));
+
+        int lanes = L::movemask(fix);
+        for (size_t k = 0; lanes != 0; ++k, lanes >>= 1) {
+            if (lanes & 1) a[i + k] = Kernel::exact(in[k]);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        float fix;
+        float y = Kernel::template apply<ScalarLanes>(a[i], fix);
+        a[i] = ScalarLanes::movemask(fix) ? Kernel::exact(a[i]) : y;
+    }
+}
+
+void fast_sin(float* a, size_t n)   { runUnary<SinKernel>(a, n); }
+void fast_cos(float* a, size_t n)   { runUnary<CosKernel>(a, n); }
+void fast_tan(float* a, size_t n)   { runUnary<TanKernel>(a, n); }
+void fast_exp(float* a, size_t n)   { runUnary<ExpKernel>(a, n); }
+void fast_ln(float* a, size_t n)    { runUnary<LnKernel>(a, n); }
+void fast_log10(float* a, size_t n) { runUnary<Log10Kernel>(a, n); }
+
+void fast_pow(float* a, const float* b, size_t n) {
+    size_t i = 0;
+#if defined(FAST_SIMD)
+    using L = VectorLanes;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        float inA[L::WIDTH];
+        L::F x = L::load(a + i);
+        L::store(inA, x);
+        L::F fix;
+        L::store(a + i, powLanes<L>(x, L::load(b + i), fix));
+
+        int lanes = L::movemask(fix);
+        for (size_t k = 0; lanes != 0; ++k, lanes >>= 1) {
+            if (lanes & 1) a[i + k] = op_pow(inA[k], b[i + k]);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        float fix;
+        float y = powLanes<ScalarLanes>(a[i], b[i], fix);
+        a[i] = ScalarLanes::movemask(fix) ? op_pow(a[i], b[i]) : y;
+    }
+}
+
+void fast_pow_shared_base(float* a, const float* b, size_t n) {
+    if (n == 0) return;
+    const float base = a[0];
+    if (!(base >= 1.17549435e-38f && base <= 3.40282347e+38f)) {
+        fast_pow(a, b, n);
+        return;
+    }
+
+    // log2(base) in double, split into 12 bits + the rest
+    double log2Base = std::log2(static_cast<double>(base));
+    int exponent;
+    double fraction = std::frexp(log2Base, &exponent);
+    double hi = std::ldexp(std::nearbyint(std::ldexp(fraction, 12)), exponent - 12);
+    const float logHi = static_cast<float>(hi);
+    const float logLo = static_cast<float>(log2Base - hi);
+
+    size_t i = 0;
+#if defined(FAST_SIMD)
+    using L = VectorLanes;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        L::F fix;
+        L::store(a + i, powSharedBase<L>(logHi, logLo, L::load(b + i), fix));
+
+        int lanes = L::movemask(fix);
+        for (size_t k = 0; lanes != 0; ++k, lanes >>= 1) {
+            if (lanes & 1) a[i + k] = op_pow(base, b[i + k]);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        float fix;
+        float y = powSharedBase<ScalarLanes>(logHi, logLo, b[i], fix);
+        a[i] = ScalarLanes::movemask(fix) ? op_pow(base, b[i]) : y;
+    }
+}
+
+const char* fast_isa() {
+#if defined(FAST_AVX2)
+    return "AVX2";
+#elif defined(FAST_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,49 @@
+#ifndef _FAST_MATH_H_
+#define _FAST_MATH_H_
+
+#include <cstddef>
+
+// How the batch interpreter evaluates transcendental functions
+enum MathMode {
+    EXACT_MATH,     // libm, one lane at a time
+    FAST_MATH       // the vector kernels below: a few ULP, plenty for pixels
+};
+
+// Vectorized float transcendentals for FAST_MATH. Each kernel works in
+// place on <a>, like the VectorOps kernels: range reduction followed by
+// a minimax polynomial (Cephes coefficients), AVX2 when built with
+// PARSER_ENABLE_AVX2, SSE2 on any other x86-64 build, plain loops
+// elsewhere. Lanes outside a kernel's reduced range (huge arguments,
+// zeros, infinities, NaNs, negative logs, denormal results) fall back to
+// libm, so special values match op_* exactly.
+//
+// Maximum error against libm, checked by test_fast_math.cpp:
+//   fast_sin, fast_cos       2 ULP
+//   fast_tan                 4 ULP
+//   fast_exp, fast_ln        1 ULP
+//   fast_log10               2 ULP
+//   fast_pow                 2 ULP for integer exponents up to 3 (x^2,
+//                            x^-3); else 3 ULP for |b| <= 8, about |b|/5
+//                            beyond
+//   fast_pow_shared_base     1 ULP (e^x, 2^x)
+//
+// Every lane's result depends on its own inputs only, never on which
+// other lanes share the call, so regrouping a batch (across threads, say)
+// doesn't change a bit.
+
+void fast_sin(float* a, size_t n);
+void fast_cos(float* a, size_t n);
+void fast_tan(float* a, size_t n);
+void fast_exp(float* a, size_t n);
+void fast_ln(float* a, size_t n);
+void fast_log10(float* a, size_t n);
+void fast_pow(float* a, const float* b, size_t n);
+
+// fast_pow() for a column whose lanes all hold the base a[0]. The caller
+// must know this from the program (a constant base), not from the data.
+void fast_pow_shared_base(float* a, const float* b, size_t n);
+
+// Name of the instruction set the kernels were built for
+const char* fast_isa();
+
+#endif /* _FAST_MATH_H_ */
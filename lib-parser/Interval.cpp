@@ -0,0 +1,295 @@
+#include "Interval.h"
+#include "Operations.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr float INF = std::numeric_limits<float>::infinity();
+
+// Max error, in ulps, assumed for the float libm functions behind op_*.
+// IEEE +, -, *, / and sqrt are correctly rounded and need only one.
+static constexpr int LIBM_ULPS = 4;
+static constexpr int GAMMA_ULPS = 16;
+
+
+// Outward rounding
+// ----------------
+static inline float down(float v, int ulps = 1) {
+    for (int i = 0; i < ulps; ++i) v = std::nextafter(v, -INF);
+    return v;
+}
+
+static inline float up(float v, int ulps = 1) {
+    for (int i = 0; i < ulps; ++i) v = std::nextafter(v, INF);
+    return v;
+}
+
+static inline Interval widen(float lo, float hi, int ulps) {
+    return {down(lo, ulps), up(hi, ulps)};
+}
+
+// Smallest interval holding both
+static inline Interval hull(Interval a, Interval b) {
+    if (a.isEmpty()) return b;
+    if (b.isEmpty()) return a;
+    return {std::min(a.lo, b.lo), std::max(a.hi, b.hi)};
+}
+
+template <typename Func>
+static inline Interval increasing(Interval a, Func func, int ulps) {
+    if (a.isEmpty()) return a;
+    return widen(func(a.lo), func(a.hi), ulps);
+}
+
+template <typename Func>
+static inline Interval decreasing(Interval a, Func func, int ulps) {
+    if (a.isEmpty()) return a;
+    return widen(func(a.hi), func(a.lo), ulps);
+}
+
+// Whether [lo, hi] holds offset + k * period for some integer k.
+// Done in double so float endpoints are compared exactly.
+static bool containsLattice(float lo, float hi, double offset, double period) {
+    double k = std::ceil((static_cast<double>(lo) - offset) / period);
+    return offset + k * period <= static_cast<double>(hi);
+}
+
+static inline Interval clampUnit(Interval a) {
+    return {std::max(a.lo, -1.0f), std::min(a.hi, 1.0f)};
+}
+
+
+// Binary kernels
+// --------------
+Interval iv_add(Interval a, Interval b) {
+    if (a.isEmpty() || b.isEmpty()) return Interval::empty();
+    float lo = a.lo + b.lo;     // -inf + inf is unbounded, not undefined
+    float hi = a.hi + b.hi;
+    return {std::isnan(lo) ? -INF : down(lo), std::isnan(hi) ? INF : up(hi)};
+}
+
+Interval iv_sub(Interval a, Interval b) {
+    return iv_add(a, iv_negate(b));
+}
+
+// 0 * inf bounds products that approach 0 from finite values
+static inline float product(float x, float y) {
+    float p = x * y;
+    return std::isnan(p) ? 0.0f : p;
+}
+
+Interval iv_mul(Interval a, Interval b) {
+    if (a.isEmpty() || b.isEmpty()) return Interval::empty();
+    float p[4] = {product(a.lo, b.lo), product(a.lo, b.hi), product(a.hi, b.lo), product(a.hi, b.hi)};
+    return widen(*std::min_element(p, p + 4), *std::max_element(p, p + 4), 1);
+}
+
+// What op_div gives for b = 0: +inf, -inf by the sign of a (0 is undefined)
+static Interval divideByZero(Interval a) {
+    Interval result = Interval::empty();
+    if (a.hi > 0.0f) result = hull(result, {INF, INF});
+    if (a.lo < 0.0f) result = hull(result, {-INF, -INF});
+    return result;
+}
+
+Interval iv_div(Interval a, Interval b) {
+    if (a.isEmpty() || b.isEmpty()) return Interval::empty();
+
+    if (b.lo > 0.0f || b.hi < 0.0f) {
+        float q[4] = {a.lo / b.lo, a.lo / b.hi, a.hi / b.lo, a.hi / b.hi};
+        for (float v : q) {
+            if (std::isnan(v)) return Interval::entire();   // inf / inf
+        }
+        return widen(*std::min_element(q, q + 4), *std::max_element(q, q + 4), 1);
+    }
+
+    // b touches or holds zero
+    if (b.lo == 0.0f && b.hi == 0.0f) return divideByZero(a);
+    if (b.lo == 0.0f) return hull(iv_mul(a, {down(1.0f / b.hi), INF}), divideByZero(a));
+    if (b.hi == 0.0f) return hull(iv_mul(a, {-INF, up(1.0f / b.lo)}), divideByZero(a));
+    return Interval::entire();
+}
+
+// pow(a, n) for an integer n != 0
+static Interval powInteger(Interval a, float n) {
+    bool odd = std::fmod(n, 2.0f) != 0.0f;
+    auto power = [n](float v) { return op_pow(v, n); };
+
+    if (n > 0.0f) {
+        if (odd) return increasing(a, power, LIBM_ULPS);
+        return increasing(iv_abs(a), power, LIBM_ULPS);
+    }
+
+    // x^-k = 1 / x^k, but pow(-0, -odd) is -inf where 1 / 0 is +inf
+    Interval result = iv_div({1.0f, 1.0f}, powInteger(a, -n));
+    if (odd && a.contains(0.0f)) result = hull(result, {-INF, INF});
+    return result;
+}
+
+Interval iv_pow(Interval a, Interval b) {
+    if (a.isEmpty() || b.isEmpty()) return Interval::empty();
+
+    if (b.lo == b.hi) {
+        float n = b.lo;
+        if (n == 0.0f) return {1.0f, 1.0f};     // pow(x, 0) = 1, even for NaN
+        if (std::isfinite(n) && n == std::floor(n)) return powInteger(a, n);
+
+        // Fractional exponents: negative bases are undefined, except
+        // pow(-inf, n) = +inf for n > 0 and 0 for n < 0
+        Interval result = Interval::empty();
+        if (a.hi >= 0.0f) {
+            Interval base = {std::max(a.lo, 0.0f), a.hi};
+            auto power = [n](float v) { return op_pow(v, n); };
+            result = (n > 0.0f) ? increasing(base, power, LIBM_ULPS) : decreasing(base, power, LIBM_ULPS);
+        }
+        if (a.lo == -INF) result = hull(result, Interval::point(n > 0.0f ? INF : 0.0f));
+        return result;
+    }
+
+    // Positive base: b * ln(a) is bilinear in (ln a, b), extremes sit at corners
+    if (a.lo > 0.0f) {
+        float p[4] = {op_pow(a.lo, b.lo), op_pow(a.lo, b.hi), op_pow(a.hi, b.lo), op_pow(a.hi, b.hi)};
+        return widen(*std::min_element(p, p + 4), *std::max_element(p, p + 4), LIBM_ULPS);
+    }
+    return Interval::entire();
+}
+
+
+// Unary kernels
+// -------------
+Interval iv_negate(Interval a) {
+    if (a.isEmpty()) return a;
+    return {-a.hi, -a.lo};
+}
+
+Interval iv_sin(Interval a) {
+    if (a.isEmpty()) return a;
+    if (!a.isBounded() || static_cast<double>(a.hi) - a.lo >= 2.0 * M_PI) return {-1.0f, 1.0f};
+
+    float s1 = op_sin(a.lo), s2 = op_sin(a.hi);
+    Interval result = widen(std::min(s1, s2), std::max(s1, s2), LIBM_ULPS);
+    if (containsLattice(a.lo, a.hi, M_PI / 2.0, 2.0 * M_PI)) result.hi = 1.0f;
+    if (containsLattice(a.lo, a.hi, -M_PI / 2.0, 2.0 * M_PI)) result.lo = -1.0f;
+    return clampUnit(result);
+}
+
+Interval iv_cos(Interval a) {
+    if (a.isEmpty()) return a;
+    if (!a.isBounded() || static_cast<double>(a.hi) - a.lo >= 2.0 * M_PI) return {-1.0f, 1.0f};
+
+    float c1 = op_cos(a.lo), c2 = op_cos(a.hi);
+    Interval result = widen(std::min(c1, c2), std::max(c1, c2), LIBM_ULPS);
+    if (containsLattice(a.lo, a.hi, 0.0, 2.0 * M_PI)) result.hi = 1.0f;
+    if (containsLattice(a.lo, a.hi, M_PI, 2.0 * M_PI)) result.lo = -1.0f;
+    return clampUnit(result);
+}
+
+// Poles at pi/2 + k*pi, increasing in between
+Interval iv_tan(Interval a) {
+    if (a.isEmpty()) return a;
+    if (!a.isBounded() || containsLattice(a.lo, a.hi, M_PI / 2.0, M_PI)) return Interval::entire();
+    return increasing(a, op_tan<float>, LIBM_ULPS);
+}
+
+// Poles at k*pi, decreasing in between
+Interval iv_cot(Interval a) {
+    if (a.isEmpty()) return a;
+    if (!a.isBounded() || containsLattice(a.lo, a.hi, 0.0, M_PI)) return Interval::entire();
+    return decreasing(a, op_cot<float>, LIBM_ULPS);
+}
+
+// 1 / cos on one branch (cos keeps its sign between poles)
+Interval iv_sec(Interval a) {
+    if (a.isEmpty()) return a;
+    if (!a.isBounded() || containsLattice(a.lo, a.hi, M_PI / 2.0, M_PI)) return Interval::entire();
+    return iv_div({1.0f, 1.0f}, iv_cos(a));
+}
+
+Interval iv_csc(Interval a) {
+    if (a.isEmpty()) return a;
+    if (!a.isBounded() || containsLattice(a.lo, a.hi, 0.0, M_PI)) return Interval::entire();
+    return iv_div({1.0f, 1.0f}, iv_sin(a));
+}
+
+Interval iv_arcsin(Interval a) {
+    if (a.isEmpty() || a.hi < -1.0f || a.lo > 1.0f) return Interval::empty();
+    return increasing(clampUnit(a), op_arcsin<float>, LIBM_ULPS);
+}
+
+Interval iv_arccos(Interval a) {
+    if (a.isEmpty() || a.hi < -1.0f || a.lo > 1.0f) return Interval::empty();
+    return decreasing(clampUnit(a), op_arccos<float>, LIBM_ULPS);
+}
+
+Interval iv_arctan(Interval a) {
+    return increasing(a, op_arctan<float>, LIBM_ULPS);
+}
+
+Interval iv_arccot(Interval a) {
+    return decreasing(a, op_arccot<float>, LIBM_ULPS);
+}
+
+// op_arcsec/op_arccsc take 1.0f / a; at a = 0 both give NaN either way
+Interval iv_arcsec(Interval a) {
+    return iv_arccos(iv_div({1.0f, 1.0f}, a));
+}
+
+Interval iv_arccsc(Interval a) {
+    return iv_arcsin(iv_div({1.0f, 1.0f}, a));
+}
+
+// Defined on [0, inf]; log(0) = -inf
+Interval iv_log(Interval a) {
+    if (a.isEmpty() || a.hi < 0.0f) return Interval::empty();
+    return increasing({std::max(a.lo, 0.0f), a.hi}, op_log<float>, LIBM_ULPS);
+}
+
+Interval iv_ln(Interval a) {
+    if (a.isEmpty() || a.hi < 0.0f) return Interval::empty();
+    return increasing({std::max(a.lo, 0.0f), a.hi}, op_ln<float>, LIBM_ULPS);
+}
+
+Interval iv_sqrt(Interval a) {
+    if (a.isEmpty() || a.hi < 0.0f) return Interval::empty();
+    return increasing({std::max(a.lo, 0.0f), a.hi}, op_sqrt<float>, 1);
+}
+
+Interval iv_abs(Interval a) {
+    if (a.isEmpty()) return a;
+    if (a.lo >= 0.0f) return a;
+    if (a.hi <= 0.0f) return {-a.hi, -a.lo};
+    return {0.0f, std::max(-a.lo, a.hi)};
+}
+
+Interval iv_floor(Interval a) {
+    if (a.isEmpty()) return a;
+    return {op_floor(a.lo), op_floor(a.hi)};
+}
+
+Interval iv_ceil(Interval a) {
+    if (a.isEmpty()) return a;
+    return {op_ceil(a.lo), op_ceil(a.hi)};
+}
+
+// Gamma(t) for t > 0 falls to its minimum at t ~ 1.4616 then rises. For
+// t <= 0 it has a pole at every integer and alternates sign in between.
+static constexpr double GAMMA_MIN_X = 1.4616321449683623;
+static constexpr float GAMMA_MIN = 0.885603194f;
+
+Interval iv_factorial(Interval a) {
+    if (a.isEmpty()) return a;
+    Interval t = iv_add(a, {1.0f, 1.0f});   // op_factorial is tgamma(a + 1)
+    auto gamma = [](float v) { return std::tgamma(v); };
+
+    // Between two poles log|Gamma| is convex, so |Gamma| peaks at an end
+    // of the range. The sign is that of the cell: (-1, 0) is negative.
+    if (!(t.lo > 0.0f)) {
+        double pole = std::ceil(static_cast<double>(t.lo));
+        if (pole <= static_cast<double>(t.hi)) return Interval::entire();
+        float peak = up(std::max(std::abs(gamma(t.lo)), std::abs(gamma(t.hi))), GAMMA_ULPS);
+        if (std::fmod(pole, 2.0) == 0.0) return {-peak, 0.0f};
+        return {0.0f, peak};
+    }
+    if (t.hi <= GAMMA_MIN_X) return decreasing(t, gamma, GAMMA_ULPS);
+    if (t.lo >= GAMMA_MIN_X) return increasing(t, gamma, GAMMA_ULPS);
+    return {down(GAMMA_MIN, GAMMA_ULPS), up(std::max(gamma(t.lo), gamma(t.hi)), GAMMA_ULPS)};
+}
@@ -0,0 +1,62 @@
+#ifndef _INTERVAL_H_
+#define _INTERVAL_H_
+
+#include <limits>
+
+// Closed range [lo, hi] of floats, possibly unbounded (lo = -inf, hi = +inf).
+// Interval kernels return an enclosure: every value the matching op_* kernel
+// can produce for inputs drawn from the argument intervals lies inside the
+// result. Inputs where op_* gives NaN (outside the domain) are ignored; an
+// interval with lo > hi is empty and means "undefined everywhere".
+// Results are rounded outward, so the enclosure holds despite float rounding.
+struct Interval {
+    float lo;
+    float hi;
+
+    static Interval point(float v) { return (v == v) ? Interval{v, v} : empty(); }
+    static Interval empty() {
+        return {std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+    }
+    static Interval entire() {
+        return {-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+    }
+
+    bool isEmpty() const { return !(lo <= hi); }
+    bool isBounded() const {
+        return lo > -std::numeric_limits<float>::infinity() && hi < std::numeric_limits<float>::infinity();
+    }
+    bool contains(float v) const { return lo <= v && v <= hi; }
+};
+
+// Unary kernels
+// -------------
+Interval iv_negate(Interval a);
+Interval iv_sin(Interval a);
+Interval iv_cos(Interval a);
+Interval iv_tan(Interval a);
+Interval iv_cot(Interval a);
+Interval iv_sec(Interval a);
+Interval iv_csc(Interval a);
+Interval iv_arcsin(Interval a);
+Interval iv_arccos(Interval a);
+Interval iv_arctan(Interval a);
+Interval iv_arccot(Interval a);
+Interval iv_arcsec(Interval a);
+Interval iv_arccsc(Interval a);
+Interval iv_log(Interval a);
+Interval iv_ln(Interval a);
+Interval iv_sqrt(Interval a);
+Interval iv_abs(Interval a);
+Interval iv_floor(Interval a);
+Interval iv_ceil(Interval a);
+Interval iv_factorial(Interval a);
+
+// Binary kernels
+// --------------
+Interval iv_add(Interval a, Interval b);
+Interval iv_sub(Interval a, Interval b);
+Interval iv_mul(Interval a, Interval b);
+Interval iv_div(Interval a, Interval b);
+Interval iv_pow(Interval a, Interval b);
+
+#endif /* _INTERVAL_H_ */
@@ -0,0 +1,474 @@
+#include "Jit.h"
+#include "Operations.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if !defined(PARSER_NO_JIT) && (defined(__x86_64__) || defined(_M_X64)) && !defined(_WIN32)
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #define JIT_X86_64 1
+#endif
+
+#if defined(JIT_X86_64)
+
+// x86-64 encoding
+// ---------------
+enum Register {
+    RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+    R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+// Register roles inside generated code. All callee-saved, so they survive
+// the calls into op_* kernels.
+static constexpr Register FRAME_REG = RBX;     // const float* frame
+static constexpr Register CONST_REG = R12;     // const float* constants
+static constexpr Register VALUES_REG = R13;    // batch: next input value
+static constexpr Register OUT_REG = R14;       // batch: next output
+static constexpr Register COUNT_REG = R15;     // batch: values left
+
+// Every value stack slot gets 16 bytes so the packed body can spill a
+// whole vector. The top of the stack is always in xmm0.
+static constexpr int32_t SLOT_SIZE = 16;
+
+// SSE opcodes (second byte after 0x0F)
+static constexpr uint8_t SSE_MOVLOAD = 0x10;
+static constexpr uint8_t SSE_MOVSTORE = 0x11;
+static constexpr uint8_t SSE_MOVAPS = 0x28;
+static constexpr uint8_t SSE_SQRT = 0x51;
+static constexpr uint8_t SSE_AND = 0x54;
+static constexpr uint8_t SSE_XOR = 0x57;
+static constexpr uint8_t SSE_ADD = 0x58;
+static constexpr uint8_t SSE_MUL = 0x59;
+static constexpr uint8_t SSE_SUB = 0x5C;
+static constexpr uint8_t SSE_DIV = 0x5E;
+static constexpr uint8_t SSE_SHUFPS = 0xC6;
+
+class Emitter {
+    private:
+        std::vector<uint8_t> bytes;
+
+    public:
+        const std::vector<uint8_t>& getBytes() const { return bytes; }
+        size_t offset() const { return bytes.size(); }
+
+        void byte(uint8_t b) { bytes.push_back(b); }
+        void u32(uint32_t v) { for (int i = 0; i < 4; ++i) byte(static_cast<uint8_t>(v >> (8 * i))); }
+        void u64(uint64_t v) { for (int i = 0; i < 8; ++i) byte(static_cast<uint8_t>(v >> (8 * i))); }
+
+        // <prefix> 0F <opcode> xmm, [base + disp32]  (prefix 0 = packed form)
+        void sseMem(uint8_t prefix, uint8_t opcode, int xmm, Register base, int32_t disp) {
+            if (prefix) byte(prefix);
+            if (base >= R8) byte(0x41);
+            byte(0x0F);
+            byte(opcode);
+            byte(static_cast<uint8_t>(0x80 | (xmm << 3) | (base & 7)));
+            if ((base & 7) == RSP) byte(0x24);   // rsp and r12 need a SIB byte
+            u32(static_cast<uint32_t>(disp));
+        }
+
+        // <prefix> 0F <opcode> xmm<dst>, xmm<src>  (xmm0-7 only)
+        void sseReg(uint8_t prefix, uint8_t opcode, int dst, int src) {
+            if (prefix) byte(prefix);
+            byte(0x0F);
+            byte(opcode);
+            byte(static_cast<uint8_t>(0xC0 | (dst << 3) | src));
+        }
+
+        // Scalar (ss) or packed (ps) arithmetic
+        void arith(bool packed, uint8_t opcode, int dst, int src) {
+            sseReg(packed ? 0 : 0xF3, opcode, dst, src);
+        }
+
+        void load(bool packed, int xmm, Register base, int32_t disp) {
+            sseMem(packed ? 0 : 0xF3, SSE_MOVLOAD, xmm, base, disp);
+        }
+        void store(bool packed, int xmm, Register base, int32_t disp) {
+            sseMem(packed ? 0 : 0xF3, SSE_MOVSTORE, xmm, base, disp);
+        }
+
+        // Copy lane 0 of xmm<reg> into every lane
+        void broadcast(int reg) {
+            sseReg(0, SSE_SHUFPS, reg, reg);
+            byte(0x00);
+        }
+
+        void push(Register reg) { if (reg >= R8) byte(0x41); byte(static_cast<uint8_t>(0x50 | (reg & 7))); }
+        void pop(Register reg)  { if (reg >= R8) byte(0x41); byte(static_cast<uint8_t>(0x58 | (reg & 7))); }
+
+        // mov dst, src (64-bit)
+        void movReg(Register dst, Register src) {
+            byte(static_cast<uint8_t>(0x48 | (src >= R8 ? 4 : 0) | (dst >= R8 ? 1 : 0)));
+            byte(0x89);
+            byte(static_cast<uint8_t>(0xC0 | ((src & 7) << 3) | (dst & 7)));
+        }
+
+        // mov reg, imm64
+        void movImm64(Register reg, uint64_t value) {
+            byte(static_cast<uint8_t>(0x48 | (reg >= R8 ? 1 : 0)));
+            byte(static_cast<uint8_t>(0xB8 | (reg & 7)));
+            u64(value);
+        }
+
+        // mov eax, imm32; movd xmm<reg>, eax
+        void movBits(int xmm, uint32_t bits) {
+            byte(0xB8);
+            u32(bits);
+            byte(0x66); byte(0x0F); byte(0x6E);
+            byte(static_cast<uint8_t>(0xC0 | (xmm << 3)));
+        }
+
+        // add/sub/cmp reg, imm (64-bit). <ext> is the ModRM opcode extension.
+        void aluImm8(int ext, Register reg, int8_t value) {
+            byte(static_cast<uint8_t>(0x48 | (reg >= R8 ? 1 : 0)));
+            byte(0x83);
+            byte(static_cast<uint8_t>(0xC0 | (ext << 3) | (reg & 7)));
+            byte(static_cast<uint8_t>(value));
+        }
+        void aluImm32(int ext, Register reg, int32_t value) {
+            byte(static_cast<uint8_t>(0x48 | (reg >= R8 ? 1 : 0)));
+            byte(0x81);
+            byte(static_cast<uint8_t>(0xC0 | (ext << 3) | (reg & 7)));
+            u32(static_cast<uint32_t>(value));
+        }
+        void addImm(Register reg, int8_t value) { aluImm8(0, reg, value); }
+        void subImm(Register reg, int8_t value) { aluImm8(5, reg, value); }
+        void cmpImm(Register reg, int8_t value) { aluImm8(7, reg, value); }
+
+        void testReg(Register reg) {
+            byte(static_cast<uint8_t>(0x48 | (reg >= R8 ? 5 : 0)));
+            byte(0x85);
+            byte(static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (reg & 7)));
+        }
+
+        void callAbsolute(const void* target) {
+            movImm64(RAX, reinterpret_cast<uint64_t>(target));
+            byte(0xFF); byte(0xD0);     // call rax
+        }
+
+        // Jumps with a rel32 to be patched by bind()
+        size_t jump()            { byte(0xE9); u32(0); return offset(); }
+        size_t jumpIf(uint8_t cc) { byte(0x0F); byte(static_cast<uint8_t>(0x80 | cc)); u32(0); return offset(); }
+        void bind(size_t jumpEnd, size_t target) {
+            uint32_t rel = static_cast<uint32_t>(static_cast<int32_t>(target) - static_cast<int32_t>(jumpEnd));
+            std::memcpy(&bytes[jumpEnd - 4], &rel, 4);
+        }
+
+        void ret() { byte(0xC3); }
+};
+
+static constexpr uint8_t CC_BELOW = 0x2;   // unsigned <
+static constexpr uint8_t CC_EQUAL = 0x4;
+
+using UnaryKernel = float(*)(float);
+using BinaryKernel = float(*)(float, float);
+
+static UnaryKernel getUnaryKernel(OpCode op) {
+    switch (op) {
+        case OP_SIN:        return op_sin;
+        case OP_COS:        return op_cos;
+        case OP_TAN:        return op_tan;
+        case OP_COT:        return op_cot;
+        case OP_SEC:        return op_sec;
+        case OP_CSC:        return op_csc;
+        case OP_ARCSIN:     return op_arcsin;
+        case OP_ARCCOS:     return op_arccos;
+        case OP_ARCTAN:     return op_arctan;
+        case OP_ARCCOT:     return op_arccot;
+        case OP_ARCSEC:     return op_arcsec;
+        case OP_ARCCSC:     return op_arccsc;
+        case OP_LOG:        return op_log;
+        case OP_LN:         return op_ln;
+        case OP_FACTORIAL:  return op_factorial;
+        case OP_FLOOR:      return op_floor;
+        case OP_CEIL:       return op_ceil;
+        default:            return nullptr;
+    }
+}
+
+static uint8_t getArithOpcode(OpCode op) {
+    switch (op) {
+        case OP_ADD: return SSE_ADD;
+        case OP_SUB: return SSE_SUB;
+        case OP_MUL: return SSE_MUL;
+        case OP_DIV: return SSE_DIV;
+        default:     return 0;
+    }
+}
+
+// Emit one evaluation of <program>, leaving the result in xmm0.
+// Packed bodies compute four lanes at once. Returns false on an op the
+// JIT can't translate.
+static bool emitBody(Emitter& e, const Program& program, uint32_t varying, bool packed) {
+    const int32_t temp = program.getStackDepth() * SLOT_SIZE;
+    int depth = 0;
+    auto slot = [](int index) { return index * SLOT_SIZE; };
+
+    // Spill the current top of stack before pushing a new value into xmm0
+    auto push = [&]() {
+        if (depth > 0) e.store(packed, 0, RSP, slot(depth - 1));
+        depth++;
+    };
+
+    for (const Instruction& instruction : program.getCode()) {
+        OpCode op = instruction.op;
+        int32_t arg = static_cast<int32_t>(instruction.arg);
+
+        switch (op) {
+            case OP_CONST:
+                push();
+                e.load(false, 0, CONST_REG, arg * 4);
+                if (packed) e.broadcast(0);
+                break;
+            case OP_VAR:
+                push();
+                if (instruction.arg == varying) {
+                    e.load(packed, 0, VALUES_REG, 0);
+                } else {
+                    e.load(false, 0, FRAME_REG, arg * 4);
+                    if (packed) e.broadcast(0);
+                }
+                break;
+
+            // Sign-bit tricks, same bits as op_negate / op_abs
+            case OP_NEG:
+            case OP_ABS:
+                e.movBits(1, op == OP_NEG ? 0x80000000u : 0x7FFFFFFFu);
+                if (packed) e.broadcast(1);
+                e.sseReg(0, op == OP_NEG ? SSE_XOR : SSE_AND, 0, 1);
+                break;
+            case OP_SQRT:
+                e.arith(packed, SSE_SQRT, 0, 0);
+                break;
+
+            case OP_ADD:
+            case OP_SUB:
+            case OP_MUL:
+            case OP_DIV:
+                e.sseReg(0, SSE_MOVAPS, 1, 0);
+                e.load(packed, 0, RSP, slot(depth - 2));
+                if (op == OP_DIV) {
+                    // op_div ignores the sign of a zero divisor; -0 + 0 = +0
+                    e.sseReg(0, SSE_XOR, 2, 2);
+                    e.arith(packed, SSE_ADD, 1, 2);
+                }
+                e.arith(packed, getArithOpcode(op), 0, 1);
+                depth--;
+                break;
+
+            case OP_POW: {
+                const void* kernel = reinterpret_cast<const void*>(static_cast<BinaryKernel>(op_pow));
+                int32_t left = slot(depth - 2);
+                if (!packed) {
+                    e.sseReg(0, SSE_MOVAPS, 1, 0);
+                    e.load(false, 0, RSP, left);
+                    e.callAbsolute(kernel);
+                } else {
+                    // One call per lane; results collect in the left operand's slot
+                    e.store(true, 0, RSP, temp);
+                    for (int lane = 0; lane < 4; ++lane) {
+                        e.load(false, 0, RSP, left + lane * 4);
+                        e.load(false, 1, RSP, temp + lane * 4);
+                        e.callAbsolute(kernel);
+                        e.store(false, 0, RSP, left + lane * 4);
+                    }
+                    e.load(true, 0, RSP, left);
+                }
+                depth--;
+                break;
+            }
+
+            default: {
+                UnaryKernel kernel = getUnaryKernel(op);
+                if (!kernel) return false;
+                const void* target = reinterpret_cast<const void*>(kernel);
+                if (!packed) {
+                    e.callAbsolute(target);
+                } else {
+                    e.store(true, 0, RSP, temp);
+                    for (int lane = 0; lane < 4; ++lane) {
+                        e.load(false, 0, RSP, temp + lane * 4);
+                        e.callAbsolute(target);
+                        e.store(false, 0, RSP, temp + lane * 4);
+                    }
+                    e.load(true, 0, RSP, temp);
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// Save the registers generated code uses and make room for the value
+// stack. Five pushes on top of the return address leave rsp 16-aligned,
+// as calls require, and <frameSize> keeps it that way.
+static void emitPrologue(Emitter& e, int32_t frameSize, const float* constants) {
+    e.push(RBX); e.push(R12); e.push(R13); e.push(R14); e.push(R15);
+    e.aluImm32(5, RSP, frameSize);
+    e.movReg(FRAME_REG, RDI);
+    e.movImm64(CONST_REG, reinterpret_cast<uint64_t>(constants));
+}
+
+static void emitEpilogue(Emitter& e, int32_t frameSize) {
+    e.aluImm32(0, RSP, frameSize);
+    e.pop(R15); e.pop(R14); e.pop(R13); e.pop(R12); e.pop(RBX);
+    e.ret();
+}
+
+// float f(const float* frame)
+static bool emitFunction(Emitter& e, const Program& program, const float* constants) {
+    int32_t frameSize = (program.getStackDepth() + 1) * SLOT_SIZE;
+    emitPrologue(e, frameSize, constants);
+    if (!emitBody(e, program, NO_SLOT, false)) return false;
+    emitEpilogue(e, frameSize);
+    return true;
+}
+
+// void f(const float* frame, const float* values, float* out, size_t count)
+static bool emitBatchFunction(Emitter& e, const Program& program, const float* constants, uint32_t varying) {
+    int32_t frameSize = (program.getStackDepth() + 1) * SLOT_SIZE;
+    emitPrologue(e, frameSize, constants);
+    e.movReg(VALUES_REG, RSI);
+    e.movReg(OUT_REG, RDX);
+    e.movReg(COUNT_REG, RCX);
+
+    // Four lanes at a time
+    size_t vectorLoop = e.offset();
+    e.cmpImm(COUNT_REG, 4);
+    size_t toTail = e.jumpIf(CC_BELOW);
+    if (!emitBody(e, program, varying, true)) return false;
+    e.store(true, 0, OUT_REG, 0);
+    e.addImm(VALUES_REG, 16);
+    e.addImm(OUT_REG, 16);
+    e.subImm(COUNT_REG, 4);
+    e.bind(e.jump(), vectorLoop);
+
+    // Then the rest one by one
+    size_t tailLoop = e.offset();
+    e.bind(toTail, tailLoop);
+    e.testReg(COUNT_REG);
+    size_t toDone = e.jumpIf(CC_EQUAL);
+    if (!emitBody(e, program, varying, false)) return false;
+    e.store(false, 0, OUT_REG, 0);
+    e.addImm(VALUES_REG, 4);
+    e.addImm(OUT_REG, 4);
+    e.subImm(COUNT_REG, 1);
+    e.bind(e.jump(), tailLoop);
+
+    e.bind(toDone, e.offset());
+    emitEpilogue(e, frameSize);
+    return true;
+}
+
+#endif /* JIT_X86_64 */
+
+
+// JitProgram
+// ----------
+bool JitProgram::isSupported() {
+#if defined(JIT_X86_64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+JitProgram JitProgram::compile(const Program& program, uint32_t varying) {
+    JitProgram jit;
+    jit.program = program;
+    jit.constants = program.getConstants();
+    jit.varying = varying;
+
+#if defined(JIT_X86_64)
+    if (program.empty()) return jit;
+
+    // Both functions share one mapping: scalar first, batch after it
+    Emitter e;
+    if (!emitFunction(e, program, jit.constants.data())) return jit;
+    size_t batchOffset = e.offset();
+    if (!emitBatchFunction(e, program, jit.constants.data(), varying)) return jit;
+
+    const std::vector<uint8_t>& code = e.getBytes();
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t size = (code.size() + page - 1) / page * page;
+
+    // Write, then flip to read+execute; never writable and executable at once
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return jit;
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return jit;
+    }
+
+    jit.memory = memory;
+    jit.memorySize = size;
+    jit.function = reinterpret_cast<JitFunc>(memory);
+    jit.batchFunction = reinterpret_cast<JitBatchFunc>(static_cast<uint8_t*>(memory) + batchOffset);
+#endif
+    return jit;
+}
+
+void JitProgram::release() {
+#if defined(JIT_X86_64)
+    if (memory) munmap(memory, memorySize);
+#endif
+    memory = nullptr;
+    memorySize = 0;
+    function = nullptr;
+    batchFunction = nullptr;
+}
+
+JitProgram::~JitProgram() {
+    release();
+}
+
+// Moving the constants vector keeps its buffer, so the address baked
+// into the code stays valid
+JitProgram::JitProgram(JitProgram&& other) noexcept
+    : program(std::move(other.program)), constants(std::move(other.constants)),
+      varying(other.varying), memory(other.memory), memorySize(other.memorySize),
+      function(other.function), batchFunction(other.batchFunction) {
+    other.memory = nullptr;
+    other.memorySize = 0;
+    other.function = nullptr;
+    other.batchFunction = nullptr;
+}
+
+JitProgram& JitProgram::operator=(JitProgram&& other) noexcept {
+    if (this != &other) {
+        release();
+        program = std::move(other.program);
+        constants = std::move(other.constants);
+        varying = other.varying;
+        memory = other.memory;
+        memorySize = other.memorySize;
+        function = other.function;
+        batchFunction = other.batchFunction;
+
+        other.memory = nullptr;
+        other.memorySize = 0;
+        other.function = nullptr;
+        other.batchFunction = nullptr;
+    }
+    return *this;
+}
+
+float JitProgram::run(const float* frame) const {
+    if (function) return function(frame);
+    if (program.empty()) return 0.0f;
+    return program.run(frame);
+}
+
+void JitProgram::runBatch(const float* frame, const float* values, float* out, size_t count) const {
+    if (batchFunction) {
+        batchFunction(frame, values, out, count);
+        return;
+    }
+    if (program.empty()) {
+        std::fill(out, out + count, 0.0f);
+        return;
+    }
+    program.runBatch(frame, varying, values, out, count);
+}
@@ -0,0 +1,67 @@
+#ifndef _JIT_H_
+#define _JIT_H_
+
+#include "Bytecode.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Native code for a compiled Program.
+// Signatures of the generated functions (System V x86-64 calling convention):
+using JitFunc = float(*)(const float* frame);
+using JitBatchFunc = void(*)(const float* frame, const float* values, float* out, size_t count);
+
+// Translates a Program's bytecode, instruction by instruction, into x86-64
+// SSE code in an executable page: straight-line code with no dispatch. The
+// batched function runs four lanes per iteration with packed instructions,
+// with a scalar loop for the remainder. Transcendentals call the same op_*
+// kernels as the interpreter, so results are bit-identical to Program::run().
+//
+// Where native code isn't available (non x86-64, Windows, PARSER_ENABLE_JIT
+// off, or the page can't be mapped), run() and runBatch() fall back to the
+// interpreter and isNative() is false.
+class JitProgram {
+    private:
+        Program program;            // interpreter fallback
+        std::vector<float> constants;
+        uint32_t varying = NO_SLOT;
+
+        void* memory = nullptr;
+        size_t memorySize = 0;
+        JitFunc function = nullptr;
+        JitBatchFunc batchFunction = nullptr;
+
+        void release();
+
+    public:
+        JitProgram() = default;
+        ~JitProgram();
+
+        // Owns an executable mapping
+        JitProgram(const JitProgram&) = delete;
+        JitProgram& operator=(const JitProgram&) = delete;
+        JitProgram(JitProgram&& other) noexcept;
+        JitProgram& operator=(JitProgram&& other) noexcept;
+
+        // Generate code for <program>. The batched function feeds values[i]
+        // into frame slot <varying>, like Program::runBatch().
+        static JitProgram compile(const Program& program, uint32_t varying = NO_SLOT);
+
+        // Whether this build and platform can generate native code at all
+        static bool isSupported();
+
+        bool isNative() const { return function != nullptr; }
+
+        // Native when possible, interpreted otherwise
+        float run(const float* frame) const;
+        void runBatch(const float* frame, const float* values, float* out, size_t count) const;
+
+        // nullptr unless isNative()
+        JitFunc getFunction() const { return function; }
+        JitBatchFunc getBatchFunction() const { return batchFunction; }
+
+        // Bytes of executable memory held (whole pages)
+        size_t getMappedSize() const { return memorySize; }
+};
+
+#endif /* _JIT_H_ */
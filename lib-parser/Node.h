@@ -3,23 +3,12 @@
 
 #include "Tokenizer.h"
 #include "SymbolTable.h"
-#include <memory>
+#include "Operations.h"
+#include "Arena.h"
+#include <string_view>
 #include <cmath>
 #include <limits>
 
-// Mathematical constants
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
-#ifndef M_E
-#define M_E 2.71828182845904523536
-#endif
-
-#ifndef M_PHI
-#define M_PHI 1.61803398874989484820
-#endif
-
 // Forward declarations
 class Node;
 
@@ -27,64 +16,103 @@ class Node;
 using UnaryFunc = float(*)(float);
 using BinaryFunc = float(*)(float, float);
 
-// Abstract base class
+// Node kinds, used by passes that walk the tree (e.g. the bytecode compiler)
+enum NodeType {
+    CONSTANT_NODE,
+    VARIABLE_NODE,
+    UNARY_NODE,
+    BINARY_NODE
+};
+
+// Abstract base class.
+// Nodes live in an Arena (see the factories below), which frees them all at
+// once without running destructors, so children are plain non-owning
+// pointers and every node type stays trivially destructible.
 class Node {
 public:
-    virtual ~Node() = default;
     virtual float evaluate(SymbolTable& symbols) const = 0;
+    virtual NodeType getType() const = 0;
+protected:
+    ~Node() = default;
 };
 
+// Holds the value at both evaluation precisions. The float one is what
+// float evaluation has always produced (e.g. a literal parsed as float),
+// the wide one feeds double evaluation.
 class ConstantNode : public Node {
 private:
     float value;
+    double wideValue;
 public:
-    explicit ConstantNode(float val) : value(val) {}
+    ConstantNode(float val, double wide) : value(val), wideValue(wide) {}
     float evaluate(SymbolTable& symbols) const override { return value; }
+    NodeType getType() const override { return CONSTANT_NODE; }
+    float getValue() const { return value; }
+    double getWideValue() const { return wideValue; }
 };
 
 class VariableNode : public Node {
 private:
-    std::string name;
+    std::string_view name;  // stored in the same arena as the node
 public:
-    explicit VariableNode(const std::string& varName) : name(varName) {}
+    explicit VariableNode(std::string_view varName) : name(varName) {}
     float evaluate(SymbolTable& symbols) const override {
-        return symbols.GetValue(name);
+        return symbols.GetValue(std::string(name));
     }
-    const std::string& getName() const { return name; }
+    NodeType getType() const override { return VARIABLE_NODE; }
+    std::string_view getName() const { return name; }
 };
 
 class UnaryOpNode : public Node {
 private:
-    std::unique_ptr<Node> operand;
+    Node* operand;
     UnaryFunc operation;
+    TokenType opType;
 public:
-    UnaryOpNode(std::unique_ptr<Node> op, UnaryFunc func)
-        : operand(std::move(op)), operation(func) {}
+    UnaryOpNode(Node* op, UnaryFunc func, TokenType type)
+        : operand(op), operation(func), opType(type) {}
     
     float evaluate(SymbolTable& symbols) const override {
         return operation(operand->evaluate(symbols));
     }
+    NodeType getType() const override { return UNARY_NODE; }
+    TokenType getOpType() const { return opType; }
+    const Node& getOperand() const { return *operand; }
+    Node* getOperandNode() { return operand; }
+    void setOperand(Node* op) { operand = op; }
 };
 
 class BinaryOpNode : public Node {
 private:
-    std::unique_ptr<Node> left;
-    std::unique_ptr<Node> right;
+    Node* left;
+    Node* right;
     BinaryFunc operation;
+    TokenType opType;
 public:
-    BinaryOpNode(std::unique_ptr<Node> l, std::unique_ptr<Node> r, BinaryFunc func)
-        : left(std::move(l)), right(std::move(r)), operation(func) {}
+    BinaryOpNode(Node* l, Node* r, BinaryFunc func, TokenType type)
+        : left(l), right(r), operation(func), opType(type) {}
     
     float evaluate(SymbolTable& symbols) const override {
         return operation(left->evaluate(symbols), right->evaluate(symbols));
     }
+    NodeType getType() const override { return BINARY_NODE; }
+    TokenType getOpType() const { return opType; }
+    const Node& getLeft() const { return *left; }
+    const Node& getRight() const { return *right; }
+    Node* getLeftNode() { return left; }
+    Node* getRightNode() { return right; }
+    void setLeft(Node* l) { left = l; }
+    void setRight(Node* r) { right = r; }
 };
 
-// Factory functions
+// Factory functions. Nodes are allocated in <arena> and live as long as it.
 UnaryFunc getUnaryOp(TokenType type);
 BinaryFunc getBinaryOp(TokenType type);
 
-std::unique_ptr<Node> makeUnaryNode(TokenType type, std::unique_ptr<Node> operand);
-std::unique_ptr<Node> makeBinaryNode(TokenType type, std::unique_ptr<Node> left, std::unique_ptr<Node> right);
+Node* makeConstantNode(Arena& arena, float value);
+Node* makeConstantNode(Arena& arena, float value, double wideValue);
+Node* makeVariableNode(Arena& arena, std::string_view name);
+Node* makeUnaryNode(Arena& arena, TokenType type, Node* operand);
+Node* makeBinaryNode(Arena& arena, TokenType type, Node* left, Node* right);
 
 #endif /* _NODE_H_ */
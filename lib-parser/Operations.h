@@ -0,0 +1,74 @@
+#ifndef _OPERATIONS_H_
+#define _OPERATIONS_H_
+
+#include <cmath>
+#include <limits>
+
+// Mathematical constants
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifndef M_E
+#define M_E 2.71828182845904523536
+#endif
+
+#ifndef M_PHI
+#define M_PHI 1.61803398874989484820
+#endif
+
+// Scalar kernels shared by the tree evaluator (Node.cpp) and the
+// bytecode interpreter (Bytecode.cpp). Inline so the interpreter's
+// switch can fold them in without a call. Templated on the scalar type:
+// float everywhere, double for the wide evaluation path (deep zoom).
+
+// Unary operation implementations
+// -------------------------------
+template <typename T> inline T op_sin(T a) { return std::sin(a); }
+template <typename T> inline T op_cos(T a) { return std::cos(a); }
+template <typename T> inline T op_tan(T a) { return std::tan(a); }
+template <typename T> inline T op_cot(T a) { 
+    T t = std::tan(a);
+    return t != T(0) ? T(1) / t : T(0);
+}
+template <typename T> inline T op_sec(T a) {
+    T c = std::cos(a);
+    return c != T(0) ? T(1) / c : T(0);
+}
+template <typename T> inline T op_csc(T a) {
+    T s = std::sin(a);
+    return s != T(0) ? T(1) / s : T(0);
+}
+template <typename T> inline T op_arcsin(T a) { return std::asin(a); }
+template <typename T> inline T op_arccos(T a) { return std::acos(a); }
+template <typename T> inline T op_arctan(T a) { return std::atan(a); }
+template <typename T> inline T op_arccot(T a) { return static_cast<T>(M_PI / 2.0) - std::atan(a); }
+template <typename T> inline T op_arcsec(T a) { return std::acos(T(1) / a); }
+template <typename T> inline T op_arccsc(T a) { return std::asin(T(1) / a); }
+template <typename T> inline T op_log(T a) { return std::log10(a); }
+template <typename T> inline T op_ln(T a) { return std::log(a); }
+template <typename T> inline T op_sqrt(T a) { return std::sqrt(a); }
+template <typename T> inline T op_abs(T a) { return std::abs(a); }
+template <typename T> inline T op_floor(T a) { return std::floor(a); }
+template <typename T> inline T op_ceil(T a) { return std::ceil(a); }
+template <typename T> inline T op_factorial(T a) { return std::tgamma(a + T(1)); }
+template <typename T> inline T op_negate(T a) { return -a; }
+
+
+// Binary operation implementations
+// --------------------------------
+template <typename T> inline T op_add(T a, T b) { return a + b; }
+template <typename T> inline T op_sub(T a, T b) { return a - b; }
+template <typename T> inline T op_mul(T a, T b) { return a * b; }
+template <typename T> inline T op_div(T a, T b) {
+    if (b != T(0)) {
+        return a / b;
+    }
+    // Handle division by zero - return appropriate infinity or NaN
+    if (a > T(0)) return std::numeric_limits<T>::infinity();
+    if (a < T(0)) return -std::numeric_limits<T>::infinity();
+    return std::numeric_limits<T>::quiet_NaN();
+}
+template <typename T> inline T op_pow(T a, T b) { return std::pow(a, b); }
+
+#endif /* _OPERATIONS_H_ */
@@ -0,0 +1,130 @@
+#include "Optimizer.h"
+#include "Bytecode.h"
+#include <cmath>
+
+static bool isConstant(const Node& node) {
+    return node.getType() == CONSTANT_NODE;
+}
+
+// Must hold at both precisions: 1.00000001 is 1 as a float but must not
+// make x*1.00000001 drop the factor from double evaluation, and ln(e) is
+// 1 in double but not in float
+static bool isConstant(const Node& node, float value) {
+    if (!isConstant(node)) return false;
+    const auto& constant = static_cast<const ConstantNode&>(node);
+    return constant.getValue() == value && constant.getWideValue() == value;
+}
+
+// A zero of the given sign: x+0 is +0 for x = -0, so only x+(-0) and
+// x-(+0) give back x bit for bit
+static bool isZero(const Node& node, bool negative) {
+    if (!isConstant(node, 0.0f)) return false;
+    const auto& constant = static_cast<const ConstantNode&>(node);
+    return std::signbit(constant.getValue()) == negative && std::signbit(constant.getWideValue()) == negative;
+}
+
+// Constant subtrees never touch the symbol table. The float value comes
+// from the tree walker as before; the wide one from running the subtree's
+// bytecode in double, so double evaluation keeps e.g. 2*pi to 16 digits.
+static Node* fold(Arena& arena, const Node& node) {
+    SymbolTable empty;
+    const double* noVariables = nullptr;
+    return makeConstantNode(arena, node.evaluate(empty), Program::compile(node).run(noVariables));
+}
+
+static Node* simplify(Arena& arena, Node* node);
+
+// Nodes are rewired in place. Nodes that drop out of the tree stay in the
+// arena until it is released.
+static Node* simplifyUnary(Arena& arena, Node* node) {
+    auto& unary = static_cast<UnaryOpNode&>(*node);
+    TokenType type = unary.getOpType();
+    Node* operand = simplify(arena, unary.getOperandNode());
+    unary.setOperand(operand);
+
+    if (isConstant(*operand)) {
+        return fold(arena, unary);
+    }
+
+    // --x -> x
+    if (type == MINUS_TOKEN && operand->getType() == UNARY_NODE &&
+        static_cast<UnaryOpNode&>(*operand).getOpType() == MINUS_TOKEN) {
+        return static_cast<UnaryOpNode&>(*operand).getOperandNode();
+    }
+
+    return node;
+}
+
+static Node* simplifyBinary(Arena& arena, Node* node) {
+    auto& binary = static_cast<BinaryOpNode&>(*node);
+    TokenType type = binary.getOpType();
+    Node* left = simplify(arena, binary.getLeftNode());
+    Node* right = simplify(arena, binary.getRightNode());
+    binary.setLeft(left);
+    binary.setRight(right);
+
+    if (isConstant(*left) && isConstant(*right)) {
+        return fold(arena, binary);
+    }
+
+    switch (type) {
+        case PLUS_TOKEN:
+            if (isZero(*right, true)) return left;
+            if (isZero(*left, true))  return right;
+            break;
+        case MINUS_TOKEN:
+            if (isZero(*right, false)) return left;
+            if (isZero(*left, true))   return simplify(arena, makeUnaryNode(arena, MINUS_TOKEN, right));
+            break;
+        case TIMES_TOKEN:
+            if (isConstant(*right, 1.0f))  return left;
+            if (isConstant(*left, 1.0f))   return right;
+            if (isConstant(*right, -1.0f)) return simplify(arena, makeUnaryNode(arena, MINUS_TOKEN, left));
+            if (isConstant(*left, -1.0f))  return simplify(arena, makeUnaryNode(arena, MINUS_TOKEN, right));
+            break;
+        case DIVIDE_TOKEN:
+            if (isConstant(*right, 1.0f)) return left;
+            break;
+        case EXP_TOKEN:
+            // pow(x, 0) and pow(1, y) are 1 even for NaN
+            if (isConstant(*right, 1.0f)) return left;
+            if (isConstant(*right, 0.0f) || isConstant(*left, 1.0f)) {
+                return makeConstantNode(arena, 1.0f);
+            }
+            break;
+        default:
+            break;
+    }
+
+    return node;
+}
+
+// Bottom-up rewrite: children first, then fold or apply an identity
+static Node* simplify(Arena& arena, Node* node) {
+    switch (node->getType()) {
+        case UNARY_NODE:  return simplifyUnary(arena, node);
+        case BINARY_NODE: return simplifyBinary(arena, node);
+        default:          return node;
+    }
+}
+
+int countNodes(const Node& node) {
+    switch (node.getType()) {
+        case UNARY_NODE:
+            return 1 + countNodes(static_cast<const UnaryOpNode&>(node).getOperand());
+        case BINARY_NODE: {
+            const auto& binary = static_cast<const BinaryOpNode&>(node);
+            return 1 + countNodes(binary.getLeft()) + countNodes(binary.getRight());
+        }
+        default:
+            return 1;
+    }
+}
+
+int optimizeAST(Node*& root, Arena& arena) {
+    if (!root) return 0;
+
+    int before = countNodes(*root);
+    root = simplify(arena, root);
+    return before - countNodes(*root);
+}
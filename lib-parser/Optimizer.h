@@ -0,0 +1,20 @@
+#ifndef _OPTIMIZER_H_
+#define _OPTIMIZER_H_
+
+#include "Node.h"
+
+// Simplify a parsed AST in place before it is compiled:
+//  - folds constant subtrees, e.g. (3+4)*x -> 7*x, 2*pi -> 6.2831855, sqrt(2)
+//  - applies identities that hold for every float input (inf, NaN and -0 included):
+//    x+(-0), (-0)+x, x-0, x*1, 1*x, x/1, x^1 -> x;  x^0, 1^x -> 1;
+//    (-0)-x, x*-1, -1*x -> -x;  --x -> x
+// x*0 is deliberately left alone since inf*0 and NaN*0 are NaN, and so are
+// x+0, 0+x and 0-x since they turn -0 into +0 (or +0 into -0 for 0-x).
+// New nodes are allocated in <arena>, which must be the one that holds the tree.
+// Returns the number of nodes removed from the tree.
+int optimizeAST(Node*& root, Arena& arena);
+
+// Total number of nodes in a tree
+int countNodes(const Node& node);
+
+#endif /* _OPTIMIZER_H_ */
@@ -1,6 +1,30 @@
 #include "Parser.h"
 #include <stack>
 #include <stdexcept>
+#include <charconv>
+#include <cstdlib>
+#include <type_traits>
+
+
+// Parse a NUMBER_TOKEN lexeme without copying it
+template <typename T>
+static T parseNumber(std::string_view lexeme) {
+    T value = 0;
+#if defined(__cpp_lib_to_chars)
+    auto result = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::runtime_error("Number out of range: " + std::string(lexeme));
+    }
+    if (result.ec != std::errc() || result.ptr != lexeme.data() + lexeme.size()) {
+        throw std::runtime_error("Invalid number: " + std::string(lexeme));
+    }
+#else
+    // Standard libraries without floating-point from_chars
+    if constexpr (std::is_same_v<T, float>) value = std::stof(std::string(lexeme));
+    else                                    value = std::stod(std::string(lexeme));
+#endif
+    return value;
+}
 
 
 bool isFunction(TokenType type) {
@@ -32,126 +56,134 @@ bool isFunction(TokenType type) {
 }
 
 void Parser::advance() {
-    currentToken = scanner.GetNextToken();
+    if (position + 1 < tokens->Size())
+        position++;
+    currentToken = tokens->At(position);
 }
     
-TokenClass Parser::peek() {
-    return scanner.PeekNextToken();
+TokenView Parser::peek(size_t distance) const {
+    return tokens->At(position + distance);
+}
+
+int Parser::currentLine() const {
+    return tokens->LineAt(position);
 }
     
 bool Parser::match(TokenType type) {
-    return currentToken.GetTokenType() == type;
+    return currentToken.type == type;
 }
     
 void Parser::expect(TokenType type, const std::string& message) {
     if (!match(type)) {
-        throw std::runtime_error(message + " at line " + std::to_string(scanner.GetLineNumber()));
+        throw std::runtime_error(message + " at line " + std::to_string(currentLine()));
     }
     advance();
 }
     
 // + and -
-std::unique_ptr<Node> Parser::parseAdditive() {
+Node* Parser::parseAdditive() {
     auto left = parseMultiplicative();
     
     while (match(PLUS_TOKEN) || match(MINUS_TOKEN)) {
-        TokenType op = currentToken.GetTokenType();
+        TokenType op = currentToken.type;
         advance();
         auto right = parseMultiplicative();
-        left = makeBinaryNode(op, std::move(left), std::move(right));
+        left = makeBinaryNode(arena, op, left, right);
     }
     
     return left;
 }
     
 // * and /
-std::unique_ptr<Node> Parser::parseMultiplicative() {
+Node* Parser::parseMultiplicative() {
     auto left = parseExponent();
     
     while (match(TIMES_TOKEN) || match(DIVIDE_TOKEN)) {
-        TokenType op = currentToken.GetTokenType();
+        TokenType op = currentToken.type;
         advance();
         auto right = parseExponent();
-        left = makeBinaryNode(op, std::move(left), std::move(right));
+        left = makeBinaryNode(arena, op, left, right);
     }
     
     return left;
 }
 
 // ^
-std::unique_ptr<Node> Parser::parseExponent() {
+Node* Parser::parseExponent() {
     auto left = parseUnary();
     
     if (match(EXP_TOKEN)) {
         advance();
         auto right = parseExponent();  // Right-associative: recurse on same level
-        left = makeBinaryNode(EXP_TOKEN, std::move(left), std::move(right));
+        left = makeBinaryNode(arena, EXP_TOKEN, left, right);
     }
     
     return left;
 }
 
 // unary minus
-std::unique_ptr<Node> Parser::parseUnary() {
+Node* Parser::parseUnary() {
     if (match(MINUS_TOKEN)) {
         advance();
         auto operand = parseUnary();
-        return makeUnaryNode(MINUS_TOKEN, std::move(operand));
+        return makeUnaryNode(arena, MINUS_TOKEN, operand);
     }
     
     return parsePostfix();
 }
 
 // !
-std::unique_ptr<Node> Parser::parsePostfix() {
+Node* Parser::parsePostfix() {
     auto operand = parsePrimary();
     
     while (match(FACTORIAL_TOKEN)) {
         advance();
-        operand = makeUnaryNode(FACTORIAL_TOKEN, std::move(operand));
+        operand = makeUnaryNode(arena, FACTORIAL_TOKEN, operand);
     }
     
     return operand;
 }
     
 // numbers, variables, constants, functions, parentheses
-std::unique_ptr<Node> Parser::parsePrimary() {
-    TokenType type = currentToken.GetTokenType();
+Node* Parser::parsePrimary() {
+    TokenType type = currentToken.type;
     
     // Number literal
     if (match(NUMBER_TOKEN)) {
-        float value = std::stof(currentToken.GetLexeme());
+        // Parsed at each precision, so neither is a rounded copy of the other
+        float value = parseNumber<float>(currentToken.lexeme);
+        double wideValue = parseNumber<double>(currentToken.lexeme);
         advance();
-        return std::make_unique<ConstantNode>(value);
+        return makeConstantNode(arena, value, wideValue);
     }
     
     // Variable
     if (match(VARIABLE_TOKEN)) {
-        std::string name = currentToken.GetLexeme();
+        Node* variable = makeVariableNode(arena, currentToken.lexeme);
         advance();
-        return std::make_unique<VariableNode>(name);
+        return variable;
     }
     
     // Constants
     if (match(PI_TOKEN)) {
         advance();
-        return std::make_unique<ConstantNode>(static_cast<float>(M_PI));
+        return makeConstantNode(arena, static_cast<float>(M_PI), M_PI);
     }
     if (match(EULER_TOKEN)) {
         advance();
-        return std::make_unique<ConstantNode>(static_cast<float>(M_E));
+        return makeConstantNode(arena, static_cast<float>(M_E), M_E);
     }
     if (match(PHI_TOKEN)) {
         advance();
-        return std::make_unique<ConstantNode>(static_cast<float>(M_PHI));
+        return makeConstantNode(arena, static_cast<float>(M_PHI), M_PHI);
     }
     if (match(INFINITY_TOKEN)) {
         advance();
-        return std::make_unique<ConstantNode>(std::numeric_limits<float>::infinity());
+        return makeConstantNode(arena, std::numeric_limits<float>::infinity());
     }
     if (match(NAN_TOKEN)) {
         advance();
-        return std::make_unique<ConstantNode>(std::numeric_limits<float>::quiet_NaN());
+        return makeConstantNode(arena, std::numeric_limits<float>::quiet_NaN());
     }
     
     // Functions
@@ -161,7 +193,7 @@ std::unique_ptr<Node> Parser::parsePrimary() {
         expect(LPAREN_TOKEN, "Expected '(' after function name");
         auto arg = parseAdditive();
         expect(RPAREN_TOKEN, "Expected ')' after function argument");
-        return makeUnaryNode(funcType, std::move(arg));
+        return makeUnaryNode(arena, funcType, arg);
     }
     
     // Parenthesized expression
@@ -177,33 +209,58 @@ std::unique_ptr<Node> Parser::parsePrimary() {
         advance();
         auto expr = parseAdditive();
         expect(PIPE_TOKEN, "Expected '|' to close absolute value");
-        return makeUnaryNode(ABS_TOKEN, std::move(expr));
+        return makeUnaryNode(arena, ABS_TOKEN, expr);
     }
     
-    throw std::runtime_error("Unexpected token: " + currentToken.GetLexeme() + 
-                                " at line " + std::to_string(scanner.GetLineNumber()));
+    throw std::runtime_error("Unexpected token: " + std::string(currentToken.lexeme) + 
+                                " at line " + std::to_string(currentLine()));
 }
     
-Parser::Parser(ScannerClass& sc) : scanner(sc), currentToken(EOF_TOKEN, "") {
-    advance();  // Load first token
+Parser::Parser(ScannerClass& sc, Arena& nodeArena) : arena(nodeArena), tokens(&ownedTokens), position(0) {
+    ownedTokens.Fill(sc);
+    currentToken = tokens->At(0);  // Load first token
+}
+
+Parser::Parser(const TokenBuffer& buffer, Arena& nodeArena) : arena(nodeArena), tokens(&buffer), position(0) {
+    currentToken = tokens->At(0);  // Load first token
 }
     
-std::unique_ptr<Node> Parser::parse() {
+Node* Parser::parse() {
     if (match(EOF_TOKEN)) {
         throw std::runtime_error("Empty expression");
     }
     
     auto ast = parseAdditive();
+
+    // F(x, y) = G(x, y) is plotted as the zero set of F - G
+    implicit = false;
+    if (match(EQUAL_TOKEN)) {
+        advance();
+        if (match(EOF_TOKEN)) {
+            throw std::runtime_error("Expected expression after '='");
+        }
+        ast = makeBinaryNode(arena, MINUS_TOKEN, ast, parseAdditive());
+        implicit = true;
+    }
     
     if (!match(EOF_TOKEN)) {
-        throw std::runtime_error("Unexpected token after expression: " + currentToken.GetLexeme());
+        throw std::runtime_error("Unexpected token after expression: " + std::string(currentToken.lexeme));
     }
     
     return ast;
 }
 
-std::unique_ptr<Node> parseToAST(const std::string& equation) {
-    ScannerClass scanner(equation, false);
-    Parser parser(scanner);
-    return parser.parse();
+Node* parseToAST(const std::string& equation, Arena& arena, bool* implicit) {
+    // Scan the caller's string in place
+    ScannerClass scanner(equation.data(), equation.data() + equation.size());
+
+    // Reused by every parse on this thread, so steady-state parsing
+    // doesn't allocate for tokens
+    static thread_local TokenBuffer buffer;
+    buffer.Fill(scanner);
+
+    Parser parser(buffer, arena);
+    Node* ast = parser.parse();
+    if (implicit) *implicit = parser.isImplicit();
+    return ast;
 }
@@ -7,36 +7,55 @@
 #include <config.h>
 #include <vector>
 #include <string>
-#include <memory>
 
 
 bool isFunction(TokenType type);
 
-std::unique_ptr<Node> parseToAST(const std::string& equation);
+// Parse <equation> into a tree allocated in <arena>. An equation
+// "lhs = rhs" comes back as lhs - rhs, with *implicit set if given.
+Node* parseToAST(const std::string& equation, Arena& arena, bool* implicit = nullptr);
 
 
 class Parser {
     private:
-        ScannerClass& scanner;
-        TokenClass currentToken;
+        Arena& arena;                   // receives every node
+        TokenBuffer ownedTokens;        // used by the ScannerClass constructor
+        const TokenBuffer* tokens;
+        size_t position;
+        TokenView currentToken;
+        bool implicit = false;          // parse() saw "lhs = rhs"
         
         void advance();
-        TokenClass peek();
+        // Token <distance> places after the current one, without advancing
+        TokenView peek(size_t distance = 1) const;
+        int currentLine() const;
         bool match(TokenType type);
         
         void expect(TokenType type, const std::string& message);
 
-        std::unique_ptr<Node> parseAdditive();
-        std::unique_ptr<Node> parseMultiplicative();
-        std::unique_ptr<Node> parseExponent();
-        std::unique_ptr<Node> parseUnary();
-        std::unique_ptr<Node> parsePostfix();
-        std::unique_ptr<Node> parsePrimary();
+        Node* parseAdditive();
+        Node* parseMultiplicative();
+        Node* parseExponent();
+        Node* parseUnary();
+        Node* parsePostfix();
+        Node* parsePrimary();
 
 
     public:
-        explicit Parser(ScannerClass& sc);
-        std::unique_ptr<Node> parse();
+        // Scan all of <sc> up front
+        Parser(ScannerClass& sc, Arena& nodeArena);
+        // Parse an already filled buffer. It must outlive the parser.
+        Parser(const TokenBuffer& buffer, Arena& nodeArena);
+
+        // <tokens> may point at ownedTokens
+        Parser(const Parser&) = delete;
+        Parser& operator=(const Parser&) = delete;
+
+        // expression | expression '=' expression
+        Node* parse();
+
+        // Whether the last parse() was of an equation
+        bool isImplicit() const { return implicit; }
 
 };
 
@@ -1,106 +1,127 @@
 #include "Scanner.h"
+#include <algorithm>
 
 ScannerClass::ScannerClass(const std::string& inputFileName, bool isFileName) {
     if (isFileName) {
-        input = new std::ifstream(inputFileName.c_str(), std::ios::binary);
-        ownsStream = true;
+        std::ifstream input(inputFileName.c_str(), std::ios::binary);
+        if (!input.good()) {
+            std::cerr << "Error opening input file " << inputFileName;
+            std::exit(1);
+        }
+        std::ostringstream contents;
+        contents << input.rdbuf();
+        ownedSource = contents.str();
     } else {
-        input = new std::istringstream(inputFileName);
-        ownsStream = true;
-    }
-    if (!input->good()) {
-        std::cerr << "Error opening input file " << inputFileName;
-        std::exit(1);
+        ownedSource = inputFileName;
     }
+    source = ownedSource;
+    cursor = 0;
+    newlineMark = 0;
+    splitEnd = 0;
     LineNumber = 1;
 }
 
-ScannerClass::~ScannerClass() {
-    if (ownsStream) {
-        delete input;
-    }
-}
+ScannerClass::ScannerClass(const char* begin, const char* end)
+    : source(begin, static_cast<size_t>(end - begin)), cursor(0), newlineMark(0), splitEnd(0), LineNumber(1) {}
+
+ScannerClass::~ScannerClass() {}
+
+TokenView ScannerClass::ScanToken() {
+    // The rest of an identifier being split is known to be letters only,
+    // so it is split further without running the machine over it again
+    if (cursor < splitEnd)
+        return SplitIdentifier();
 
-TokenClass ScannerClass::GetNextToken() {
     StateMachineClass stateMachine;
-    std::string lexeme;
     MachineState currentState;
     TokenType previousTokenType;
+    size_t start = cursor;
 
-    do
+    // Feed characters until the machine can't move. The character that
+    // stops it is not consumed; it starts the next token.
+    while (true)
     {
-        int c = input->get();
-        if (c == '\n') {
+        int c = (cursor < source.size()) ? static_cast<unsigned char>(source[cursor]) : EOF;
+        if (c == '\n' && cursor >= newlineMark) {
             LineNumber++;
+            newlineMark = cursor + 1;
         }
-        lexeme += c;
         currentState = stateMachine.UpdateState(c, previousTokenType);
+        if (currentState == CANTMOVE_STATE)
+            break;
+        if (c != EOF)
+            cursor++;
         if (currentState == START_STATE || currentState == ENDFILE_STATE)
-            lexeme = "";
-    } while (currentState != CANTMOVE_STATE);
+            start = cursor;
+    }
 
     if (previousTokenType == BAD_TOKEN)
     {
-        throw std::runtime_error("Error. BAD_TOKEN from lexeme " + lexeme + " at line " + std::to_string(LineNumber));
+        size_t end = std::min(cursor + 1, source.size());
+        throw std::runtime_error("Error. BAD_TOKEN from lexeme " + std::string(source.substr(start, end - start)) +
+                                 " at line " + std::to_string(LineNumber));
     }
 
-    lexeme.pop_back();
-    input->unget();
+    std::string_view lexeme = source.substr(start, cursor - start);
+    if (previousTokenType != VARIABLE_TOKEN && previousTokenType != IDENTIFIER_TOKEN)
+        return {previousTokenType, lexeme};
 
-    TokenClass token(previousTokenType, lexeme);
-    
-    // Handle multi-character identifiers that aren't reserved words
-    // These need to be split into individual variables or reserved word tokens
-    if (token.GetTokenType() == IDENTIFIER_TOKEN && lexeme.length() > 1) {
-        // Try to find the longest reserved word prefix
-        std::string reservedPrefix = "";
-        
-        for (size_t i = lexeme.length(); i >= 1; i--) {
-            std::string prefix = lexeme.substr(0, i);
-            TokenClass testToken(IDENTIFIER_TOKEN, prefix);
-            
-            // If the token type changed, this prefix is a reserved word
-            if (testToken.GetTokenType() != IDENTIFIER_TOKEN) {
-                reservedPrefix = prefix;
-                break;
-            }
-        }
-        
-        if (!reservedPrefix.empty()) {
-            // Found a reserved word prefix - put back the remaining characters
-            for (int i = lexeme.length() - 1; i >= (int)reservedPrefix.length(); i--) {
-                input->unget();
-                if (lexeme[i] == '\n') {
-                    LineNumber--;
-                }
-            }
-            return TokenClass(IDENTIFIER_TOKEN, reservedPrefix);
-        } else {
-            // No reserved word found - return first character as VARIABLE_TOKEN
-            for (int i = lexeme.length() - 1; i >= 1; i--) {
-                input->unget();
-                if (lexeme[i] == '\n') {
-                    LineNumber--;
-                }
-            }
-            return TokenClass(VARIABLE_TOKEN, lexeme.substr(0, 1));
-        }
-    }
+    splitEnd = cursor;
+    cursor = start;
+    return SplitIdentifier();
+}
 
-    return token;
+// One walk of the reserved word trie decides between a reserved word, a
+// reserved word prefix and a plain variable. Multi-character identifiers
+// that aren't reserved words are split into individual variables or
+// reserved word tokens, one per call, so a long identifier is scanned
+// once rather than once per piece.
+TokenView ScannerClass::SplitIdentifier() {
+    std::string_view lexeme = source.substr(cursor, splitEnd - cursor);
+    TokenType reservedType;
+    size_t prefixLength = MatchReservedPrefix(lexeme, reservedType);
+    if (prefixLength > 0) {
+        cursor += prefixLength;
+        return {reservedType, lexeme.substr(0, prefixLength)};
+    }
+    cursor += 1;
+    return {VARIABLE_TOKEN, lexeme.substr(0, 1)};
 }
 
-TokenClass ScannerClass::PeekNextToken() {
-    std::streampos oldPosition = input->tellg();
+TokenView ScannerClass::PeekToken() {
+    size_t oldCursor = cursor;
+    size_t oldMark = newlineMark;
+    size_t oldSplitEnd = splitEnd;
     int oldLine = LineNumber;
 
-    TokenClass token = GetNextToken();
+    TokenView token = ScanToken();
 
-    if(!input->good())      // if we triggered EOF, then seekg doesn't work,
-        input->clear();     // unless we first clear()
-
-    input->seekg(oldPosition);
+    cursor = oldCursor;
+    newlineMark = oldMark;
+    splitEnd = oldSplitEnd;
     LineNumber = oldLine;
     
     return token;
-}
\ No newline at end of file
+}
+
+TokenClass ScannerClass::GetNextToken() {
+    TokenView token = ScanToken();
+    return TokenClass(token.type, std::string(token.lexeme));
+}
+
+TokenClass ScannerClass::PeekNextToken() {
+    TokenView token = PeekToken();
+    return TokenClass(token.type, std::string(token.lexeme));
+}
+
+void TokenBuffer::Fill(ScannerClass& scanner) {
+    tokens.clear();
+    lines.clear();
+
+    TokenView token;
+    do {
+        token = scanner.ScanToken();
+        tokens.push_back(token);
+        lines.push_back(scanner.GetLineNumber());
+    } while (token.type != EOF_TOKEN);
+}
@@ -7,19 +7,65 @@
 #include <iostream>
 #include <cstdlib>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
+// Scans a character buffer with a cursor. Lexemes of the tokens returned by
+// ScanToken() are views into that buffer, so nothing is copied per token.
 class ScannerClass {
     private:
-        std::istream* input;
-        bool ownsStream;
+        std::string ownedSource;    // file contents / copied string, if any
+        std::string_view source;
+        size_t cursor;
+        size_t newlineMark;         // newlines before this offset are counted
+        size_t splitEnd;            // end of the identifier being split, if the cursor is inside one
         int LineNumber;
-    
+
+        // Next token of the identifier at the cursor, ending at splitEnd
+        TokenView SplitIdentifier();
+
     public:
+        // Scan a copy of <inputString>, or the contents of the file it names
         ScannerClass(const std::string& inputString, bool isFileName = false);
+        // Scan [begin, end) in place. The buffer must outlive the scanner.
+        ScannerClass(const char* begin, const char* end);
         ~ScannerClass();
+
+        // <source> may point into ownedSource
+        ScannerClass(const ScannerClass&) = delete;
+        ScannerClass& operator=(const ScannerClass&) = delete;
+
+        TokenView ScanToken();
+        TokenView PeekToken();
+
         TokenClass GetNextToken();
         TokenClass PeekNextToken();
         int GetLineNumber() const { return LineNumber; }
 };
 
-#endif /* _SCANNER_H */
\ No newline at end of file
+// Every token of a source, scanned once up front and indexed afterwards,
+// ending with EOF_TOKEN. Lexemes are views into the scanned buffer.
+// Fill() keeps the capacity of the previous fill, so reuse one buffer
+// across parses to avoid allocating per parse.
+class TokenBuffer {
+    private:
+        std::vector<TokenView> tokens;
+        std::vector<int> lines;     // scanner line number after each token
+
+    public:
+        // Scan <scanner> to the end. Throws like ScanToken() on bad input.
+        void Fill(ScannerClass& scanner);
+
+        size_t Size() const { return tokens.size(); }
+
+        // Indices past the end read the trailing EOF_TOKEN
+        const TokenView& At(size_t index) const {
+            return tokens[index < tokens.size() ? index : tokens.size() - 1];
+        }
+        int LineAt(size_t index) const {
+            return lines[index < lines.size() ? index : lines.size() - 1];
+        }
+};
+
+#endif /* _SCANNER_H */
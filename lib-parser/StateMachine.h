@@ -2,6 +2,7 @@
 #define _STATE_MACHINE_H_
 
 #include "Tokenizer.h"
+#include <cstdio>
 
 enum MachineState {
     START_STATE,                // 0
@@ -82,20 +83,192 @@ enum CharacterType{
     LAST_CHAR
 };
 
+// Transition data shared by every scanner, built at compile time
+struct TransitionTable {
+    // The matrix of legal moves:
+    MachineState LegalMoves[LAST_STATE][LAST_CHAR];
+
+    // Which end-machine-states correspond to which token types.
+    // non end states correspond to the BAD_TOKEN token type
+    TokenType CorrespondingTokenTypes[LAST_STATE];
+};
+
+// Character class of every byte value
+struct CharacterTable {
+    CharacterType Types[256];
+};
+
+constexpr TransitionTable BuildTransitionTable() {
+    TransitionTable table{};
+
+    // initialize all the LegalMoves to CANTMOVE_STATE
+    // -----------------------------------------------
+    for (int state = 0; state < LAST_STATE; state++) {
+        for (int charType = 0; charType < LAST_CHAR; ++charType) {
+            table.LegalMoves[state][charType] = CANTMOVE_STATE;
+        }
+    }
+
+    // Define legal transitions
+    // ------------------------
+    // Basic characters
+    table.LegalMoves[START_STATE][WHITESPACE_CHAR] = START_STATE;
+    table.LegalMoves[START_STATE][NEWLINE_CHAR] = START_STATE;
+    table.LegalMoves[START_STATE][LETTER_CHAR] = VARIABLE_STATE;
+    table.LegalMoves[START_STATE][DIGIT_CHAR] = NUMBER_STATE;
+
+    // Arithmetic characters
+    table.LegalMoves[START_STATE][PLUS_CHAR] = PLUS_STATE;
+    table.LegalMoves[START_STATE][MINUS_CHAR] = MINUS_STATE;
+    table.LegalMoves[START_STATE][TIMES_CHAR] = TIMES_STATE;
+    table.LegalMoves[START_STATE][DIVIDE_CHAR] = DIVIDE_STATE;
+    table.LegalMoves[START_STATE][CARET_CHAR] = CARET_STATE;
+    table.LegalMoves[START_STATE][UNDERSCORE_CHAR] = UNDERSCORE_STATE;
+    table.LegalMoves[START_STATE][PIPE_CHAR] = PIPE_STATE;
+    table.LegalMoves[START_STATE][EXCLAMATION_CHAR] = EXCLAMATION_STATE;
+
+    // Comparison characters
+    table.LegalMoves[START_STATE][EQUAL_CHAR] = EQUAL_STATE;
+    table.LegalMoves[START_STATE][LESS_CHAR] = LESS_STATE;
+    table.LegalMoves[START_STATE][GREATER_CHAR] = GREATER_STATE;
+
+    // Separator characters
+    table.LegalMoves[START_STATE][LPAREN_CHAR] = LPAREN_STATE;
+    table.LegalMoves[START_STATE][RPAREN_CHAR] = RPAREN_STATE;
+    table.LegalMoves[START_STATE][LCURLY_CHAR] = LCURLY_STATE;
+    table.LegalMoves[START_STATE][RCURLY_CHAR] = RCURLY_STATE;
+    table.LegalMoves[START_STATE][COMMA_CHAR] = COMMA_STATE;
+    table.LegalMoves[START_STATE][SEMICOLON_CHAR] = SEMICOLON_STATE;
+
+    // Two character comparison operators
+    table.LegalMoves[LESS_STATE][EQUAL_CHAR] = LESS_EQUAL_STATE;
+    table.LegalMoves[GREATER_STATE][EQUAL_CHAR] = GREATER_EQUAL_STATE;
+
+    // Looping States
+    table.LegalMoves[VARIABLE_STATE][LETTER_CHAR] = IDENTIFIER_STATE;
+    table.LegalMoves[IDENTIFIER_STATE][LETTER_CHAR] = IDENTIFIER_STATE;
+    // Number handling
+    table.LegalMoves[NUMBER_STATE][DIGIT_CHAR] = NUMBER_STATE;    // "123"
+    table.LegalMoves[NUMBER_STATE][DOT_CHAR] = NUMBER_DOT_STATE;  // "1."
+    table.LegalMoves[NUMBER_DOT_STATE][DIGIT_CHAR] = FLOAT_STATE; // "1.0", "1.2"
+    table.LegalMoves[DOT_STATE][DIGIT_CHAR] = FLOAT_STATE;        // ".5", ".1"
+    table.LegalMoves[FLOAT_STATE][DIGIT_CHAR] = FLOAT_STATE;      // "1.2123", "1.232321
+
+    // EOF State
+    table.LegalMoves[START_STATE][ENDFILE_CHAR] = ENDFILE_STATE;
+ 
+    // Initialize corresponding token types
+    // ------------------------------------
+    for (int i = 0; i < LAST_STATE; i++) {
+        table.CorrespondingTokenTypes[i] = BAD_TOKEN;
+    }
+    
+    table.CorrespondingTokenTypes[VARIABLE_STATE] = VARIABLE_TOKEN;
+    table.CorrespondingTokenTypes[IDENTIFIER_STATE] = IDENTIFIER_TOKEN;
+    table.CorrespondingTokenTypes[NUMBER_STATE] = NUMBER_TOKEN;
+    table.CorrespondingTokenTypes[FLOAT_STATE] = NUMBER_TOKEN;
+    
+    // Arithmetic token types
+    table.CorrespondingTokenTypes[PLUS_STATE] = PLUS_TOKEN;
+    table.CorrespondingTokenTypes[MINUS_STATE] = MINUS_TOKEN;
+    table.CorrespondingTokenTypes[TIMES_STATE] = TIMES_TOKEN;
+    table.CorrespondingTokenTypes[DIVIDE_STATE] = DIVIDE_TOKEN;
+    table.CorrespondingTokenTypes[CARET_STATE] = EXP_TOKEN;
+    table.CorrespondingTokenTypes[UNDERSCORE_STATE] = SUBSCRIPT_TOKEN;
+    table.CorrespondingTokenTypes[PIPE_STATE] = PIPE_TOKEN;
+    table.CorrespondingTokenTypes[EXCLAMATION_STATE] = FACTORIAL_TOKEN;
+    
+    // Comparison token types
+    table.CorrespondingTokenTypes[EQUAL_STATE] = EQUAL_TOKEN;
+    table.CorrespondingTokenTypes[LESS_STATE] = LESS_TOKEN;
+    table.CorrespondingTokenTypes[LESS_EQUAL_STATE] = LESSEQUAL_TOKEN;
+    table.CorrespondingTokenTypes[GREATER_STATE] = GREATER_TOKEN;
+    table.CorrespondingTokenTypes[GREATER_EQUAL_STATE] = GREATEREQUAL_TOKEN;
+    
+    // Separator token types
+    table.CorrespondingTokenTypes[LPAREN_STATE] = LPAREN_TOKEN;
+    table.CorrespondingTokenTypes[RPAREN_STATE] = RPAREN_TOKEN;
+    table.CorrespondingTokenTypes[LCURLY_STATE] = LCURLY_TOKEN;
+    table.CorrespondingTokenTypes[RCURLY_STATE] = RCURLY_TOKEN;
+    table.CorrespondingTokenTypes[COMMA_STATE] = COMMA_TOKEN;
+    table.CorrespondingTokenTypes[SEMICOLON_STATE] = SEMICOLON_TOKEN;
+    
+    table.CorrespondingTokenTypes[ENDFILE_STATE] = EOF_TOKEN;
+    table.CorrespondingTokenTypes[CANTMOVE_STATE] = BAD_TOKEN;
+    table.CorrespondingTokenTypes[START_STATE] = BAD_TOKEN;
+
+    return table;
+}
+
+// ASCII classification, same as isalpha/isdigit/isspace in the "C" locale
+constexpr CharacterTable BuildCharacterTable() {
+    CharacterTable table{};
+
+    for (int c = 0; c < 256; c++) {
+        table.Types[c] = BAD_CHAR;
+    }
+    for (int c = 'a'; c <= 'z'; c++) table.Types[c] = LETTER_CHAR;
+    for (int c = 'A'; c <= 'Z'; c++) table.Types[c] = LETTER_CHAR;
+    for (int c = '0'; c <= '9'; c++) table.Types[c] = DIGIT_CHAR;
+
+    table.Types['\n'] = NEWLINE_CHAR;
+    table.Types[' '] = WHITESPACE_CHAR;
+    table.Types['\t'] = WHITESPACE_CHAR;
+    table.Types['\v'] = WHITESPACE_CHAR;
+    table.Types['\f'] = WHITESPACE_CHAR;
+    table.Types['\r'] = WHITESPACE_CHAR;
+    table.Types['.'] = DOT_CHAR;
+    table.Types['+'] = PLUS_CHAR;
+    table.Types['-'] = MINUS_CHAR;
+    table.Types['*'] = TIMES_CHAR;
+    table.Types['/'] = DIVIDE_CHAR;
+    table.Types['^'] = CARET_CHAR;
+    table.Types['_'] = UNDERSCORE_CHAR;
+    table.Types['|'] = PIPE_CHAR;
+    table.Types['!'] = EXCLAMATION_CHAR;
+    table.Types['='] = EQUAL_CHAR;
+    table.Types['<'] = LESS_CHAR;
+    table.Types['>'] = GREATER_CHAR;
+    table.Types[';'] = SEMICOLON_CHAR;
+    table.Types['('] = LPAREN_CHAR;
+    table.Types[')'] = RPAREN_CHAR;
+    table.Types['{'] = LCURLY_CHAR;
+    table.Types['}'] = RCURLY_CHAR;
+    table.Types[','] = COMMA_CHAR;
+
+    return table;
+}
+
+inline constexpr TransitionTable gTransitionTable = BuildTransitionTable();
+inline constexpr CharacterTable gCharacterTable = BuildCharacterTable();
+
+static_assert(gTransitionTable.LegalMoves[NUMBER_DOT_STATE][DIGIT_CHAR] == FLOAT_STATE,
+              "Transition table was not built at compile time");
+static_assert(gCharacterTable.Types['x'] == LETTER_CHAR,
+              "Character table was not built at compile time");
+
+// Per-token state. Cheap to construct: the tables above are shared.
 class StateMachineClass {
     private:
         MachineState currentState;
-        
-        // The matrix of legal moves:
-        MachineState LegalMoves[LAST_STATE][LAST_CHAR];
-
-        // Which end-machine-states correspond to which token types.
-        // non end states correspond to the BAD_TOKEN token type
-        TokenType CorrespondingTokenTypes[LAST_STATE];
 
     public:
-        StateMachineClass();
-        MachineState UpdateState(int currentCharacter, TokenType &previousTokenType);
+        StateMachineClass() : currentState(START_STATE) {}
+
+        // <currentCharacter> is a byte value (0-255) or EOF
+        MachineState UpdateState(int currentCharacter, TokenType &previousTokenType) {
+            CharacterType charType = (currentCharacter == EOF)
+                ? ENDFILE_CHAR
+                : gCharacterTable.Types[currentCharacter & 0xFF];
+
+            // Update previous token type
+            previousTokenType = gTransitionTable.CorrespondingTokenTypes[currentState];
+
+            // Update state based on legal moves
+            currentState = gTransitionTable.LegalMoves[currentState][charType];
+
+            return currentState;
+        }
 };
 
 #endif /* _STATE_MACHINE_H_ */
\ No newline at end of file
@@ -2,12 +2,7 @@
 
 bool SymbolTable::Exists(const std::string & s) {
     // Check if <s> exists in the symbol table
-    for (const auto& var : Variables) {
-        if (var.Label == s) {
-            return true;
-        }
-    }
-    return false;
+    return GetIndex(s) != -1;
 }
 
 void SymbolTable::AddEntry(const std::string & s) {
@@ -16,15 +11,15 @@ void SymbolTable::AddEntry(const std::string & s) {
         std::cerr << "Error: Variable " << s << " already exists in the symbol table.";
         std::exit(1);
     }
-    Variables.push_back({s, 0}); // Initialize with value 0
+    Labels.push_back(s);
+    Values.push_back(0); // Initialize with value 0
 }
 
 float SymbolTable::GetValue(const std::string & s) {
     // Get the current value of variable <s>
-    for (const auto& var : Variables) {
-        if (var.Label == s) {
-            return var.Value;
-        }
+    int index = GetIndex(s);
+    if (index != -1) {
+        return Values[index];
     }
     std::cerr << "Error: Variable " << s << " does not exist in the symbol table.";
     std::exit(1);
@@ -32,27 +27,26 @@ float SymbolTable::GetValue(const std::string & s) {
 
 void SymbolTable::SetValue(const std::string & s, float v) {
     // Set variable <s> to the given value
-    for (auto& var : Variables) {
-        if (var.Label == s) {
-            var.Value = v;
-            return;
-        }
+    int index = GetIndex(s);
+    if (index != -1) {
+        Values[index] = v;
+        return;
     }
     std::cerr << "Error: Variable " << s << " does not exist in the symbol table.";
     std::exit(1);
 }
 
-int SymbolTable::GetIndex(const std::string & s) {
+int SymbolTable::GetIndex(const std::string & s) const {
     // Get the unique index of where variable <s> is
-    for (size_t i = 0; i < Variables.size(); ++i) {
-        if (Variables[i].Label == s) {
+    for (size_t i = 0; i < Labels.size(); ++i) {
+        if (Labels[i] == s) {
             return static_cast<int>(i);
         }
     }
     return -1; // Variable <s> is not there
 }
 
-size_t SymbolTable::GetCount() {
+size_t SymbolTable::GetCount() const {
     // Get the current number of variables in the symbol table
-    return Variables.size();
-}
\ No newline at end of file
+    return Labels.size();
+}
@@ -5,14 +5,14 @@
 #include <vector>
 #include <iostream>
 
+// Variables live in two parallel arrays: labels for lookup, values as a
+// flat frame that compiled expressions index directly. Entries are only
+// ever appended, so an index from GetIndex() stays valid for the life
+// of the table and can be used as a handle.
 class SymbolTable {
     private:
-        struct Variable {
-            std::string Label;
-            float Value;
-        };
-
-        std::vector<Variable> Variables;
+        std::vector<std::string> Labels;
+        std::vector<float> Values;
     public:
         SymbolTable() = default;
         ~SymbolTable() = default;
@@ -24,9 +24,18 @@ class SymbolTable {
         float GetValue(const std::string & s);
         void SetValue(const std::string & s, float v);
 
-        int GetIndex(const std::string & s);
+        // Handle based access, no string comparisons
+        float GetValue(int index) const { return Values[index]; }
+        void SetValue(int index, float v) { Values[index] = v; }
+
+        int GetIndex(const std::string & s) const;
+        const std::string& GetLabel(int index) const { return Labels[index]; }
+
+        // Flat value array, one float per entry in GetIndex() order
+        const float* GetFrame() const { return Values.data(); }
+        float* GetFrame() { return Values.data(); }
         
-        size_t GetCount();
+        size_t GetCount() const;
 };
 
-#endif /* _SYMBOL_Table_H_ */
\ No newline at end of file
+#endif /* _SYMBOL_Table_H_ */
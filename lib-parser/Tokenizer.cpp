@@ -1,56 +1,98 @@
 #include "Tokenizer.h"
+#include <cstdint>
 
-TokenClass::TokenClass(TokenType type, const std::string &lexeme)
-    : tokenType(type), tokenLexeme(lexeme) {
-        //Check for reserved words
-        if (lexeme == "pi"){
-            tokenType = PI_TOKEN;
-        } else if (lexeme == "e"){
-            tokenType = EULER_TOKEN;
-        } else if (lexeme == "phi"){
-            tokenType = PHI_TOKEN;
-        } else if (lexeme == "inf"){
-            tokenType = INFINITY_TOKEN;
-        } else if (lexeme == "nan"){
-            tokenType = NAN_TOKEN;
-        } else if (lexeme == "sin"){
-            tokenType = SIN_TOKEN;
-        } else if (lexeme == "cos"){
-            tokenType = COS_TOKEN;
-        } else if (lexeme == "tan"){
-            tokenType = TAN_TOKEN;
-        } else if (lexeme == "cot"){
-            tokenType = COT_TOKEN;
-        } else if (lexeme == "sec"){
-            tokenType = SEC_TOKEN;
-        } else if (lexeme == "csc"){
-            tokenType = CSC_TOKEN;
-        } else if (lexeme == "arcsin"){
-            tokenType = ARCSIN_TOKEN;
-        } else if (lexeme == "arccos"){
-            tokenType = ARCCOS_TOKEN;
-        } else if (lexeme == "arctan"){
-            tokenType = ARCTAN_TOKEN;
-        } else if (lexeme == "arccot"){
-            tokenType = ARCCOT_TOKEN;
-        } else if (lexeme == "arcsec"){
-            tokenType = ARCSEC_TOKEN;
-        } else if (lexeme == "arccsc"){
-            tokenType = ARCCSC_TOKEN;
-        } else if (lexeme == "log"){
-            tokenType = LOG_TOKEN;
-        } else if (lexeme == "ln"){
-            tokenType = LN_TOKEN;
-        } else if (lexeme == "sqrt"){
-            tokenType = SQRT_TOKEN;
-        } else if (lexeme == "abs"){
-            tokenType = ABS_TOKEN;
-        } else if (lexeme == "floor"){
-            tokenType = FLOOR_TOKEN;
-        } else if (lexeme == "ceil"){
-            tokenType = CEIL_TOKEN;
+// Reserved words
+// --------------
+// Adding a word here only grows the trie below; lookups stay bounded by
+// the length of the lexeme, not the number of reserved words.
+struct ReservedWord {
+    std::string_view word;
+    TokenType type;
+};
+
+static constexpr ReservedWord gReservedWords[] = {
+    {"pi", PI_TOKEN}, {"e", EULER_TOKEN}, {"phi", PHI_TOKEN},
+    {"inf", INFINITY_TOKEN}, {"nan", NAN_TOKEN},
+    {"sin", SIN_TOKEN}, {"cos", COS_TOKEN}, {"tan", TAN_TOKEN},
+    {"cot", COT_TOKEN}, {"sec", SEC_TOKEN}, {"csc", CSC_TOKEN},
+    {"arcsin", ARCSIN_TOKEN}, {"arccos", ARCCOS_TOKEN}, {"arctan", ARCTAN_TOKEN},
+    {"arccot", ARCCOT_TOKEN}, {"arcsec", ARCSEC_TOKEN}, {"arccsc", ARCCSC_TOKEN},
+    {"log", LOG_TOKEN}, {"ln", LN_TOKEN}, {"sqrt", SQRT_TOKEN},
+    {"abs", ABS_TOKEN}, {"floor", FLOOR_TOKEN}, {"ceil", CEIL_TOKEN},
+};
+
+// Upper bound on trie nodes: the root plus one per reserved word character
+static constexpr size_t MaxTrieNodes() {
+    size_t count = 1;
+    for (const ReservedWord& reserved : gReservedWords) {
+        count += reserved.word.size();
+    }
+    return count;
+}
+
+static constexpr size_t TRIE_NODES = MaxTrieNodes();
+static_assert(TRIE_NODES <= 256, "Reserved word trie no longer fits 8-bit node indices");
+
+// Static trie over lowercase letters. Node 0 is the root, which is never
+// anyone's child, so a 0 edge means "no reserved word continues here".
+struct ReservedWordTrie {
+    uint8_t Next[TRIE_NODES][26];
+    TokenType Accept[TRIE_NODES];   // BAD_TOKEN unless a reserved word ends here
+};
+
+static constexpr ReservedWordTrie BuildReservedWordTrie() {
+    ReservedWordTrie trie{};
+    size_t nodeCount = 1;
+
+    for (size_t i = 0; i < TRIE_NODES; i++) {
+        trie.Accept[i] = BAD_TOKEN;
+    }
+
+    for (const ReservedWord& reserved : gReservedWords) {
+        size_t node = 0;
+        for (char c : reserved.word) {
+            int letter = c - 'a';
+            if (trie.Next[node][letter] == 0) {
+                trie.Next[node][letter] = static_cast<uint8_t>(nodeCount++);
+            }
+            node = trie.Next[node][letter];
         }
+        trie.Accept[node] = reserved.type;
     }
+    return trie;
+}
+
+static constexpr ReservedWordTrie gReservedWordTrie = BuildReservedWordTrie();
+
+size_t MatchReservedPrefix(std::string_view text, TokenType &type) {
+    size_t node = 0;
+    size_t matched = 0;
+
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c < 'a' || c > 'z')
+            break;
+        node = gReservedWordTrie.Next[node][c - 'a'];
+        if (node == 0)
+            break;
+        if (gReservedWordTrie.Accept[node] != BAD_TOKEN) {
+            type = gReservedWordTrie.Accept[node];
+            matched = i + 1;
+        }
+    }
+    return matched;
+}
+
+TokenType ClassifyLexeme(TokenType tokenType, std::string_view lexeme) {
+    TokenType reservedType;
+    if (!lexeme.empty() && MatchReservedPrefix(lexeme, reservedType) == lexeme.size()) {
+        return reservedType;
+    }
+    return tokenType;
+}
+
+TokenClass::TokenClass(TokenType type, const std::string &lexeme)
+    : tokenType(ClassifyLexeme(type, lexeme)), tokenLexeme(lexeme) {}
 
 std::ostream & operator<<(std::ostream & out, const TokenClass & tc) {
     out << " Name=" << tc.GetTokenTypeName()
@@ -2,6 +2,7 @@
 #define _TOKENIZER_H_
 
 #include <string>
+#include <string_view>
 #include <ostream>
 
 enum TokenType {
@@ -75,6 +76,22 @@ const std::string gTokenTypeNames[] = {
 static_assert(sizeof(gTokenTypeNames)/sizeof(gTokenTypeNames[0]) == LAST_TOKEN,
               "TokenType enum and gTokenTypeNames array are out of sync!");
 
+// Reserved word lookup: returns the reserved word's token type if <lexeme>
+// is one, otherwise <type> unchanged.
+TokenType ClassifyLexeme(TokenType type, std::string_view lexeme);
+
+// Longest reserved word that <text> starts with, found in one pass.
+// Returns its length and sets <type>, or returns 0 and leaves <type> alone.
+size_t MatchReservedPrefix(std::string_view text, TokenType &type);
+
+// Lightweight token produced by ScannerClass::ScanToken().
+// The lexeme points into the scanner's source and is only valid while
+// that source is alive.
+struct TokenView {
+    TokenType type;
+    std::string_view lexeme;
+};
+
 class TokenClass {
     private:
         TokenType tokenType;
@@ -0,0 +1,214 @@
+#include "VectorOps.h"
+#include "Operations.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define VEC_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VEC_SSE2 1
+#endif
+
+#if defined(VEC_AVX) || defined(VEC_SSE2)
+    #define VEC_SIMD 1
+#endif
+
+// Width- and type-agnostic wrappers so each kernel is written once.
+// Lanes<T>::vec is the register type holding WIDTH values of T.
+template <typename T> struct Lanes;
+
+#if defined(VEC_AVX)
+template <> struct Lanes<float> {
+    using vec = __m256;
+    static constexpr size_t WIDTH = 8;
+    static vec load(const float* p)     { return _mm256_loadu_ps(p); }
+    static void store(float* p, vec v)  { _mm256_storeu_ps(p, v); }
+    static vec set(float v)             { return _mm256_set1_ps(v); }
+    static vec add(vec a, vec b)        { return _mm256_add_ps(a, b); }
+    static vec sub(vec a, vec b)        { return _mm256_sub_ps(a, b); }
+    static vec mul(vec a, vec b)        { return _mm256_mul_ps(a, b); }
+    static vec div(vec a, vec b)        { return _mm256_div_ps(a, b); }
+    static vec bitxor(vec a, vec b)     { return _mm256_xor_ps(a, b); }
+    static vec andnot(vec a, vec b)     { return _mm256_andnot_ps(a, b); }
+    static vec sqrt(vec a)              { return _mm256_sqrt_ps(a); }
+};
+
+template <> struct Lanes<double> {
+    using vec = __m256d;
+    static constexpr size_t WIDTH = 4;
+    static vec load(const double* p)    { return _mm256_loadu_pd(p); }
+    static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+    static vec set(double v)            { return _mm256_set1_pd(v); }
+    static vec add(vec a, vec b)        { return _mm256_add_pd(a, b); }
+    static vec sub(vec a, vec b)        { return _mm256_sub_pd(a, b); }
+    static vec mul(vec a, vec b)        { return _mm256_mul_pd(a, b); }
+    static vec div(vec a, vec b)        { return _mm256_div_pd(a, b); }
+    static vec bitxor(vec a, vec b)     { return _mm256_xor_pd(a, b); }
+    static vec andnot(vec a, vec b)     { return _mm256_andnot_pd(a, b); }
+    static vec sqrt(vec a)              { return _mm256_sqrt_pd(a); }
+};
+#elif defined(VEC_SSE2)
+template <> struct Lanes<float> {
+    using vec = __m128;
+    static constexpr size_t WIDTH = 4;
+    static vec load(const float* p)     { return _mm_loadu_ps(p); }
+    static void store(float* p, vec v)  { _mm_storeu_ps(p, v); }
+    static vec set(float v)             { return _mm_set1_ps(v); }
+    static vec add(vec a, vec b)        { return _mm_add_ps(a, b); }
+    static vec sub(vec a, vec b)        { return _mm_sub_ps(a, b); }
+    static vec mul(vec a, vec b)        { return _mm_mul_ps(a, b); }
+    static vec div(vec a, vec b)        { return _mm_div_ps(a, b); }
+    static vec bitxor(vec a, vec b)     { return _mm_xor_ps(a, b); }
+    static vec andnot(vec a, vec b)     { return _mm_andnot_ps(a, b); }
+    static vec sqrt(vec a)              { return _mm_sqrt_ps(a); }
+};
+
+template <> struct Lanes<double> {
+    using vec = __m128d;
+    static constexpr size_t WIDTH = 2;
+    static vec load(const double* p)    { return _mm_loadu_pd(p); }
+    static void store(double* p, vec v) { _mm_storeu_pd(p, v); }
+    static vec set(double v)            { return _mm_set1_pd(v); }
+    static vec add(vec a, vec b)        { return _mm_add_pd(a, b); }
+    static vec sub(vec a, vec b)        { return _mm_sub_pd(a, b); }
+    static vec mul(vec a, vec b)        { return _mm_mul_pd(a, b); }
+    static vec div(vec a, vec b)        { return _mm_div_pd(a, b); }
+    static vec bitxor(vec a, vec b)     { return _mm_xor_pd(a, b); }
+    static vec andnot(vec a, vec b)     { return _mm_andnot_pd(a, b); }
+    static vec sqrt(vec a)              { return _mm_sqrt_pd(a); }
+};
+#endif
+
+
+template <typename T>
+static inline void fillBlock(T* a, T value, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    typename L::vec v = L::set(value);
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, v);
+#endif
+    for (; i < n; ++i) a[i] = value;
+}
+
+void vec_fill(float* a, float value, size_t n)    { fillBlock(a, value, n); }
+void vec_fill(double* a, double value, size_t n)  { fillBlock(a, value, n); }
+
+// Binary kernels
+// --------------
+template <typename T>
+static inline void addBlock(T* a, const T* b, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, L::add(L::load(a + i), L::load(b + i)));
+#endif
+    for (; i < n; ++i) a[i] = op_add(a[i], b[i]);
+}
+
+template <typename T>
+static inline void subBlock(T* a, const T* b, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, L::sub(L::load(a + i), L::load(b + i)));
+#endif
+    for (; i < n; ++i) a[i] = op_sub(a[i], b[i]);
+}
+
+template <typename T>
+static inline void mulBlock(T* a, const T* b, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, L::mul(L::load(a + i), L::load(b + i)));
+#endif
+    for (; i < n; ++i) a[i] = op_mul(a[i], b[i]);
+}
+
+// op_div maps x/0 to +inf, -inf or NaN by the sign of x, ignoring the
+// sign of the zero. Adding +0 turns a -0 divisor into +0 (and leaves
+// everything else alone), after which IEEE division gives exactly that.
+template <typename T>
+static inline void divBlock(T* a, const T* b, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    typename L::vec zero = L::set(T(0));
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        typename L::vec divisor = L::add(L::load(b + i), zero);
+        L::store(a + i, L::div(L::load(a + i), divisor));
+    }
+#endif
+    for (; i < n; ++i) a[i] = op_div(a[i], b[i]);
+}
+
+// No vector pow in SSE/AVX; stays per lane
+template <typename T>
+static inline void powBlock(T* a, const T* b, size_t n) {
+    for (size_t i = 0; i < n; ++i) a[i] = op_pow(a[i], b[i]);
+}
+
+void vec_add(float* a, const float* b, size_t n)    { addBlock(a, b, n); }
+void vec_sub(float* a, const float* b, size_t n)    { subBlock(a, b, n); }
+void vec_mul(float* a, const float* b, size_t n)    { mulBlock(a, b, n); }
+void vec_div(float* a, const float* b, size_t n)    { divBlock(a, b, n); }
+void vec_pow(float* a, const float* b, size_t n)    { powBlock(a, b, n); }
+
+void vec_add(double* a, const double* b, size_t n)  { addBlock(a, b, n); }
+void vec_sub(double* a, const double* b, size_t n)  { subBlock(a, b, n); }
+void vec_mul(double* a, const double* b, size_t n)  { mulBlock(a, b, n); }
+void vec_div(double* a, const double* b, size_t n)  { divBlock(a, b, n); }
+void vec_pow(double* a, const double* b, size_t n)  { powBlock(a, b, n); }
+
+// Unary kernels
+// -------------
+template <typename T>
+static inline void negateBlock(T* a, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    typename L::vec sign = L::set(T(-0.0));
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, L::bitxor(L::load(a + i), sign));
+#endif
+    for (; i < n; ++i) a[i] = op_negate(a[i]);
+}
+
+template <typename T>
+static inline void absBlock(T* a, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    typename L::vec sign = L::set(T(-0.0));
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, L::andnot(sign, L::load(a + i)));
+#endif
+    for (; i < n; ++i) a[i] = op_abs(a[i]);
+}
+
+template <typename T>
+static inline void sqrtBlock(T* a, size_t n) {
+    size_t i = 0;
+#if defined(VEC_SIMD)
+    using L = Lanes<T>;
+    for (; i + L::WIDTH <= n; i += L::WIDTH) L::store(a + i, L::sqrt(L::load(a + i)));
+#endif
+    for (; i < n; ++i) a[i] = op_sqrt(a[i]);
+}
+
+void vec_negate(float* a, size_t n)     { negateBlock(a, n); }
+void vec_abs(float* a, size_t n)        { absBlock(a, n); }
+void vec_sqrt(float* a, size_t n)       { sqrtBlock(a, n); }
+
+void vec_negate(double* a, size_t n)    { negateBlock(a, n); }
+void vec_abs(double* a, size_t n)       { absBlock(a, n); }
+void vec_sqrt(double* a, size_t n)      { sqrtBlock(a, n); }
+
+const char* vec_isa() {
+#if defined(VEC_AVX)
+    return "AVX";
+#elif defined(VEC_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
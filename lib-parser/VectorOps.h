@@ -0,0 +1,39 @@
+#ifndef _VECTOR_OPS_H_
+#define _VECTOR_OPS_H_
+
+#include <cstddef>
+
+// Block kernels used by the batch interpreter.
+// Each kernel works in place on <a>: a[i] = op(a[i], b[i]) for i < n.
+// Built with AVX when the compiler targets it (PARSER_ENABLE_AVX2),
+// SSE2 on any other x86-64 build, plain loops elsewhere. Every path
+// returns results bit-identical to the scalar op_* functions.
+// The double overloads run half as many lanes per instruction.
+
+void vec_fill(float* a, float value, size_t n);
+void vec_fill(double* a, double value, size_t n);
+
+void vec_add(float* a, const float* b, size_t n);
+void vec_sub(float* a, const float* b, size_t n);
+void vec_mul(float* a, const float* b, size_t n);
+void vec_div(float* a, const float* b, size_t n);
+void vec_pow(float* a, const float* b, size_t n);
+
+void vec_add(double* a, const double* b, size_t n);
+void vec_sub(double* a, const double* b, size_t n);
+void vec_mul(double* a, const double* b, size_t n);
+void vec_div(double* a, const double* b, size_t n);
+void vec_pow(double* a, const double* b, size_t n);
+
+void vec_negate(float* a, size_t n);
+void vec_abs(float* a, size_t n);
+void vec_sqrt(float* a, size_t n);
+
+void vec_negate(double* a, size_t n);
+void vec_abs(double* a, size_t n);
+void vec_sqrt(double* a, size_t n);
+
+// Name of the instruction set the kernels were built for
+const char* vec_isa();
+
+#endif /* _VECTOR_OPS_H_ */
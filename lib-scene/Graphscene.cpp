@@ -12,32 +12,11 @@ GraphScene::GraphScene(GraphView initialView)
     initVAOnVBO(minorGridVAO, minorGridVBO);
     
     // Calculate adaptive spacing based on initial view
-    float viewRange = std::max(view.maxX - view.minX, view.maxY - view.minY);
+    double viewRange = std::max(view.maxX - view.minX, view.maxY - view.minY);
     gridSpacing = calculateAdaptiveSpacing(viewRange);
     
     // Generate initial grid
-    axisGridLines = generateAxisLines(view);
-    majorGridLines = generateMajorLines(view, gridSpacing);
-    minorGridLines = generateMinorLines(view, gridSpacing);
-    
-    // Upload grid data
-    // Axis
-    glBindBuffer(GL_ARRAY_BUFFER, axisVBO);
-    glBufferData(GL_ARRAY_BUFFER, axisGridLines.size() * sizeof(float),
-                 axisGridLines.data(), GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // Major Lines
-    glBindBuffer(GL_ARRAY_BUFFER, majorGridVBO);
-    glBufferData(GL_ARRAY_BUFFER, majorGridLines.size() * sizeof(float),
-                 majorGridLines.data(), GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // Minor Lines
-    glBindBuffer(GL_ARRAY_BUFFER, minorGridVBO);
-    glBufferData(GL_ARRAY_BUFFER, minorGridLines.size() * sizeof(float),
-                 minorGridLines.data(), GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    rebuildGrid();
 }
 
 // Destructor
@@ -93,121 +72,12 @@ void GraphScene::renderGrid(Shader& shader) {
 
 }
 
-// Calculate adaptive spacing based on view range
-float GraphScene::calculateAdaptiveSpacing(float viewRange) {
-    // Further test but about ~8-15 major grid lines visible at any zoom level
-    float idealSpacing = viewRange / 10.0f;
-    
-    // Sequence: ...0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100...
-    float power = std::floor(std::log10(idealSpacing));
-    float base = std::pow(10.0f, power);
-    float normalized = idealSpacing / base;  // Value between 1 and 10
-    
-    // Snap to nearest value in 1-2-5 sequence
-    float spacing;
-    if (normalized < 1.5f) {
-        spacing = base * 1.0f;       // Use 1
-    } else if (normalized < 3.5f) {
-        spacing = base * 2.0f;       // Use 2
-    } else if (normalized < 7.5f) {
-        spacing = base * 5.0f;       // Use 5
-    } else {
-        spacing = base * 10.0f;      // Use 10 (next decade)
-    }
-    
-    // Clamp to reasonable bounds
-    spacing = std::max(0.0001f, std::min(spacing, 10000.0f));
-    
-    return spacing;
-}
-
-// Generate grid lines
-std::vector<float> GraphScene::generateGridLines(GraphView view, GridConfig config) {
-    std::vector<float> vertices;
-    
-    // Precompute screen bounds
-    float glYMin = mapToScreen(view.minY, view.minY, view.maxY);
-    float glYMax = mapToScreen(view.maxY, view.minY, view.maxY);
-    float glXMin = mapToScreen(view.minX, view.minX, view.maxX);
-    float glXMax = mapToScreen(view.maxX, view.minX, view.maxX);
-    
-    // Axis-only mode (spacing = 0)
-    if (config.spacing == 0.0f) {
-        // Generate Y-axis (x = 0) if visible
-        if (view.minX <= 0.0f && view.maxX >= 0.0f) {
-            float glX = mapToScreen(0.0f, view.minX, view.maxX);
-            vertices.push_back(glX);      vertices.push_back(glYMin);   vertices.push_back(0.0f);
-            vertices.push_back(glX);      vertices.push_back(glYMax);   vertices.push_back(0.0f);
-        }
-        // Generate X-axis (y = 0) if visible
-        if (view.minY <= 0.0f && view.maxY >= 0.0f) {
-            float glY = mapToScreen(0.0f, view.minY, view.maxY);
-            vertices.push_back(glXMin);   vertices.push_back(glY);      vertices.push_back(0.0f);
-            vertices.push_back(glXMax);   vertices.push_back(glY);      vertices.push_back(0.0f);
-        }
-        return vertices;
-    }
-    
-    // Helper lambda to check if a value falls on a major line
-    auto isOnMajorLine = [&](float val) -> bool {
-        if (config.skipMajorSpacing <= 0.0f) return false;
-        float remainder = std::fmod(std::abs(val), config.skipMajorSpacing);
-        return (remainder < config.skipMajorSpacing * 0.001f) || 
-               (remainder > config.skipMajorSpacing * 0.999f);
-    };
-    
-    // Generate vertical lines
-    float startX = std::floor(view.minX / config.spacing) * config.spacing;
-    for (float x = startX; x <= view.maxX; x += config.spacing) {
-        // Skip axis lines
-        if (std::abs(x) < config.skipTolerance) continue;
-        // Skip major lines if configured
-        if (isOnMajorLine(x)) continue;
-        
-        float glX = mapToScreen(x, view.minX, view.maxX);
-        vertices.push_back(glX);      vertices.push_back(glYMin);   vertices.push_back(0.0f);
-        vertices.push_back(glX);      vertices.push_back(glYMax);   vertices.push_back(0.0f);
-    }
-    
-    // Generate horizontal lines
-    float startY = std::floor(view.minY / config.spacing) * config.spacing;
-    for (float y = startY; y <= view.maxY; y += config.spacing) {
-        // Skip axis lines
-        if (std::abs(y) < config.skipTolerance) continue;
-        // Skip major lines if configured
-        if (isOnMajorLine(y)) continue;
-        
-        float glY = mapToScreen(y, view.minY, view.maxY);
-        vertices.push_back(glXMin);   vertices.push_back(glY);      vertices.push_back(0.0f);
-        vertices.push_back(glXMax);   vertices.push_back(glY);      vertices.push_back(0.0f);
-    }
-    
-    return vertices;
-}
-
-std::vector<float> GraphScene::generateAxisLines(GraphView view) {
-    // Spacing=0 triggers axis-only generation
-    return generateGridLines(view, {0.0f, false, 0.0f, 0.0f});
-}
-
-std::vector<float> GraphScene::generateMajorLines(GraphView view, float spacing) {
-    // Skip axis
-    return generateGridLines(view, {spacing, true, spacing * 0.001f, 0.0f});
-}
-
-std::vector<float> GraphScene::generateMinorLines(GraphView view, float spacing) {
-    // Subdivide major spacing by 5, skip both axis and major lines
-    float minorSpacing = spacing / 5.0f;
-    return generateGridLines(view, {minorSpacing, true, minorSpacing * 0.001f, spacing});
-}
-
 // Add a new curve to the scene
 Curve2D* GraphScene::addCurve(const char* equation, float lineWidth, RenderColor color) {
     curves.push_back(std::make_unique<Curve2D>(equation, lineWidth, color));
     Curve2D* newCurve = curves.back().get();
     
-    newCurve->generate(view);
-    newCurve->upload();
+    newCurve->update(view);
     return newCurve;
 }
 
@@ -215,31 +85,43 @@ Curve2D* GraphScene::addCurve(const char* equation, float lineWidth, RenderColor
 void GraphScene::removeCurve(Curve2D* curve) {
     for (auto it = curves.begin(); it != curves.end(); ++it) {
         if (it->get() == curve) {
+            jobs.cancel(curve);
             curves.erase(it);
             break;
         }
     }
 }
 
-// Update view and regenerate all geometry
-void GraphScene::updateView(GraphView newView) {
-    view = newView;
-    
-    // Update all curves
-    for (auto& curve : curves) {
-        curve->update(view);
+// Add a new parametric curve (x(t), y(t)) to the scene
+ParametricCurve2D* GraphScene::addParametricCurve(const char* xEquation, const char* yEquation,
+                                                  double tMin, double tMax,
+                                                  float lineWidth, RenderColor color) {
+    parametricCurves.push_back(std::make_unique<ParametricCurve2D>(xEquation, yEquation, tMin, tMax, lineWidth, color));
+    ParametricCurve2D* newCurve = parametricCurves.back().get();
+
+    newCurve->update(view);
+    return newCurve;
+}
+
+// Remove a parametric curve from the scene
+void GraphScene::removeParametricCurve(ParametricCurve2D* curve) {
+    for (auto it = parametricCurves.begin(); it != parametricCurves.end(); ++it) {
+        if (it->get() == curve) {
+            jobs.cancel(curve);
+            parametricCurves.erase(it);
+            break;
+        }
     }
+}
+
+// Grid lines for the view and its margin, uploaded
+void GraphScene::rebuildGrid() {
+    gridView = padView(view, GEOMETRY_MARGIN);
+    axisGridLines = generateAxisLines(gridView);
+    majorGridLines = generateMajorLines(gridView, gridSpacing);
+    minorGridLines = generateMinorLines(gridView, gridSpacing);
     
-    // Recalculate adaptive spacing based on new view
-    float viewRange = std::max(view.maxX - view.minX, view.maxY - view.minY);
-    gridSpacing = calculateAdaptiveSpacing(viewRange);
-    
-    // Regenerate grid
-    axisGridLines = generateAxisLines(view);
-    majorGridLines = generateMajorLines(view, gridSpacing);
-    minorGridLines = generateMinorLines(view, gridSpacing);
-    
-    // Re-upload grid data
+    // Upload grid data
     // Axis
     glBindBuffer(GL_ARRAY_BUFFER, axisVBO);
     glBufferData(GL_ARRAY_BUFFER, axisGridLines.size() * sizeof(float),
@@ -259,8 +141,37 @@ void GraphScene::updateView(GraphView newView) {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+// Rebuild one curve whatever it covers; render() uploads it when it lands
+void GraphScene::rebuild(Line2D* curve) {
+    jobs.request(curve, view);
+}
+
+// Update view and regenerate whatever no longer covers it
+void GraphScene::updateView(GraphView newView) {
+    view = newView;
+    
+    // Curves whose geometry still covers the view just move with it in the
+    // vertex shader. The rest rebuild in the background; render() uploads
+    // them as they land. A newer view cancels the rebuild still running for
+    // an older one.
+    auto refresh = [this](Line2D* curve) {
+        if (curve->covers(view)) jobs.cancel(curve);
+        else jobs.request(curve, view);
+    };
+    for (auto& curve : curves) refresh(curve.get());
+    for (auto& curve : parametricCurves) refresh(curve.get());
+    
+    // The grid likewise, unless its spacing changes
+    double viewRange = std::max(view.maxX - view.minX, view.maxY - view.minY);
+    float spacing = calculateAdaptiveSpacing(viewRange);
+    if (spacing != gridSpacing || !containsView(gridView, view)) {
+        gridSpacing = spacing;
+        rebuildGrid();
+    }
+}
+
 // Pan the view by dx, dy in world coordinates
-void GraphScene::pan(float dx, float dy) {
+void GraphScene::pan(double dx, double dy) {
     GraphView newView = view;
     newView.minX += dx;
     newView.maxX += dx;
@@ -274,12 +185,12 @@ void GraphScene::zoom(float factor) {
     GraphView newView = view;
     
     // Calculate center point
-    float centerX = (view.minX + view.maxX) / 2.0f;
-    float centerY = (view.minY + view.maxY) / 2.0f;
+    double centerX = (view.minX + view.maxX) / 2.0;
+    double centerY = (view.minY + view.maxY) / 2.0;
     
     // Calculate half-widths
-    float halfWidth = (view.maxX - view.minX) / 2.0f;
-    float halfHeight = (view.maxY - view.minY) / 2.0f;
+    double halfWidth = (view.maxX - view.minX) / 2.0;
+    double halfHeight = (view.maxY - view.minY) / 2.0;
     
     // Apply zoom factor
     halfWidth *= factor;
@@ -295,7 +206,7 @@ void GraphScene::zoom(float factor) {
 }
 
 // Zoom the view by a factor, centered on a specific world coordinate
-void GraphScene::zoomAt(float worldX, float worldY, float factor) {
+void GraphScene::zoomAt(double worldX, double worldY, float factor) {
     GraphView newView = view;
 
     // Scale each edge relative to the focal point
@@ -307,21 +218,44 @@ void GraphScene::zoomAt(float worldX, float worldY, float factor) {
     updateView(newView);
 }
 
+// Move vertices built for <built> to where they belong in the current
+// view: NDC in one view is a per-axis scale and offset of NDC in another
+void GraphScene::setViewTransform(Shader& shader, const GraphView& built) {
+    double spanX = view.maxX - view.minX;
+    double spanY = view.maxY - view.minY;
+    shader.setVec4("viewTransform",
+                   static_cast<float>((built.maxX - built.minX) / spanX),
+                   static_cast<float>((built.maxY - built.minY) / spanY),
+                   static_cast<float>(((built.minX + built.maxX) - (view.minX + view.maxX)) / spanX),
+                   static_cast<float>(((built.minY + built.maxY) - (view.minY + view.maxY)) / spanY));
+}
+
+void GraphScene::renderCurve(Shader& shader, Line2D& curve) {
+    if (!curve.isVisible()) return;
+
+    setViewTransform(shader, curve.getBuiltView());
+    RenderColor color = curve.getColor();
+    shader.setVec3("color", color.red, color.green, color.blue);
+    curve.render();
+}
+
 // Render the entire scene (grid + all curves)
 void GraphScene::render(Shader& shader, float aspectRatio) {
+    // Upload whatever the background rebuilds finished since the last frame
+    for (Line2D* line : jobs.poll()) {
+        line->upload();
+    }
+
     shader.use();
     shader.setFloat("wAspect", aspectRatio);
 
     // Render grid
+    setViewTransform(shader, gridView);
     renderGrid(shader);
         
     // Render all curves
-    for (auto& curve : curves) {
-        if (!curve->isVisible()) continue;
-        RenderColor color = curve->getColor();
-        shader.setVec3("color", color.red, color.green, color.blue);
-        curve->render();
-    }
+    for (auto& curve : curves) renderCurve(shader, *curve);
+    for (auto& curve : parametricCurves) renderCurve(shader, *curve);
     
     glBindVertexArray(0);
 }
@@ -2,21 +2,19 @@
 #define _GRAPHSCENE_H_
 
 #include <Curve2d.h>
+#include <ParametricCurve2d.h>
+#include "GridGenerator.h"
+#include <GeometryJobs.h>
 #include <Shader.h>
 #include <vector>
 #include <memory>
 
-struct GridConfig {
-    float spacing;
-    bool skipAxis;          // Skip x=0 and y=0
-    float skipTolerance;
-    float skipMajorSpacing; // If > 0, also skip lines at major intervals (for minor lines)
-};
-
 class GraphScene { 
     private:
         GraphView view;
         std::vector<std::unique_ptr<Curve2D>> curves;
+        std::vector<std::unique_ptr<ParametricCurve2D>> parametricCurves;
+        GeometryJobs jobs;      // curves' geometry for view changes, built in the background
 
         // Grid resources
         std::vector<float> axisGridLines;
@@ -26,19 +24,16 @@ class GraphScene {
         unsigned int majorGridVAO, majorGridVBO;
         unsigned int minorGridVAO, minorGridVBO;
         float gridSpacing;
+        GraphView gridView;     // what the grid lines were built for: the view plus a margin
 
         // Internal methods
         void initVAOnVBO(unsigned int& VAO, unsigned int& VBO);
-        
-        // Grid Generation methods
-        float calculateAdaptiveSpacing(float viewRange);
-        std::vector<float> generateGridLines(GraphView view, GridConfig config);
-        std::vector<float> generateAxisLines(GraphView view);
-        std::vector<float> generateMajorLines(GraphView view, float spacing);
-        std::vector<float> generateMinorLines(GraphView view, float spacing);
+        void rebuildGrid();
 
         // For use in public GraphScene::render()
         void renderGrid(Shader& shader);
+        void renderCurve(Shader& shader, Line2D& curve);
+        void setViewTransform(Shader& shader, const GraphView& built);
 
     public:
         GraphScene(GraphView initialView);
@@ -47,13 +42,21 @@ class GraphScene {
         // Add or remove curves
         Curve2D* addCurve(const char* equation, float lineWidth = 2.0f, RenderColor color = {0.0f, 0.0f, 0.0f});
         void removeCurve(Curve2D* curve);
+        ParametricCurve2D* addParametricCurve(const char* xEquation, const char* yEquation, double tMin, double tMax,
+                                              float lineWidth = 2.0f, RenderColor color = {0.0f, 0.0f, 0.0f});
+        void removeParametricCurve(ParametricCurve2D* curve);
 
-        // View manipulation
+        // View manipulation. Returns at once: geometry that still covers the
+        // new view is only moved (a uniform), the grid is rebuilt right away
+        // otherwise, and curves keep their last geometry until the
+        // background rebuild lands in render().
         void updateView(GraphView newView);
-        void pan(float dx, float dy);
+        void pan(double dx, double dy);
         void zoom(float factor);
-        void zoomAt(float worldX, float worldY, float factor);
+        void zoomAt(double worldX, double worldY, float factor);
         void render(Shader& shader, float aspectRatio);
+        void rebuild(Line2D* curve);    // in the background for the current view, e.g. after an edit
+        bool isRebuilding() const { return jobs.isBusy(); }
 
         // Cleanup
         void cleanup();
@@ -66,6 +69,9 @@ class GraphScene {
         Curve2D* getCurve(size_t index) { return (index < curves.size()) ? curves[index].get() : nullptr; }
         const Curve2D* getCurve(size_t index) const { return (index < curves.size()) ? curves[index].get() : nullptr; }
 
+        size_t getParametricCurveCount() const { return parametricCurves.size(); }
+        ParametricCurve2D* getParametricCurve(size_t index) { return (index < parametricCurves.size()) ? parametricCurves[index].get() : nullptr; }
+
 };
 
 #endif /* _GRAPHSCENE_H_ */
\ No newline at end of file
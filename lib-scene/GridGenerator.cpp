@@ -0,0 +1,113 @@
+#include "GridGenerator.h"
+#include <algorithm>
+#include <cmath>
+
+// Calculate adaptive spacing based on view range
+float calculateAdaptiveSpacing(double viewRange) {
+    // Further test but about ~8-15 major grid lines visible at any zoom level
+    float idealSpacing = static_cast<float>(viewRange / 10.0);
+    
+    // Sequence: ...0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100...
+    float power = std::floor(std::log10(idealSpacing));
+    float base = std::pow(10.0f, power);
+    float normalized = idealSpacing / base;  // Value between 1 and 10
+    
+    // Snap to nearest value in 1-2-5 sequence
+    float spacing;
+    if (normalized < 1.5f) {
+        spacing = base * 1.0f;       // Use 1
+    } else if (normalized < 3.5f) {
+        spacing = base * 2.0f;       // Use 2
+    } else if (normalized < 7.5f) {
+        spacing = base * 5.0f;       // Use 5
+    } else {
+        spacing = base * 10.0f;      // Use 10 (next decade)
+    }
+    
+    // Clamp to reasonable bounds
+    spacing = std::max(0.0001f, std::min(spacing, 10000.0f));
+    
+    return spacing;
+}
+
+// Generate grid lines
+std::vector<float> generateGridLines(GraphView view, GridConfig config) {
+    std::vector<float> vertices;
+    const ScreenMap screen(view);
+    
+    // Precompute screen bounds
+    float glYMin = screen.y(view.minY);
+    float glYMax = screen.y(view.maxY);
+    float glXMin = screen.x(view.minX);
+    float glXMax = screen.x(view.maxX);
+    
+    // Axis-only mode (spacing = 0)
+    if (config.spacing == 0.0f) {
+        // Generate Y-axis (x = 0) if visible
+        if (view.minX <= 0.0 && view.maxX >= 0.0) {
+            float glX = screen.x(0.0);
+            vertices.push_back(glX);      vertices.push_back(glYMin);   vertices.push_back(0.0f);
+            vertices.push_back(glX);      vertices.push_back(glYMax);   vertices.push_back(0.0f);
+        }
+        // Generate X-axis (y = 0) if visible
+        if (view.minY <= 0.0 && view.maxY >= 0.0) {
+            float glY = screen.y(0.0);
+            vertices.push_back(glXMin);   vertices.push_back(glY);      vertices.push_back(0.0f);
+            vertices.push_back(glXMax);   vertices.push_back(glY);      vertices.push_back(0.0f);
+        }
+        return vertices;
+    }
+    
+    // Helper lambda to check if a value falls on a major line
+    auto isOnMajorLine = [&](double val) -> bool {
+        if (config.skipMajorSpacing <= 0.0f) return false;
+        double remainder = std::fmod(std::abs(val), static_cast<double>(config.skipMajorSpacing));
+        return (remainder < config.skipMajorSpacing * 0.001f) || 
+               (remainder > config.skipMajorSpacing * 0.999f);
+    };
+    
+    // Generate vertical lines. Stepped in double: far from the origin a
+    // float x would stop advancing once spacing drops below its ulp.
+    double startX = std::floor(view.minX / config.spacing) * config.spacing;
+    for (double x = startX; x <= view.maxX; x += config.spacing) {
+        // Skip axis lines
+        if (std::abs(x) < config.skipTolerance) continue;
+        // Skip major lines if configured
+        if (isOnMajorLine(x)) continue;
+        
+        float glX = screen.x(x);
+        vertices.push_back(glX);      vertices.push_back(glYMin);   vertices.push_back(0.0f);
+        vertices.push_back(glX);      vertices.push_back(glYMax);   vertices.push_back(0.0f);
+    }
+    
+    // Generate horizontal lines
+    double startY = std::floor(view.minY / config.spacing) * config.spacing;
+    for (double y = startY; y <= view.maxY; y += config.spacing) {
+        // Skip axis lines
+        if (std::abs(y) < config.skipTolerance) continue;
+        // Skip major lines if configured
+        if (isOnMajorLine(y)) continue;
+        
+        float glY = screen.y(y);
+        vertices.push_back(glXMin);   vertices.push_back(glY);      vertices.push_back(0.0f);
+        vertices.push_back(glXMax);   vertices.push_back(glY);      vertices.push_back(0.0f);
+    }
+    
+    return vertices;
+}
+
+std::vector<float> generateAxisLines(GraphView view) {
+    // Spacing=0 triggers axis-only generation
+    return generateGridLines(view, {0.0f, false, 0.0f, 0.0f});
+}
+
+std::vector<float> generateMajorLines(GraphView view, float spacing) {
+    // Skip axis
+    return generateGridLines(view, {spacing, true, spacing * 0.001f, 0.0f});
+}
+
+std::vector<float> generateMinorLines(GraphView view, float spacing) {
+    // Subdivide major spacing by 5, skip both axis and major lines
+    float minorSpacing = spacing / 5.0f;
+    return generateGridLines(view, {minorSpacing, true, minorSpacing * 0.001f, spacing});
+}
@@ -0,0 +1,25 @@
+#ifndef _GRID_GENERATOR_H_
+#define _GRID_GENERATOR_H_
+
+#include <assist.h>
+#include <vector>
+
+// Grid line vertices for a view, as GL_LINES pairs of screen-space
+// (x, y, 0) vertices. No GL calls: GraphScene uploads the results.
+
+struct GridConfig {
+    float spacing;
+    bool skipAxis;          // Skip x=0 and y=0
+    float skipTolerance;
+    float skipMajorSpacing; // If > 0, also skip lines at major intervals (for minor lines)
+};
+
+// Major line spacing on the 1-2-5 sequence, about 10 lines per <viewRange>
+float calculateAdaptiveSpacing(double viewRange);
+
+std::vector<float> generateGridLines(GraphView view, GridConfig config);
+std::vector<float> generateAxisLines(GraphView view);
+std::vector<float> generateMajorLines(GraphView view, float spacing);
+std::vector<float> generateMinorLines(GraphView view, float spacing);
+
+#endif /* _GRID_GENERATOR_H_ */
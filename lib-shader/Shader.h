@@ -25,6 +25,7 @@ class Shader{
         void setInt(const std::string &name, int value) const;   
         void setFloat(const std::string &name, float value) const;
         void setVec3(const std::string &name, float x, float y, float z) const;
+        void setVec4(const std::string &name, float x, float y, float z, float w) const;
         void setMat4(const std::string &name, const float* value) const;
 
     protected:
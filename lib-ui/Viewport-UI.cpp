@@ -1,6 +1,29 @@
 #include "Viewport-UI.h"
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <unordered_map>
+
+// Equation box of one listed curve. Edits build in the background
+// (see EquationEditor); the curve keeps its last good equation until
+// a new one is ready.
+struct EquationBox {
+    char text[256];
+    EquationEditor editor;
+    std::string error;      // why the text doesn't plot, if it doesn't
+
+    explicit EquationBox(const std::string& equation) : editor(equation) {
+        snprintf(text, sizeof(text), "%s", equation.c_str());
+    }
+};
+
+static std::unordered_map<const Curve2D*, std::unique_ptr<EquationBox>> equationBoxes;
+
+static EquationBox& getEquationBox(const Curve2D* curve) {
+    std::unique_ptr<EquationBox>& box = equationBoxes[curve];
+    if (!box) box = std::make_unique<EquationBox>(curve->getEquation());
+    return *box;
+}
 
 // ImGui window to display GraphViewport's FBO texture
 void GraphViewportWindow(bool* show, GraphViewport& viewport) {
@@ -40,8 +63,8 @@ void GraphViewportWindow(bool* show, GraphViewport& viewport) {
 
             // Convert to world coordinates
             GraphView& view = viewport.getScene().getView();
-            float worldX = view.minX + (mx / size.x) * (view.maxX - view.minX);
-            float worldY = view.maxY - (my / size.y) * (view.maxY - view.minY);
+            double worldX = view.minX + (mx / size.x) * (view.maxX - view.minX);
+            double worldY = view.maxY - (my / size.y) * (view.maxY - view.minY);
 
             // Scroll wheel → zoom at cursor position
             if (io.MouseWheel != 0.0f) {
@@ -52,8 +75,8 @@ void GraphViewportWindow(bool* show, GraphViewport& viewport) {
             // Left-drag → pan
             if (ImGui::IsMouseDragging(ImGuiMouseButton_Left)) {
                 ImVec2 delta = io.MouseDelta;
-                float dx = -delta.x / size.x * (view.maxX - view.minX);
-                float dy =  delta.y / size.y * (view.maxY - view.minY);
+                double dx = -delta.x / size.x * (view.maxX - view.minX);
+                double dy =  delta.y / size.y * (view.maxY - view.minY);
                 viewport.getScene().pan(dx, dy);
             }
         }
@@ -80,10 +103,10 @@ void GraphControlPanel(bool* show, GraphViewport& viewport,
     ImGui::SeparatorText("View Bounds");
 
     bool viewChanged = false;
-    viewChanged |= ImGui::DragFloat("Min X", &view.minX, 0.1f);
-    viewChanged |= ImGui::DragFloat("Max X", &view.maxX, 0.1f);
-    viewChanged |= ImGui::DragFloat("Min Y", &view.minY, 0.1f);
-    viewChanged |= ImGui::DragFloat("Max Y", &view.maxY, 0.1f);
+    viewChanged |= ImGui::DragScalar("Min X", ImGuiDataType_Double, &view.minX, 0.1f);
+    viewChanged |= ImGui::DragScalar("Max X", ImGuiDataType_Double, &view.maxX, 0.1f);
+    viewChanged |= ImGui::DragScalar("Min Y", ImGuiDataType_Double, &view.minY, 0.1f);
+    viewChanged |= ImGui::DragScalar("Max Y", ImGuiDataType_Double, &view.maxY, 0.1f);
 
     if (viewChanged) {
         scene.updateView(view);
@@ -135,10 +158,33 @@ void GraphControlPanel(bool* show, GraphViewport& viewport,
 
         ImGui::PushID(static_cast<int>(i));
 
+        // Swap in a finished build; its geometry follows in the background
+        EquationBox& box = getEquationBox(curve);
+        EquationResult result;
+        if (box.editor.poll(result)) {
+            if (result.error.empty()) {
+                logLines.push_back("[Graph] Changed curve: " + curve->getEquation() + " -> " + result.equation);
+                curve->applyEquation(std::move(result));
+                scene.rebuild(curve);
+                box.error.clear();
+            } else {
+                box.error = result.error;
+            }
+        }
+
+        // "###curve" keeps the header's state while its equation changes
         char label[128];
-        snprintf(label, sizeof(label), "%s", curve->getEquation().c_str());
+        snprintf(label, sizeof(label), "%s###curve", curve->getEquation().c_str());
 
         if (ImGui::CollapsingHeader(label, ImGuiTreeNodeFlags_DefaultOpen)) {
+            if (ImGui::InputText("Equation", box.text, sizeof(box.text))) {
+                box.editor.edit(box.text);
+            }
+            if (!box.error.empty()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", box.error.c_str());
+            }
+            ImGui::TextDisabled("Geometry: %.2f ms", curve->getBuildTime());
+
             if (state->showAdvancedSettings) {
 
                 // Color picker
@@ -228,6 +274,7 @@ void GraphControlPanel(bool* show, GraphViewport& viewport,
         Curve2D* curve = scene.getCurve(static_cast<size_t>(removeIndex));
         if (curve) {
             logLines.push_back("[Graph] Removed curve: " + curve->getEquation());
+            equationBoxes.erase(curve);
             scene.removeCurve(curve);
         }
     }
@@ -82,10 +82,10 @@ int main() {
     // Set up mouse controls
     // ----------------------
     MouseController mouse(window, &scene.getView());
-    mouse.setPanCallback([&scene](float dx, float dy) {
+    mouse.setPanCallback([&scene](double dx, double dy) {
         scene.pan(dx, dy);
     });
-    mouse.setZoomAtCallback([&scene](float worldX, float worldY, float factor) {
+    mouse.setZoomAtCallback([&scene](double worldX, double worldY, float factor) {
         scene.zoomAt(worldX, worldY, factor);
     });
     mouse.install();
@@ -5,13 +5,19 @@ layout (location = 0) in vec3 aPos; // the position variable has attribute posit
 out vec3 vertexColor; // specify a color output to the fragment shader
 uniform float wAspect;
 uniform vec3 color;
+// xy scale, zw offset: from the view the vertices were built for (the view
+// at the time plus a margin) to the current one. Pans within the margin
+// only change this.
+uniform vec4 viewTransform;
 
 void main()
 {
+   vec2 ndc = aPos.xy * viewTransform.xy + viewTransform.zw;
+
    // Correct aspect ratio for both landscape and portrait orientations
    vec2 pos = wAspect > 1.0 
-       ? vec2(aPos.x, aPos.y * wAspect)        // Landscape: stretch Y
-       : vec2(aPos.x / wAspect, aPos.y);       // Portrait: stretch X
+       ? vec2(ndc.x, ndc.y * wAspect)          // Landscape: stretch Y
+       : vec2(ndc.x / wAspect, ndc.y);         // Portrait: stretch X
 
    gl_Position = vec4(pos, aPos.z, 1.0);
    vertexColor = color;
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <ThreadPool.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Test fixture for ThreadPool, on a pool of its own: the global one may
+// have no workers at all on a single-core machine
+class ThreadPoolTest : public ::testing::Test {
+protected:
+    ThreadPool pool{4};
+};
+
+TEST_F(ThreadPoolTest, VisitsEveryIndexOnce) {
+    for (size_t count : {1u, 2u, 7u, 1000u, 100000u}) {
+        std::vector<std::atomic<int>> visits(count);
+        pool.parallelFor(count, [&](size_t i) { ++visits[i]; });
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(visits[i], 1) << "index " << i << " of " << count;
+        }
+    }
+}
+
+TEST_F(ThreadPoolTest, SpreadsOverWorkers) {
+    // Each body waits until another thread has joined in, so a serial
+    // loop would never get past the first index
+    std::mutex lock;
+    std::condition_variable joined;
+    std::vector<std::thread::id> threads;
+
+    pool.parallelFor(2, [&](size_t) {
+        std::unique_lock<std::mutex> guard(lock);
+        threads.push_back(std::this_thread::get_id());
+        joined.notify_all();
+        joined.wait_for(guard, std::chrono::seconds(10), [&] { return threads.size() == 2; });
+    });
+    ASSERT_EQ(threads.size(), 2u);
+    EXPECT_NE(threads[0], threads[1]);
+}
+
+TEST_F(ThreadPoolTest, RethrowsTheFirstErrorAfterDraining) {
+    const size_t count = 1000;
+    std::atomic<size_t> ran{0};
+    try {
+        pool.parallelFor(count, [&](size_t i) {
+            ++ran;
+            if (i % 100 == 7) throw std::runtime_error("index " + std::to_string(i));
+        });
+        FAIL() << "parallelFor() swallowed the error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("index ", 0), 0u);
+    }
+    // Every body ran before the error came back
+    EXPECT_EQ(ran, count);
+
+    // And the pool still works
+    std::atomic<size_t> after{0};
+    pool.parallelFor(count, [&](size_t) { ++after; });
+    EXPECT_EQ(after, count);
+}
+
+TEST_F(ThreadPoolTest, NestedLoopsRunSerially) {
+    const size_t outer = 16;
+    const size_t inner = 64;
+    std::vector<std::atomic<int>> visits(outer * inner);
+
+    pool.parallelFor(outer, [&](size_t i) {
+        std::thread::id self = std::this_thread::get_id();
+        pool.parallelFor(inner, [&](size_t j) {
+            EXPECT_EQ(std::this_thread::get_id(), self);
+            ++visits[i * inner + j];
+        });
+    });
+    for (size_t k = 0; k < visits.size(); ++k) {
+        ASSERT_EQ(visits[k], 1) << "index " << k;
+    }
+}
+
+TEST_F(ThreadPoolTest, TasksSubmitTasks) {
+    std::mutex lock;
+    std::condition_variable done;
+    int finished = 0;
+
+    auto finish = [&] {
+        std::lock_guard<std::mutex> guard(lock);
+        ++finished;
+        done.notify_all();
+    };
+    pool.submit([&] {
+        // A task may run loops of its own, and queue more tasks
+        std::atomic<size_t> visited{0};
+        pool.parallelFor(100, [&](size_t) { ++visited; });
+        EXPECT_EQ(visited, 100u);
+        pool.submit(finish);
+        finish();
+    });
+
+    std::unique_lock<std::mutex> guard(lock);
+    EXPECT_TRUE(done.wait_for(guard, std::chrono::seconds(10), [&] { return finished == 2; }));
+}
+
+TEST_F(ThreadPoolTest, WithoutWorkersEverythingRunsHere) {
+    ThreadPool empty(0);
+    std::thread::id self = std::this_thread::get_id();
+
+    std::vector<size_t> order;
+    empty.parallelFor(5, [&](size_t i) {
+        EXPECT_EQ(std::this_thread::get_id(), self);
+        order.push_back(i);
+    });
+    EXPECT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4}));
+
+    bool ran = false;
+    empty.submit([&] { ran = true; });
+    EXPECT_TRUE(ran);
+}
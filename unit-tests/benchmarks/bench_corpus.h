@@ -0,0 +1,17 @@
+#ifndef _BENCH_CORPUS_H_
+#define _BENCH_CORPUS_H_
+
+// Real equations, one per family, shared by the parser and tessellation
+// benchmarks so their numbers line up. Keep the order stable: results
+// are tracked across releases by index.
+static const char* kCorpus[] = {
+    "x^3 - 2*x^2 + x - 5",                      // polynomial
+    "sin(x)*cos(2*x) + 0.5",                    // trig
+    "tan(x)",                                   // poles
+    "e^(1/x)",                                  // essential singularity
+    "sqrt(|x|) * ln(x^2 + 1) / (1 + x^2)",      // mixed
+    "sin(cos(tan(x^2)))",                       // nested functions
+};
+static const int kCorpusSize = sizeof(kCorpus) / sizeof(kCorpus[0]);
+
+#endif /* _BENCH_CORPUS_H_ */
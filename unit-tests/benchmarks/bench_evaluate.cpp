@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+#include "Expression.h"
+#include "SymbolTable.h"
+#include "Jit.h"
+#include <vector>
+
+// Expressions typical of what users plot
+static const char* kEquations[] = {
+    "x^3 - 2*x^2 + x - 5",
+    "sin(x)*cos(2*x) + 0.5",
+    "e^(1/x)",
+    "sqrt(|x|) * ln(x^2 + 1) / (1 + x^2)",
+};
+
+// Parse, optimize and compile: what one keystroke in an equation box costs
+// before tessellation
+static void BM_ParseEquation(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Expression::parse(kEquations[state.range(0)]));
+    }
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_ParseEquation)->DenseRange(0, 3);
+
+// Walk the AST (virtual call + function pointer per node)
+static void BM_EvaluateTree(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+
+    float x = -10.0f;
+    for (auto _ : state) {
+        symbols.SetValue("x", x);
+        benchmark::DoNotOptimize(expr.evaluateTree(symbols));
+        x = (x < 10.0f) ? x + 0.001f : -10.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_EvaluateTree)->DenseRange(0, 3);
+
+// Run the compiled bytecode, looking variables up by name
+static void BM_EvaluateCompiled(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+
+    float x = -10.0f;
+    for (auto _ : state) {
+        symbols.SetValue("x", x);
+        benchmark::DoNotOptimize(expr.evaluate(symbols));
+        x = (x < 10.0f) ? x + 0.001f : -10.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_EvaluateCompiled)->DenseRange(0, 3);
+
+// Run the compiled bytecode on a bound frame (no string lookups)
+static void BM_EvaluateBound(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+    const int xSlot = symbols.GetIndex("x");
+
+    float x = -10.0f;
+    for (auto _ : state) {
+        symbols.SetValue(xSlot, x);
+        benchmark::DoNotOptimize(expr.evaluate(symbols.GetFrame()));
+        x = (x < 10.0f) ? x + 0.001f : -10.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_EvaluateBound)->DenseRange(0, 3);
+
+// Native code from the JIT (interpreter where unsupported)
+static void BM_EvaluateJit(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+    const int xSlot = symbols.GetIndex("x");
+    JitProgram jit = JitProgram::compile(expr.getProgram());
+
+    float x = -10.0f;
+    for (auto _ : state) {
+        symbols.SetValue(xSlot, x);
+        benchmark::DoNotOptimize(jit.run(symbols.GetFrame()));
+        x = (x < 10.0f) ? x + 0.001f : -10.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(std::string(kEquations[state.range(0)]) + (jit.isNative() ? "" : " (interpreted)"));
+}
+BENCHMARK(BM_EvaluateJit)->DenseRange(0, 3);
+
+// 1024 x values per call: batch interpreter vs. JIT batch loop
+static std::vector<float> makeXs() {
+    std::vector<float> xs(1024);
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = -10.0f + 20.0f * i / xs.size();
+    return xs;
+}
+
+static void BM_EvaluateBatch(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+    std::vector<float> xs = makeXs(), ys(xs.size());
+
+    for (auto _ : state) {
+        expr.evaluateBatch(symbols.GetFrame(), symbols.GetIndex("x"), xs.data(), ys.data(), xs.size());
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_EvaluateBatch)->DenseRange(0, 3);
+
+// Batch interpreter with the vector transcendental kernels
+static void BM_EvaluateBatchFast(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    expr.setMathMode(FAST_MATH);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+    std::vector<float> xs = makeXs(), ys(xs.size());
+
+    for (auto _ : state) {
+        expr.evaluateBatch(symbols.GetFrame(), symbols.GetIndex("x"), xs.data(), ys.data(), xs.size());
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_EvaluateBatchFast)->DenseRange(0, 3);
+
+// One transcendental over 1024 lanes: libm vs. FastMath kernel
+static const char* kFunctions[] = { "sin(x)", "e^x", "ln(x)", "x^x" };
+
+static void BM_Transcendental(benchmark::State& state) {
+    Expression expr = Expression::parse(kFunctions[state.range(0)]);
+    expr.setMathMode(state.range(1) ? FAST_MATH : EXACT_MATH);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+    std::vector<float> xs(1024), ys(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = 0.01f + 10.0f * i / xs.size();
+
+    for (auto _ : state) {
+        expr.evaluateBatch(symbols.GetFrame(), symbols.GetIndex("x"), xs.data(), ys.data(), xs.size());
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+    state.SetLabel(std::string(kFunctions[state.range(0)]) + (state.range(1) ? " fast " : " exact ") + fast_isa());
+}
+BENCHMARK(BM_Transcendental)->ArgsProduct({{0, 1, 2, 3}, {0, 1}});
+
+static void BM_EvaluateJitBatch(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+    JitProgram jit = JitProgram::compile(expr.getProgram(), static_cast<uint32_t>(symbols.GetIndex("x")));
+    std::vector<float> xs = makeXs(), ys(xs.size());
+
+    for (auto _ : state) {
+        jit.runBatch(symbols.GetFrame(), xs.data(), ys.data(), xs.size());
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_EvaluateJitBatch)->DenseRange(0, 3);
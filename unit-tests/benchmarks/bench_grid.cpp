@@ -0,0 +1,27 @@
+#include <benchmark/benchmark.h>
+#include "GridGenerator.h"
+
+// Axis, major and minor lines for one view, as GraphScene::updateView()
+// builds them on every pan and zoom. Arg is the view's half-width; the
+// last one is far from the origin.
+static void BM_GenerateGrid(benchmark::State& state) {
+    double halfWidth = static_cast<double>(state.range(0));
+    double center = state.range(1) ? 1.0e6 : 0.0;
+    GraphView view;
+    view.minX = center - halfWidth;
+    view.maxX = center + halfWidth;
+    view.minY = -halfWidth;
+    view.maxY = halfWidth;
+
+    size_t vertices = 0;
+    for (auto _ : state) {
+        float spacing = calculateAdaptiveSpacing(2.0 * halfWidth);
+        std::vector<float> axis = generateAxisLines(view);
+        std::vector<float> major = generateMajorLines(view, spacing);
+        std::vector<float> minor = generateMinorLines(view, spacing);
+        vertices = (axis.size() + major.size() + minor.size()) / 3;
+        benchmark::DoNotOptimize(minor.data());
+    }
+    state.counters["vertices"] = static_cast<double>(vertices);
+}
+BENCHMARK(BM_GenerateGrid)->ArgsProduct({{1, 10, 1000}, {0, 1}});
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include "bench_corpus.h"
+#include "Parser.h"
+#include "Arena.h"
+#include "Expression.h"
+#include <string>
+#include <vector>
+
+// Scan and parse into a fresh arena; no optimizing or compiling
+static void BM_ParseToAST(benchmark::State& state) {
+    const std::string equation = kCorpus[state.range(0)];
+    for (auto _ : state) {
+        Arena arena;
+        benchmark::DoNotOptimize(parseToAST(equation, arena));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * equation.size()));
+    state.SetLabel(equation);
+}
+BENCHMARK(BM_ParseToAST)->DenseRange(0, kCorpusSize - 1);
+
+// A saved session: 1,000 curves cycling through the corpus with their own
+// coefficients, so no two equations are the same
+static std::vector<std::string> makeSession() {
+    std::vector<std::string> equations;
+    for (int i = 0; i < 1000; ++i) {
+        equations.push_back(std::to_string(1 + i / kCorpusSize) + "*(" + kCorpus[i % kCorpusSize] + ")");
+    }
+    return equations;
+}
+
+// Restore a session from equation text: scan, parse, optimize, compile
+static void BM_SessionParse(benchmark::State& state) {
+    const std::vector<std::string> equations = makeSession();
+    for (auto _ : state) {
+        for (const std::string& equation : equations) {
+            benchmark::DoNotOptimize(Expression::parse(equation));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * equations.size()));
+}
+BENCHMARK(BM_SessionParse)->Unit(benchmark::kMillisecond);
+
+// Restore the same session from Expression::serialize() blobs
+static void BM_SessionLoad(benchmark::State& state) {
+    std::vector<std::vector<uint8_t>> blobs;
+    size_t bytes = 0;
+    for (const std::string& equation : makeSession()) {
+        blobs.push_back(Expression::parse(equation).serialize());
+        bytes += blobs.back().size();
+    }
+
+    for (auto _ : state) {
+        for (const std::vector<uint8_t>& blob : blobs) {
+            benchmark::DoNotOptimize(Expression::deserialize(blob.data(), blob.size()));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blobs.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_SessionLoad)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include "Scanner.h"
+#include <string>
+
+// A few kilobytes of typical input, repeated so one run covers every token kind
+static std::string makeSource(size_t bytes) {
+    static const char* kLines[] = {
+        "x^3 - 2*x^2 + x - 5\n",
+        "sin(x)*cos(2*x) + 0.5\n",
+        "sqrt(|x|) * ln(x^2 + 1) / (1 + x^2)\n",
+        "arctan(3.14159 * x) - e^(1/x) + 12!\n",
+        "y <= floor(x) ; y >= ceil(x) , {x_1 = 0.25}\n",
+    };
+
+    std::string source;
+    for (size_t i = 0; source.size() < bytes; ++i) {
+        source += kLines[i % (sizeof(kLines) / sizeof(kLines[0]))];
+    }
+    return source;
+}
+
+// Tokenize the whole buffer; reports bytes/s (MB/s in the console output)
+static void BM_ScanTokens(benchmark::State& state) {
+    std::string source = makeSource(static_cast<size_t>(state.range(0)));
+    size_t tokens = 0;
+
+    for (auto _ : state) {
+        ScannerClass scanner(source.data(), source.data() + source.size());
+        while (scanner.ScanToken().type != EOF_TOKEN) {
+            ++tokens;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(tokens));
+}
+BENCHMARK(BM_ScanTokens)->Arg(1 << 10)->Arg(1 << 16);
+
+// Same through GetNextToken(), which copies each lexeme into a TokenClass
+static void BM_GetNextToken(benchmark::State& state) {
+    std::string source = makeSource(static_cast<size_t>(state.range(0)));
+    size_t tokens = 0;
+
+    for (auto _ : state) {
+        ScannerClass scanner(source.data(), source.data() + source.size());
+        while (scanner.GetNextToken().GetTokenType() != EOF_TOKEN) {
+            ++tokens;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(tokens));
+}
+BENCHMARK(BM_GetNextToken)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,262 @@
+#include <benchmark/benchmark.h>
+#include "bench_corpus.h"
+#include "Expression.h"
+#include "VertexGenerator.h"
+#include "ImplicitGenerator.h"
+#include "ParametricGenerator.h"
+#include "Curve2d.h"
+#include <ThreadPool.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Smooth, steep, oscillating and singular curves
+static const char* kCurves[] = {
+    "sin(x)",
+    "x^3 - 2*x",
+    "tan(x)",
+    "e^(1/x)",
+    "sin(10*x)*x",
+    "sqrt(4 - x^2)",
+};
+
+// Tessellate with each error metric. The counters are per run:
+// evaluations/vertex is the number the derivative metric brings down.
+static void tessellate(benchmark::State& state, ErrorMetric metric) {
+    Expression expr = Expression::parse(kCurves[state.range(0)]);
+    GraphView view;
+    view.minY = -5.0f;
+    view.maxY = 5.0f;
+
+    TessellationOptions options;
+    options.metric = metric;
+    TessellationStats stats;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generateGraphPoints(expr, view, options, &stats));
+    }
+
+    state.counters["evaluations"] = static_cast<double>(stats.evaluations);
+    state.counters["intervals"] = static_cast<double>(stats.intervalEvaluations);
+    state.counters["vertices"] = static_cast<double>(stats.vertices);
+    state.counters["evals/vertex"] = static_cast<double>(stats.evaluations) / stats.vertices;
+    state.SetLabel(kCurves[state.range(0)]);
+}
+
+// Three probes per segment and level
+static void BM_TessellateProbes(benchmark::State& state) {
+    tessellate(state, PROBE_METRIC);
+}
+BENCHMARK(BM_TessellateProbes)->DenseRange(0, 5);
+
+// One value-and-derivatives evaluation per split
+static void BM_TessellateDerivatives(benchmark::State& state) {
+    tessellate(state, DERIVATIVE_METRIC);
+}
+BENCHMARK(BM_TessellateDerivatives)->DenseRange(0, 5);
+
+// sin(x) in a view 1e-3 wide around x = 1000, where floats are ~6e-5
+// apart: float steps through ~16 distinct x, double draws the curve.
+// Arg 0 forces float, arg 1 double.
+static void BM_TessellateDeepZoom(benchmark::State& state) {
+    Expression expr = Expression::parse("sin(x)");
+    GraphView view;
+    view.minX = 1000.0;
+    view.maxX = 1000.001;
+    view.minY = std::sin(1000.0) - 1e-3;
+    view.maxY = std::sin(1000.0) + 1e-3;
+
+    TessellationOptions options;
+    options.precision = state.range(0) ? DOUBLE_PRECISION : FLOAT_PRECISION;
+    TessellationStats stats;
+    StripBuffer strips;
+    for (auto _ : state) {
+        generateGraphPoints(expr, view, options, strips, &stats);
+        benchmark::DoNotOptimize(strips);
+    }
+
+    // Distinct screen x among the emitted vertices
+    std::vector<float> xs;
+    for (size_t i = 0; i < strips.vertices.size(); i += 3) xs.push_back(strips.vertices[i]);
+    std::sort(xs.begin(), xs.end());
+    state.counters["distinct x"] = static_cast<double>(std::unique(xs.begin(), xs.end()) - xs.begin());
+    state.counters["vertices"] = static_cast<double>(stats.vertices);
+    state.SetLabel(stats.doublePrecision ? "double" : "float");
+}
+BENCHMARK(BM_TessellateDeepZoom)->Arg(0)->Arg(1);
+
+// Implicit curves: a closed one, a family of hyperbolas, and one whose
+// bound stays loose (every tile gets sampled)
+static const char* kEquations[] = {
+    "x^2 + y^2 = 4",
+    "sin(x*y) = 0.5",
+    "y^2 = x^3 - x + sin(5*x)",
+};
+
+static void BM_ContourImplicit(benchmark::State& state) {
+    Expression expr = Expression::parse(kEquations[state.range(0)]);
+    GraphView view;
+    view.minX = -5.0;
+    view.maxX = 5.0;
+    view.minY = -5.0;
+    view.maxY = 5.0;
+
+    ContourStats stats;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generateImplicitPoints(expr, view, ContourOptions(), &stats));
+    }
+
+    state.counters["evaluations"] = static_cast<double>(stats.evaluations);
+    state.counters["intervals"] = static_cast<double>(stats.intervalEvaluations);
+    state.counters["cells"] = static_cast<double>(stats.cells);
+    state.counters["vertices"] = static_cast<double>(stats.vertices);
+    state.SetLabel(kEquations[state.range(0)]);
+}
+BENCHMARK(BM_ContourImplicit)->DenseRange(0, 2);
+
+// Parametric curves: a dense Lissajous figure and a long spiral.
+// Arg 1 times a pan, which only remaps the cached samples.
+static const char* kParametric[][2] = {
+    {"sin(13*t)", "cos(17*t)"},
+    {"t*cos(t)/40", "t*sin(t)/40"},
+};
+
+static void BM_TessellateParametric(benchmark::State& state) {
+    Expression xExpr = Expression::parse(kParametric[state.range(0)][0]);
+    Expression yExpr = Expression::parse(kParametric[state.range(0)][1]);
+    GraphView view;
+    view.minX = -1.5;
+    view.maxX = 1.5;
+    view.minY = -1.5;
+    view.maxY = 1.5;
+    const double tMax = 400.0;
+
+    ParametricStats stats;
+    std::vector<std::vector<double>> world =
+        tessellateParametric(xExpr, yExpr, 0.0, tMax, view, ParametricOptions(), &stats);
+    for (auto _ : state) {
+        if (state.range(1)) {
+            view.minX += 0.01;
+            view.maxX += 0.01;
+            benchmark::DoNotOptimize(mapStripsToScreen(world, view));
+        } else {
+            benchmark::DoNotOptimize(tessellateParametric(xExpr, yExpr, 0.0, tMax, view, ParametricOptions(), &stats));
+        }
+    }
+
+    state.counters["evaluations"] = static_cast<double>(stats.evaluations);
+    state.counters["vertices"] = static_cast<double>(stats.vertices);
+    state.SetLabel(state.range(1) ? "pan" : "tessellate");
+}
+BENCHMARK(BM_TessellateParametric)->ArgsProduct({{0, 1}, {0, 1}});
+
+// The shared corpus at three view sizes (half-width 1, 10 and 1000),
+// default options
+static void BM_TessellateCorpus(benchmark::State& state) {
+    Expression expr = Expression::parse(kCorpus[state.range(0)]);
+    double halfWidth = static_cast<double>(state.range(1));
+    GraphView view;
+    view.minX = -halfWidth;
+    view.maxX = halfWidth;
+    view.minY = -halfWidth;
+    view.maxY = halfWidth;
+
+    TessellationStats stats;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generateGraphPoints(expr, view, TessellationOptions(), &stats));
+    }
+
+    state.counters["evaluations"] = static_cast<double>(stats.evaluations);
+    state.counters["vertices"] = static_cast<double>(stats.vertices);
+    state.SetLabel(kCorpus[state.range(0)]);
+}
+BENCHMARK(BM_TessellateCorpus)->ArgsProduct({benchmark::CreateDenseRange(0, kCorpusSize - 1, 1), {1, 10, 1000}});
+
+// The pathological case for one frame: tan(x) at maxDepth 12 over a wide
+// view, serial (1 chunk) vs. split across the thread pool
+static void BM_TessellateChunks(benchmark::State& state) {
+    Expression expr = Expression::parse("tan(x)");
+    GraphView view;
+    view.minX = -1000.0;
+    view.maxX = 1000.0;
+    view.minY = -1000.0;
+    view.maxY = 1000.0;
+
+    TessellationOptions options;
+    options.chunks = static_cast<int>(state.range(0));
+    TessellationStats stats;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generateGraphPoints(expr, view, options, &stats));
+    }
+
+    state.counters["evaluations"] = static_cast<double>(stats.evaluations);
+    state.counters["threads"] = static_cast<double>(ThreadPool::global().getThreadCount() + 1);
+}
+BENCHMARK(BM_TessellateChunks)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// A 30-curve dashboard panning: the geometry GraphScene::updateView
+// rebuilds, one curve after another (0) vs. all curves across the pool (1)
+static void BM_RegenerateDashboard(benchmark::State& state) {
+    std::vector<Expression> dashboard;
+    for (int i = 0; i < 30; ++i) {
+        dashboard.push_back(Expression::parse(kCorpus[i % kCorpusSize]));
+    }
+    std::vector<StripBuffer> geometry(dashboard.size());
+    GraphView view;
+
+    for (auto _ : state) {
+        auto build = [&](size_t i) { generateGraphPoints(dashboard[i], view, TessellationOptions(), geometry[i]); };
+        if (state.range(0)) {
+            ThreadPool::global().parallelFor(dashboard.size(), build);
+        } else {
+            for (size_t i = 0; i < dashboard.size(); ++i) build(i);
+        }
+        benchmark::DoNotOptimize(geometry.data());
+        view.minX += 0.01;
+        view.maxX += 0.01;
+    }
+    state.counters["threads"] = static_cast<double>(ThreadPool::global().getThreadCount() + 1);
+}
+BENCHMARK(BM_RegenerateDashboard)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// A curve panning one step per frame into a fresh buffer (0) vs. the
+// buffer of the frame before (1), as Line2D recycles them
+static void BM_PanIntoBuffer(benchmark::State& state) {
+    Expression expr = Expression::parse("tan(x)*sin(20*x)");
+    GraphView view;
+    TessellationOptions options;
+    StripBuffer strips;
+
+    for (auto _ : state) {
+        if (!state.range(0)) strips = StripBuffer();
+        generateGraphPoints(expr, view, options, strips);
+        benchmark::DoNotOptimize(strips.vertices.data());
+        view.minX += 0.01;
+        view.maxX += 0.01;
+    }
+    state.counters["vertices"] = static_cast<double>(strips.vertexCount());
+}
+BENCHMARK(BM_PanIntoBuffer)->Arg(0)->Arg(1);
+
+// A 30-curve dashboard dragged 1% of its width per frame, rebuilding
+// every curve each frame (0) vs. only once the view leaves the margin the
+// geometry was built with (1), as GraphScene::updateView does. Per frame.
+static void BM_PanDashboard(benchmark::State& state) {
+    std::vector<std::unique_ptr<Curve2D>> dashboard;
+    for (int i = 0; i < 30; ++i) {
+        dashboard.push_back(std::make_unique<Curve2D>(kCorpus[i % kCorpusSize]));
+    }
+    GraphView view;
+    size_t rebuilds = 0;
+
+    for (auto _ : state) {
+        for (auto& curve : dashboard) {
+            if (state.range(0) && curve->covers(view)) continue;
+            curve->build(view);
+            ++rebuilds;
+        }
+        view.minX += 0.2;
+        view.maxX += 0.2;
+    }
+    state.counters["rebuilds"] = benchmark::Counter(static_cast<double>(rebuilds), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PanDashboard)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "EquationEditor.h"
+#include "Curve2d.h"
+#include "GeometryJobs.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Test fixture for EquationEditor, without a debounce
+class EquationEditorTest : public ::testing::Test {
+protected:
+    static constexpr std::chrono::milliseconds noDebounce{0};
+
+    // Poll until the build lands
+    static bool Collect(EquationEditor& editor, EquationResult& result) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (editor.poll(result)) return true;
+            std::this_thread::yield();
+        }
+        return false;
+    }
+};
+
+// Any curve, with its strips in reach
+class ExposedCurve : public Curve2D {
+    public:
+        using Curve2D::Curve2D;
+        using Curve2D::strips;
+};
+
+TEST_F(EquationEditorTest, EditsBuildLikeAnyRebuild) {
+    EquationEditor editor("sin(x)", noDebounce);
+    editor.edit("cos(x)");
+    EXPECT_TRUE(editor.isBusy());
+
+    EquationResult result;
+    ASSERT_TRUE(Collect(editor, result));
+    EXPECT_EQ(result.equation, "cos(x)");
+    EXPECT_TRUE(result.error.empty());
+    EXPECT_FALSE(editor.isBusy());
+
+    // The edited curve stops covering the view until its geometry job
+    // lands, padded and as fine as any other
+    GraphView view = {-3.0, 3.0, -2.0, 2.0};
+    ExposedCurve curve("sin(x)");
+    curve.build(view);
+    ASSERT_TRUE(curve.covers(view));
+    curve.applyEquation(std::move(result));
+    EXPECT_FALSE(curve.covers(view));
+
+    GeometryJobs jobs(1);
+    jobs.request(&curve, view);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (jobs.isBusy() && std::chrono::steady_clock::now() < deadline) {
+        if (!jobs.poll().empty()) break;
+        std::this_thread::yield();
+    }
+
+    ExposedCurve reference("cos(x)");
+    reference.build(view);
+    EXPECT_TRUE(curve.covers(view));
+    EXPECT_EQ(curve.getBuiltView().minX, padView(view, GEOMETRY_MARGIN).minX);
+    EXPECT_EQ(curve.strips, reference.strips);
+}
+
+TEST_F(EquationEditorTest, ReportsErrors) {
+    EquationEditor editor("x", noDebounce);
+    editor.edit("sin(");
+    EquationResult result;
+    ASSERT_TRUE(Collect(editor, result));
+    EXPECT_FALSE(result.error.empty());
+
+    // Caught up front, not when the curve's geometry job runs
+    editor.edit("x + z");
+    ASSERT_TRUE(Collect(editor, result));
+    EXPECT_NE(result.error.find("Variable z"), std::string::npos);
+    editor.edit("x^2 + y^2 = 1");
+    ASSERT_TRUE(Collect(editor, result));
+    EXPECT_TRUE(result.error.empty());
+}
+
+TEST_F(EquationEditorTest, DroppedEditorLeavesItsBuild) {
+    // Destroying an editor mid-build must neither wait for nor break the
+    // shared worker
+    auto dropped = std::make_unique<EquationEditor>("x", noDebounce);
+    dropped->edit("x^2 + y^2 = 25");
+    EquationResult result;
+    dropped->poll(result);
+    dropped.reset();
+
+    EquationEditor editor("x", noDebounce);
+    editor.edit("x^2");
+    ASSERT_TRUE(Collect(editor, result));
+    EXPECT_EQ(result.equation, "x^2");
+}
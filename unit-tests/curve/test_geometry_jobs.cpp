@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include "GeometryJobs.h"
+#include "Curve2d.h"
+#include "ParametricCurve2d.h"
+#include "ImplicitGenerator.h"
+#include "ParametricGenerator.h"
+#include <MpscQueue.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// A line whose jobs record their view as the only vertex, and can be held
+// at the start until released, spinning on their cancel token
+class FakeLine : public Line2D {
+    public:
+        std::shared_ptr<std::atomic<bool>> hold = std::make_shared<std::atomic<bool>>(false);
+        std::shared_ptr<std::atomic<int>> started = std::make_shared<std::atomic<int>>(0);
+        std::shared_ptr<std::atomic<int>> cancelled = std::make_shared<std::atomic<int>>(0);
+
+        void touch() { ++revision; }
+        const StripBuffer& getStrips() const { return strips; }
+
+    protected:
+        GeometryBuilder geometryBuilder(GraphView view) const override {
+            return [view, hold = hold, started = started, cancelled = cancelled](CurveGeometry& geometry,
+                                                                                const CancelToken& cancel) {
+                ++*started;
+                while (*hold && !cancel.isCancelled()) std::this_thread::yield();
+                if (cancel.isCancelled()) ++*cancelled;
+                geometry.strips.startStrip();
+                geometry.strips.addVertex(static_cast<float>(view.minX), static_cast<float>(view.maxX));
+            };
+        }
+};
+
+// Any line, with its strips in reach
+template <typename T>
+class Exposed : public T {
+    public:
+        using T::T;
+        using T::strips;
+};
+
+// A parametric curve, with its world-space samples in reach too
+class ExposedParametric : public Exposed<ParametricCurve2D> {
+    public:
+        using Exposed<ParametricCurve2D>::Exposed;
+        using ParametricCurve2D::worldStrips;
+};
+
+// Test fixture for GeometryJobs and the pieces it is built from
+class GeometryJobsTest : public ::testing::Test {
+protected:
+    static GraphView Shifted(double dx) {
+        return {-10.0 + dx, 10.0 + dx, -10.0, 10.0};
+    }
+
+    // Poll until every request has landed
+    static std::vector<Line2D*> Settle(GeometryJobs& jobs) {
+        std::vector<Line2D*> changed;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (jobs.isBusy() && std::chrono::steady_clock::now() < deadline) {
+            for (Line2D* line : jobs.poll()) changed.push_back(line);
+            std::this_thread::yield();
+        }
+        EXPECT_FALSE(jobs.isBusy());
+        return changed;
+    }
+};
+
+TEST_F(GeometryJobsTest, QueueKeepsEveryProducersOrder) {
+    MpscQueue<std::pair<int, int>> queue;
+    const int producers = 4;
+    const int perProducer = 20000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 0; i < perProducer; ++i) queue.push({p, i});
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    auto take = [&] {
+        for (const auto& [p, i] : queue.drain()) {
+            ASSERT_EQ(i, next[p]) << "producer " << p;
+            ++next[p];
+            ++received;
+        }
+    };
+    while (received < producers * perProducer - perProducer) take();
+    for (std::thread& t : threads) t.join();
+    take();
+
+    EXPECT_EQ(received, producers * perProducer);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(GeometryJobsTest, CancelTokenFollowsLatestTicket) {
+    auto latest = std::make_shared<std::atomic<uint64_t>>(1);
+    CancelToken token(latest, 1);
+    EXPECT_FALSE(token.isCancelled());
+    latest->store(2);
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_FALSE(CancelToken().isCancelled());
+}
+
+TEST_F(GeometryJobsTest, GeneratorsStopWhenCancelled) {
+    auto latest = std::make_shared<std::atomic<uint64_t>>(2);
+    CancelToken cancelled(latest, 1);
+
+    Expression curve = Expression::parse("sin(x)");
+    TessellationOptions tessellation;
+    tessellation.cancel = &cancelled;
+    EXPECT_TRUE(generateGraphPoints(curve, GraphView(), tessellation).empty());
+
+    Expression circle = Expression::parse("x^2 + y^2 = 25");
+    ContourOptions contour;
+    contour.cancel = &cancelled;
+    EXPECT_TRUE(generateImplicitPoints(circle, GraphView(), contour).empty());
+
+    Expression x = Expression::parse("cos(t)");
+    Expression y = Expression::parse("sin(t)");
+    ParametricOptions parametric;
+    parametric.cancel = &cancelled;
+    EXPECT_TRUE(tessellateParametric(x, y, 0.0, 6.28, GraphView(), parametric).empty());
+
+    // A token that never fires changes nothing
+    CancelToken live(latest, 2);
+    tessellation.cancel = &live;
+    EXPECT_FALSE(generateGraphPoints(curve, GraphView(), tessellation).empty());
+}
+
+TEST_F(GeometryJobsTest, NewestRequestWins) {
+    GeometryJobs jobs(2);
+    FakeLine line;
+    *line.hold = true;
+
+    jobs.request(&line, Shifted(1.0));
+    while (*line.started == 0) std::this_thread::yield();
+
+    // Both arrive while the first job runs: it is cancelled, the middle
+    // one never starts, the last one is applied
+    jobs.request(&line, Shifted(2.0));
+    jobs.request(&line, Shifted(3.0));
+    *line.hold = false;
+
+    std::vector<Line2D*> changed = Settle(jobs);
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], &line);
+    EXPECT_EQ(*line.started, 2);
+    EXPECT_EQ(*line.cancelled, 1);
+    GraphView built = padView(Shifted(3.0), GEOMETRY_MARGIN);
+    EXPECT_EQ(line.getBuiltView().minX, built.minX);
+    EXPECT_EQ(line.getStrips().vertices[0], static_cast<float>(built.minX));
+}
+
+TEST_F(GeometryJobsTest, ChangedLineDropsOlderGeometry) {
+    GeometryJobs jobs(1);
+    FakeLine line;
+    *line.hold = true;
+
+    jobs.request(&line, Shifted(1.0));
+    while (*line.started == 0) std::this_thread::yield();
+    line.touch();       // say, a new equation swapped in meanwhile
+    *line.hold = false;
+
+    EXPECT_TRUE(Settle(jobs).empty());
+    EXPECT_TRUE(line.getStrips().empty());
+}
+
+TEST_F(GeometryJobsTest, CancelledLineIsLeftAlone) {
+    GeometryJobs jobs(1);
+    auto line = std::make_unique<FakeLine>();
+    auto cancelled = line->cancelled;
+    *line->hold = true;
+
+    jobs.request(line.get(), Shifted(1.0));
+    while (*line->started == 0) std::this_thread::yield();
+    jobs.cancel(line.get());
+    line.reset();
+
+    EXPECT_FALSE(jobs.isBusy());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (*cancelled == 0 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+    EXPECT_EQ(*cancelled, 1);
+    EXPECT_TRUE(jobs.poll().empty());
+}
+
+TEST_F(GeometryJobsTest, CurvesBuildLikeTheSynchronousPath) {
+    GeometryJobs jobs;
+    Exposed<Curve2D> synchronous("x^2 + y^2 = 25");
+    Exposed<Curve2D> background("x^2 + y^2 = 25");
+    ExposedParametric spiralSynchronous("t*cos(t)", "t*sin(t)", 0.0, 20.0);
+    ExposedParametric spiralBackground("t*cos(t)", "t*sin(t)", 0.0, 20.0);
+
+    GraphView view = Shifted(0.5);
+    synchronous.build(view);
+    spiralSynchronous.build(view);
+    jobs.request(&background, view);
+    jobs.request(&spiralBackground, view);
+    EXPECT_EQ(Settle(jobs).size(), 2u);
+
+    EXPECT_FALSE(synchronous.strips.empty());
+    EXPECT_EQ(background.strips, synchronous.strips);
+    EXPECT_EQ(spiralBackground.strips, spiralSynchronous.strips);
+    EXPECT_EQ(background.getBuiltView().minX, padView(view, GEOMETRY_MARGIN).minX);
+
+    // A pan reuses the spiral's samples, in the background as well, even
+    // though it moves the padded view's span by an ulp
+    GraphView panned = Shifted(123.456);
+    GraphView before = padView(view, GEOMETRY_MARGIN);
+    GraphView after = padView(panned, GEOMETRY_MARGIN);
+    ASSERT_NE(after.maxX - after.minX, before.maxX - before.minX);
+
+    auto samples = spiralBackground.worldStrips;
+    auto samplesSynchronous = spiralSynchronous.worldStrips;
+    jobs.request(&spiralBackground, panned);
+    spiralSynchronous.build(panned);
+    Settle(jobs);
+    EXPECT_EQ(spiralBackground.worldStrips, samples);
+    EXPECT_EQ(spiralSynchronous.worldStrips, samplesSynchronous);
+    EXPECT_EQ(spiralBackground.strips, spiralSynchronous.strips);
+
+    // A zoom does not
+    spiralSynchronous.build({-20.0, 20.0, -20.0, 20.0});
+    EXPECT_NE(spiralSynchronous.worldStrips, samplesSynchronous);
+}
+
+TEST_F(GeometryJobsTest, GeometryCoversPansWithinItsMargin) {
+    Curve2D curve("sin(x)");
+    EXPECT_FALSE(curve.covers(Shifted(0.0)));
+
+    curve.build(Shifted(0.0));
+    EXPECT_EQ(curve.getBuiltView().minX, -20.0);
+    EXPECT_EQ(curve.getBuiltView().maxY, 20.0);
+
+    // Margin: half the view on each side
+    EXPECT_TRUE(curve.covers(Shifted(0.0)));
+    EXPECT_TRUE(curve.covers(Shifted(9.5)));
+    EXPECT_TRUE(curve.covers(Shifted(-10.0)));
+    EXPECT_FALSE(curve.covers(Shifted(10.5)));
+    EXPECT_FALSE(curve.covers({-10.0, 10.0, 5.0, 25.0}));
+
+    // Zooming in holds while the finer tolerance does, zooming out while
+    // the margin does
+    EXPECT_TRUE(curve.covers({-7.0, 7.0, -7.0, 7.0}));
+    EXPECT_FALSE(curve.covers({-6.0, 6.0, -6.0, 6.0}));
+    EXPECT_TRUE(curve.covers({-19.0, 19.0, -19.0, 19.0}));
+    EXPECT_TRUE(curve.covers({-20.0, 20.0, -20.0, 20.0}));    // 1 + 2 * margin
+    EXPECT_FALSE(curve.covers({-21.0, 21.0, -21.0, 21.0}));
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "ImplicitGenerator.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Test fixture for generateImplicitPoints(). Vertices come out in screen
+// coordinates, so the fixture maps them back onto the view.
+class ImplicitGeneratorTest : public ::testing::Test {
+protected:
+    static constexpr GraphView view = {-10.0, 10.0, -10.0, 10.0};
+
+    // World coordinates of the vertices of one strip
+    static std::vector<std::pair<double, double>> Strip(const StripBuffer& strips, size_t index) {
+        std::vector<std::pair<double, double>> points;
+        auto [first, count] = strips.ranges[index];
+        for (int i = first; i < first + count; ++i) {
+            double x = view.minX + (strips.vertices[3 * i] + 1.0) * (view.maxX - view.minX) / 2.0;
+            double y = view.minY + (strips.vertices[3 * i + 1] + 1.0) * (view.maxY - view.minY) / 2.0;
+            points.emplace_back(x, y);
+        }
+        return points;
+    }
+};
+
+TEST_F(ImplicitGeneratorTest, CircleIsOneClosedStrip) {
+    Expression circle = Expression::parse("x^2 + y^2 = 25");
+    StripBuffer strips = generateImplicitPoints(circle, view);
+
+    ASSERT_EQ(strips.stripCount(), 1u);
+    auto points = Strip(strips, 0);
+    ASSERT_GT(points.size(), 16u);
+    EXPECT_EQ(points.front(), points.back());
+    for (auto [x, y] : points) {
+        EXPECT_NEAR(std::hypot(x, y), 5.0, 0.01) << x << ", " << y;
+    }
+}
+
+TEST_F(ImplicitGeneratorTest, PoleSplitsTheCurve) {
+    Expression hyperbola = Expression::parse("y = 1/(x-0.3)");
+    StripBuffer strips = generateImplicitPoints(hyperbola, view);
+
+    ASSERT_EQ(strips.stripCount(), 2u);
+    for (size_t s = 0; s < strips.stripCount(); ++s) {
+        auto points = Strip(strips, s);
+        EXPECT_NE(points.front(), points.back());
+        for (size_t i = 1; i < points.size(); ++i) {
+            bool crosses = (points[i - 1].first - 0.3) * (points[i].first - 0.3) < 0.0;
+            EXPECT_FALSE(crosses) << "segment " << i << " of strip " << s;
+        }
+    }
+}
+
+TEST_F(ImplicitGeneratorTest, StripsJoinAcrossTiles) {
+    // Same sampling grid, one tile or 8x8 of them: the tile edges (x = 0
+    // and y = 0 among them) must not cut the circle
+    Expression circle = Expression::parse("x^2 + y^2 = 25");
+    ContourOptions whole;
+    whole.tiles = 1;
+    whole.tileCells = 64;
+    ContourOptions tiled;
+    tiled.tiles = 8;
+    tiled.tileCells = 8;
+
+    StripBuffer one = generateImplicitPoints(circle, view, whole);
+    StripBuffer many = generateImplicitPoints(circle, view, tiled);
+    ASSERT_EQ(one.stripCount(), 1u);
+    ASSERT_EQ(many.stripCount(), 1u);
+    EXPECT_EQ(one.vertexCount(), many.vertexCount());
+    auto points = Strip(many, 0);
+    EXPECT_EQ(points.front(), points.back());
+}
+
+TEST_F(ImplicitGeneratorTest, RejectsOtherVariables) {
+    EXPECT_THROW(generateImplicitPoints(Expression::parse("x^2 + z^2 = 1"), view), std::runtime_error);
+    EXPECT_THROW(generateImplicitPoints(Expression::parse("t = y"), view), std::runtime_error);
+    EXPECT_THROW(generateImplicitPoints(Expression::parse("x +"), view), std::runtime_error);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "ParametricGenerator.h"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Test fixture for tessellateParametric(), whose strips are in world
+// coordinates, two doubles per vertex
+class ParametricGeneratorTest : public ::testing::Test {
+protected:
+    static std::vector<std::vector<double>> Tessellate(const char* x, const char* y,
+                                                       double tMin, double tMax, GraphView view) {
+        return tessellateParametric(Expression::parse(x), Expression::parse(y), tMin, tMax, view);
+    }
+};
+
+TEST_F(ParametricGeneratorTest, CircleIsOneStripOnTheRadius) {
+    auto strips = Tessellate("3*cos(t)", "3*sin(t)", 0.0, 2.0 * M_PI, {-5.0, 5.0, -5.0, 5.0});
+
+    ASSERT_EQ(strips.size(), 1u);
+    const std::vector<double>& strip = strips[0];
+    ASSERT_GT(strip.size(), 32u);
+    for (size_t k = 0; k + 1 < strip.size(); k += 2) {
+        EXPECT_NEAR(std::hypot(strip[k], strip[k + 1]), 3.0, 1e-9);
+    }
+    EXPECT_NEAR(strip.front(), 3.0, 1e-9);
+    EXPECT_NEAR(strip[strip.size() - 2], 3.0, 1e-9);
+}
+
+TEST_F(ParametricGeneratorTest, PoleBreaksTheStrip) {
+    // tan(t) has a pole at t = pi/2, inside [0, 3]
+    auto strips = Tessellate("t", "tan(t)", 0.0, 3.0, {0.0, 3.0, -5.0, 5.0});
+
+    ASSERT_EQ(strips.size(), 2u);
+    const double pole = M_PI / 2.0;
+    for (size_t s = 0; s < strips.size(); ++s) {
+        const std::vector<double>& strip = strips[s];
+        for (size_t k = 2; k + 1 < strip.size(); k += 2) {
+            EXPECT_FALSE((strip[k - 2] - pole) * (strip[k] - pole) < 0.0) << "strip " << s << " at " << k;
+        }
+    }
+
+    // Both strips run right up to the pole: the last vertex before the
+    // break is kept
+    const std::vector<double>& before = strips[0];
+    const std::vector<double>& after = strips[1];
+    EXPECT_EQ(before.front(), 0.0);
+    EXPECT_GT(before[before.size() - 2], pole - 1e-2);
+    EXPECT_GT(before.back(), 100.0);
+    EXPECT_LT(after.front(), pole + 1e-2);
+    EXPECT_LT(after[1], -100.0);
+    EXPECT_EQ(after[after.size() - 2], 3.0);
+}
+
+TEST_F(ParametricGeneratorTest, RejectsOtherVariables) {
+    EXPECT_THROW(Tessellate("x", "t", 0.0, 1.0, GraphView()), std::runtime_error);
+    EXPECT_THROW(Tessellate("t", "t +", 0.0, 1.0, GraphView()), std::runtime_error);
+}
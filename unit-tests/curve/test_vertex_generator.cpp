@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "VertexGenerator.h"
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+// Test fixture for generateGraphPoints(). Splitting the initial segments
+// into chunks (refined in parallel) must not change a single vertex.
+class VertexGeneratorTest : public ::testing::Test {
+protected:
+    // Workers of their own: the global pool has none on a single core,
+    // and the chunks would never run at the same time
+    static ThreadPool& Pool() {
+        static ThreadPool pool(4);
+        return pool;
+    }
+
+    static StripBuffer Tessellate(const Expression& expr, GraphView view,
+                                  TessellationOptions options, int chunks,
+                                  TessellationStats* stats = nullptr) {
+        options.chunks = chunks;
+        options.pool = &Pool();
+        return generateGraphPoints(expr, view, options, stats);
+    }
+
+    // Bitwise, so NaN payloads and signed zeros count too
+    static bool SameBits(const StripBuffer& a, const StripBuffer& b) {
+        if (a.ranges != b.ranges || a.vertices.size() != b.vertices.size()) return false;
+        return std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(float)) == 0;
+    }
+};
+
+TEST_F(VertexGeneratorTest, ChunksMatchSerialBitForBit) {
+    const char* equations[] = {
+        "tan(x)", "e^(1/x)", "sin(1/x)", "sqrt(x)", "ln(x)", "floor(x)",
+        "x^3 - 2*x^2 + x - 5", "sin(x)*cos(2*x) + 0.5", "floor(x)^x", "2^x",
+    };
+    const GraphView views[] = {
+        {-10.0, 10.0, -10.0, 10.0},
+        {-0.1, 0.3, -5.0, 5.0},
+        {1.0e6, 1.0e6 + 1.0e-3, -2.0, 2.0},     // double precision
+    };
+
+    for (MathMode mode : {EXACT_MATH, FAST_MATH}) {
+        for (const char* equation : equations) {
+            Expression expr = Expression::parse(equation);
+            expr.setMathMode(mode);
+            ASSERT_TRUE(expr.isValid()) << equation;
+
+            for (const GraphView& view : views) {
+                for (ErrorMetric metric : {PROBE_METRIC, DERIVATIVE_METRIC}) {
+                    TessellationOptions options;
+                    options.metric = metric;
+
+                    TessellationStats serialStats, chunkStats;
+                    auto serial = Tessellate(expr, view, options, 1, &serialStats);
+                    for (int chunks : {3, 8, 64, 1000}) {
+                        auto chunked = Tessellate(expr, view, options, chunks, &chunkStats);
+                        EXPECT_TRUE(SameBits(serial, chunked))
+                            << equation << " over [" << view.minX << ", " << view.maxX << "], "
+                            << chunks << " chunks, metric " << metric << ", mode " << mode;
+                        EXPECT_EQ(chunkStats.evaluations, serialStats.evaluations);
+                        EXPECT_EQ(chunkStats.intervalEvaluations, serialStats.intervalEvaluations);
+                        EXPECT_EQ(chunkStats.vertices, serialStats.vertices);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// A strip that crosses a chunk boundary stays one strip
+TEST_F(VertexGeneratorTest, StripsContinueAcrossChunks) {
+    Expression expr = Expression::parse("x^2");
+    auto strips = Tessellate(expr, {-10.0, 10.0, -1.0, 200.0}, TessellationOptions(), 64);
+    ASSERT_EQ(strips.stripCount(), 1u);
+    EXPECT_FLOAT_EQ(strips.vertices.front(), -1.0f);
+    EXPECT_FLOAT_EQ(strips.vertices[strips.vertices.size() - 3], 1.0f);
+}
+
+// Distinct screen x coordinates of the vertices
+static size_t DistinctX(const StripBuffer& strips) {
+    std::set<float> xs;
+    for (size_t i = 0; i < strips.vertices.size(); i += 3) xs.insert(strips.vertices[i]);
+    return xs.size();
+}
+
+// Far from the origin neighbouring floats are ~6e-5 apart, so a view
+// 0.001 wide holds only ~16 of them: float sampling comes out as a
+// staircase, double sampling as a curve
+TEST_F(VertexGeneratorTest, DeepZoomSwitchesToDouble) {
+    Expression expr = Expression::parse("sin(10000*x)");
+    const GraphView deep = {1000.0, 1000.001, -1.5, 1.5};
+
+    TessellationStats stats;
+    StripBuffer strips = generateGraphPoints(expr, deep, TessellationOptions(), &stats);
+    EXPECT_TRUE(stats.doublePrecision);
+    EXPECT_GT(DistinctX(strips), 50u);
+
+    TessellationOptions floatOnly;
+    floatOnly.precision = FLOAT_PRECISION;
+    StripBuffer stairs = generateGraphPoints(expr, deep, floatOnly, &stats);
+    EXPECT_FALSE(stats.doublePrecision);
+    EXPECT_LE(DistinctX(stairs), 20u);
+
+    // The default view stays in float
+    generateGraphPoints(expr, GraphView(), TessellationOptions(), &stats);
+    EXPECT_FALSE(stats.doublePrecision);
+    generateGraphPoints(expr, {-10.0, 10.0, -10.0, 10.0}, TessellationOptions(), &stats);
+    EXPECT_FALSE(stats.doublePrecision);
+}
+
+// Fed back the previous build's buffer, a small pan writes into the same
+// storage, and matches a fresh build
+TEST_F(VertexGeneratorTest, ReusedBufferKeepsItsStorage) {
+    Expression expr = Expression::parse("sin(x)*x");
+    TessellationOptions options;
+    StripBuffer strips;
+    generateGraphPoints(expr, {-10.0, 10.0, -10.0, 10.0}, options, strips);
+    strips.reserve(strips.vertexCount() * 2, strips.stripCount() * 2);
+    const float* storage = strips.vertices.data();
+
+    for (int i = 1; i <= 10; ++i) {
+        GraphView view = {-10.0 + 0.01 * i, 10.0 + 0.01 * i, -10.0, 10.0};
+        generateGraphPoints(expr, view, options, strips);
+        EXPECT_EQ(strips.vertices.data(), storage);
+        EXPECT_TRUE(SameBits(strips, generateGraphPoints(expr, view, options)));
+    }
+}
+
+// Strips too short to draw are taken back
+TEST_F(VertexGeneratorTest, StripBufferDropsShortStrips) {
+    StripBuffer strips;
+    strips.startStrip();
+    strips.addVertex(0.0f, 0.0f);
+    strips.startStrip();
+    strips.addVertex(1.0f, 1.0f);
+    strips.addVertex(2.0f, 2.0f);
+    strips.startStrip();
+    strips.addVertex(3.0f, 3.0f);
+    strips.finish();
+
+    ASSERT_EQ(strips.stripCount(), 1u);
+    EXPECT_EQ(strips.ranges[0], std::make_pair(0, 2));
+    EXPECT_EQ(strips.vertices, std::vector<float>({1.0f, 1.0f, 0.0f, 2.0f, 2.0f, 0.0f}));
+}
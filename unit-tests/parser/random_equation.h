@@ -0,0 +1,45 @@
+#ifndef _RANDOM_EQUATION_H_
+#define _RANDOM_EQUATION_H_
+
+#include <random>
+#include <string>
+
+// Random equations over x and y using every operator the grammar has.
+// Used by tests that check an evaluator against the tree walker.
+class RandomEquation {
+    private:
+        std::mt19937& rng;
+
+        int pick(int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); }
+
+    public:
+        explicit RandomEquation(std::mt19937& generator) : rng(generator) {}
+
+        std::string generate(int depth) {
+            static const char* leaves[] = {"x", "y", "x", "2", "0.5", "3.25", "0", "1", "pi", "e"};
+            static const char* functions[] = {
+                "sin", "cos", "tan", "cot", "sec", "csc",
+                "arcsin", "arccos", "arctan", "arccot", "arcsec", "arccsc",
+                "log", "ln", "sqrt", "abs", "floor", "ceil",
+            };
+            static const char* operators[] = {" + ", " - ", " * ", " / ", "^"};
+
+            if (depth == 0 || pick(4) == 0) {
+                return leaves[pick(sizeof(leaves) / sizeof(leaves[0]))];
+            }
+            switch (pick(5)) {
+                case 0:
+                    return std::string(functions[pick(sizeof(functions) / sizeof(functions[0]))]) +
+                           "(" + generate(depth - 1) + ")";
+                case 1:
+                    return "-(" + generate(depth - 1) + ")";
+                case 2:
+                    return pick(2) ? "|" + generate(depth - 1) + "|"
+                                   : "(" + generate(depth - 1) + ")!";
+                default:
+                    return "(" + generate(depth - 1) + operators[pick(5)] + generate(depth - 1) + ")";
+            }
+        }
+};
+
+#endif /* _RANDOM_EQUATION_H_ */
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "Arena.h"
+#include <cstdint>
+#include <string>
+
+// Test fixture for Arena tests
+class ArenaTest : public ::testing::Test {
+protected:
+    static bool IsAligned(const void* p, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    }
+};
+
+TEST_F(ArenaTest, AllocationsAreAlignedAndCounted) {
+    Arena arena;
+    void* a = arena.allocate(1, 1);
+    void* b = arena.allocate(sizeof(double), alignof(double));
+    void* c = arena.allocate(3, 16);
+
+    EXPECT_TRUE(IsAligned(b, alignof(double)));
+    EXPECT_TRUE(IsAligned(c, 16));
+    EXPECT_NE(a, b);
+    EXPECT_EQ(arena.getAllocationCount(), 3u);
+    EXPECT_EQ(arena.getBytesUsed(), 1 + sizeof(double) + 3);
+    EXPECT_EQ(arena.getChunkCount(), 1u);
+}
+
+TEST_F(ArenaTest, GrowsByChunks) {
+    Arena arena(64);
+    for (int i = 0; i < 32; i++) {
+        arena.create<int>(i);
+    }
+    EXPECT_GT(arena.getChunkCount(), 1u);
+
+    // Requests bigger than a chunk get their own
+    size_t chunks = arena.getChunkCount();
+    arena.allocate(1000);
+    EXPECT_EQ(arena.getChunkCount(), chunks + 1);
+    EXPECT_GE(arena.getBytesReserved(), arena.getBytesUsed());
+}
+
+TEST_F(ArenaTest, CopiesStrings) {
+    Arena arena;
+    std::string source = "theta";
+    std::string_view copy = arena.copyString(source);
+    source[0] = 'T';
+    EXPECT_EQ(copy, "theta");
+}
+
+TEST_F(ArenaTest, MoveKeepsPointersValid) {
+    Arena arena;
+    int* value = arena.create<int>(42);
+
+    Arena moved = std::move(arena);
+    EXPECT_EQ(*value, 42);
+    EXPECT_EQ(moved.getAllocationCount(), 1u);
+    EXPECT_EQ(arena.getAllocationCount(), 0u);
+    EXPECT_EQ(arena.getChunkCount(), 0u);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "Expression.h"
+#include "Dual.h"
+#include "SymbolTable.h"
+#include "random_equation.h"
+#include <cmath>
+#include <random>
+#include <string>
+
+// Test fixture for derivative evaluation. Values must match the scalar
+// evaluator exactly; derivatives are checked against closed forms and
+// against finite differences.
+class DualTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{4242};
+
+    Dual Differentiate(const std::string& equation, float x) {
+        Expression expr = Expression::parse(equation);
+        EXPECT_TRUE(expr.isValid()) << expr.getError();
+        float frame = 0.0f;
+        return expr.evaluateDual(&frame, 0, x);
+    }
+
+    static bool Same(float a, float b) {
+        return (std::isnan(a) && std::isnan(b)) || a == b;
+    }
+};
+
+TEST_F(DualTest, ElementaryDerivatives) {
+    struct Case { const char* equation; float x; float d1; float d2; };
+    const Case cases[] = {
+        {"x^3",         2.0f,   12.0f,                  12.0f},
+        {"x^3",        -2.0f,   12.0f,                 -12.0f},
+        {"sin(x)",      1.0f,   std::cos(1.0f),         -std::sin(1.0f)},
+        {"cos(2*x)",    0.5f,   -2.0f * std::sin(1.0f), -4.0f * std::cos(1.0f)},
+        {"tan(x)",      0.5f,   1.0f / std::pow(std::cos(0.5f), 2.0f),
+                                2.0f * std::tan(0.5f) / std::pow(std::cos(0.5f), 2.0f)},
+        {"1/x",         4.0f,   -1.0f / 16.0f,          2.0f / 64.0f},
+        {"ln(x)",       2.0f,   0.5f,                   -0.25f},
+        {"log(x)",      10.0f,  0.1f / std::log(10.0f), -0.01f / std::log(10.0f)},
+        {"sqrt(x)",     4.0f,   0.25f,                  -1.0f / 32.0f},
+        {"e^x",         1.5f,   std::exp(1.5f),         std::exp(1.5f)},
+        {"x^x",         2.0f,   4.0f * (std::log(2.0f) + 1.0f),
+                                4.0f * (std::pow(std::log(2.0f) + 1.0f, 2.0f) + 0.5f)},
+        {"arctan(x)",   1.0f,   0.5f,                   -0.5f},
+        {"arcsin(x)",   0.5f,   1.0f / std::sqrt(0.75f), 0.5f / std::pow(0.75f, 1.5f)},
+        {"|x|",        -3.0f,   -1.0f,                  0.0f},
+        {"floor(x)",    2.5f,   0.0f,                   0.0f},
+        {"(x)!",        1.0f,   1.0f - 0.5772156649f,   0.8236806f},
+    };
+
+    for (const Case& c : cases) {
+        Dual d = Differentiate(c.equation, c.x);
+        EXPECT_NEAR(d.d1, c.d1, 1e-4f * std::max(1.0f, std::abs(c.d1))) << c.equation;
+        EXPECT_NEAR(d.d2, c.d2, 1e-4f * std::max(1.0f, std::abs(c.d2))) << c.equation;
+    }
+}
+
+TEST_F(DualTest, OnlyTheChosenSlotVaries) {
+    Expression expr = Expression::parse("x * y^2");
+    ASSERT_TRUE(expr.isValid());
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    symbols.AddEntry("y");
+    symbols.SetValue("x", 3.0f);
+    symbols.SetValue("y", 2.0f);
+    expr.bind(symbols);
+
+    Dual dx = expr.evaluateDual(symbols.GetFrame(), symbols.GetIndex("x"), 3.0f);
+    EXPECT_FLOAT_EQ(dx.value, 12.0f);
+    EXPECT_FLOAT_EQ(dx.d1, 4.0f);
+    EXPECT_FLOAT_EQ(dx.d2, 0.0f);
+
+    Dual dy = expr.evaluateDual(symbols.GetFrame(), symbols.GetIndex("y"), 2.0f);
+    EXPECT_FLOAT_EQ(dy.d1, 12.0f);
+    EXPECT_FLOAT_EQ(dy.d2, 6.0f);
+}
+
+TEST_F(DualTest, ConstantFactorsDoNotPoisonDerivatives) {
+    // 0 * inf from a constant sub-expression must not leak into f'
+    Dual d = Differentiate("sqrt(0) * x + x", 1.0f);
+    EXPECT_FLOAT_EQ(d.d1, 1.0f);
+    d = Differentiate("x^1", 0.0f);
+    EXPECT_FLOAT_EQ(d.d1, 1.0f);
+    EXPECT_FLOAT_EQ(d.d2, 0.0f);
+}
+
+TEST_F(DualTest, MatchesRandomExpressions) {
+    RandomEquation generator(rng);
+    std::uniform_real_distribution<float> uniform(-5.0f, 5.0f);
+    int compared = 0;
+
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string equation = generator.generate(4);
+        Expression expr = Expression::parse(equation);
+        ASSERT_TRUE(expr.isValid()) << equation << ": " << expr.getError();
+
+        SymbolTable symbols;
+        symbols.AddEntry("x");
+        symbols.AddEntry("y");
+        symbols.SetValue("y", uniform(rng));
+        expr.bind(symbols);
+        const int xSlot = symbols.GetIndex("x");
+        float* frame = symbols.GetFrame();
+
+        float x = uniform(rng);
+        frame[xSlot] = x;
+        float value = expr.evaluate(frame);
+        Dual d = expr.evaluateDual(frame, xSlot, x);
+        EXPECT_TRUE(Same(d.value, value)) << equation << " at x = " << x;
+
+        // Compare f' with central differences where two step sizes agree,
+        // i.e. where f is smooth at the scale of the step
+        auto difference = [&](float h) {
+            frame[xSlot] = x + h;
+            float up = expr.evaluate(frame);
+            frame[xSlot] = x - h;
+            float down = expr.evaluate(frame);
+            return (up - down) / (2.0f * h);
+        };
+        float coarse = difference(1e-2f);
+        float fine = difference(5e-3f);
+        if (!std::isfinite(coarse) || !std::isfinite(fine) || !std::isfinite(d.d1)) continue;
+        float scale = std::max(1.0f, std::abs(fine));
+        if (std::abs(coarse - fine) > 1e-2f * scale || scale > 1e3f) continue;
+
+        EXPECT_NEAR(d.d1, fine, 2e-2f * scale) << equation << " at x = " << x;
+        ++compared;
+    }
+
+    // Most expressions are smooth almost everywhere
+    EXPECT_GT(compared, 100);
+}
+
+TEST_F(DualTest, DoubleDerivatives) {
+    Expression expr = Expression::parse("sin(x)*x^2");
+    ASSERT_TRUE(expr.isValid());
+    double frame = 0.0;
+    double x = 1e6 + 1e-6;
+    DualNumber<double> d = expr.evaluateDual(&frame, 0, x);
+    EXPECT_DOUBLE_EQ(d.value, std::sin(x) * x * x);
+    EXPECT_NEAR(d.d1, std::cos(x) * x * x + 2.0 * x * std::sin(x), 1e-9 * x * x);
+    EXPECT_NEAR(d.d2, -std::sin(x) * x * x + 4.0 * x * std::cos(x) + 2.0 * std::sin(x), 1e-9 * x * x);
+}
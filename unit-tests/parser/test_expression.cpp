@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include "Expression.h"
+#include "SymbolTable.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Test fixture for compiled Expression tests
+class ExpressionTest : public ::testing::Test {
+protected:
+    // Compare the bytecode interpreter against the tree walker bit for bit
+    void ExpectSameAsTree(const std::string& equation) {
+        Expression expr = Expression::parse(equation);
+        ASSERT_TRUE(expr.isValid()) << "Parsing failed: " << expr.getError();
+
+        SymbolTable symbols;
+        symbols.AddEntry("x");
+        for (float x = -10.0f; x <= 10.0f; x += 0.37f) {
+            symbols.SetValue("x", x);
+            float compiled = expr.evaluate(symbols);
+            float tree = expr.evaluateTree(symbols);
+            if (std::isnan(tree)) {
+                EXPECT_TRUE(std::isnan(compiled)) << equation << " at x=" << x;
+            } else {
+                EXPECT_EQ(compiled, tree) << equation << " at x=" << x;
+            }
+        }
+    }
+};
+
+TEST_F(ExpressionTest, CompiledMatchesTree) {
+    const std::vector<std::string> corpus = {
+        "x", "3.5", "-x", "x^2 - 4*x + 1", "2^x^0.5", "(x+1)*(x-1)/(x+2)",
+        "sin(x)", "cos(x)*tan(x)", "cot(x) + sec(x) - csc(x)",
+        "arcsin(x/10) + arccos(x/10) + arctan(x)", "arccot(x) + arcsec(x) + arccsc(x)",
+        "log(x) + ln(x)", "sqrt(|x|)", "abs(x) + floor(x) - ceil(x)",
+        "x!", "1/x", "e^(1/x)", "pi*x + phi", "--x", "sin(cos(tan(x)))"
+    };
+    for (const auto& equation : corpus) {
+        ExpectSameAsTree(equation);
+    }
+}
+
+TEST_F(ExpressionTest, ProgramLayout) {
+    Expression expr = Expression::parse("x*x + 2*x + 1");
+    ASSERT_TRUE(expr.isValid());
+
+    const Program& program = expr.getProgram();
+    EXPECT_EQ(program.getVariables().size(), 1u);
+    EXPECT_EQ(program.getVariables()[0], "x");
+    EXPECT_EQ(program.getCode().size(), 9u);
+    EXPECT_EQ(program.getStackDepth(), 3);
+}
+
+TEST_F(ExpressionTest, DeepProgramUsesHeapStack) {
+    // Right-nested sums need one stack slot per term
+    std::string equation = "x";
+    for (int i = 0; i < 100; ++i) {
+        equation = "x+(" + equation + ")";
+    }
+    Expression expr = Expression::parse(equation);
+    ASSERT_TRUE(expr.isValid());
+    EXPECT_GT(expr.getProgram().getStackDepth(), 64);
+
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    symbols.SetValue("x", 1.0f);
+    EXPECT_EQ(expr.evaluate(symbols), 101.0f);
+}
+
+TEST_F(ExpressionTest, BatchMatchesScalar) {
+    const std::vector<std::string> corpus = {
+        "x^2 - 4*x + 1", "1/x", "-x/0", "sqrt(x) + |x|", "sin(x)*cos(x) - tan(x)",
+        "e^(1/x)", "x!", "ln(-x) + log(x)", "3", "floor(x)*ceil(x) - --x"
+    };
+
+    // 37 inputs covers full blocks plus a ragged tail, and x = 0 / -0
+    std::vector<float> xs;
+    for (int i = 0; i < 37; ++i) {
+        xs.push_back(-6.0f + 0.33f * i);
+    }
+    xs[5] = 0.0f;
+    xs[6] = -0.0f;
+
+    for (const auto& equation : corpus) {
+        Expression expr = Expression::parse(equation);
+        ASSERT_TRUE(expr.isValid()) << "Parsing failed: " << expr.getError();
+
+        SymbolTable symbols;
+        symbols.AddEntry("x");
+        std::vector<float> batch(xs.size());
+        expr.evaluateBatch(symbols, xs.data(), batch.data(), xs.size());
+
+        for (size_t i = 0; i < xs.size(); ++i) {
+            symbols.SetValue("x", xs[i]);
+            float scalar = expr.evaluate(symbols);
+            if (std::isnan(scalar)) {
+                EXPECT_TRUE(std::isnan(batch[i])) << equation << " at x=" << xs[i];
+            } else {
+                EXPECT_EQ(batch[i], scalar) << equation << " at x=" << xs[i];
+            }
+        }
+    }
+}
+
+TEST_F(ExpressionTest, BoundFrameEvaluation) {
+    Expression expr = Expression::parse("y*x + x");
+    ASSERT_TRUE(expr.isValid());
+
+    // Table layout differs from the program's first-use order (x, y)
+    SymbolTable symbols;
+    symbols.AddEntry("t");
+    symbols.AddEntry("y");
+    symbols.AddEntry("x");
+    expr.bind(symbols);
+
+    int x = symbols.GetIndex("x");
+    int y = symbols.GetIndex("y");
+    EXPECT_EQ(x, 2);
+    EXPECT_EQ(y, 1);
+
+    symbols.SetValue(x, 3.0f);
+    symbols.SetValue(y, 4.0f);
+    EXPECT_EQ(symbols.GetValue("x"), 3.0f);
+    EXPECT_EQ(expr.evaluate(symbols.GetFrame()), 15.0f);
+    EXPECT_EQ(expr.evaluate(symbols), 15.0f);
+
+    // Batch over x with y from the frame
+    float xs[3] = {0.0f, 1.0f, 2.0f};
+    float out[3];
+    expr.evaluateBatch(symbols.GetFrame(), x, xs, out, 3);
+    EXPECT_EQ(out[0], 0.0f);
+    EXPECT_EQ(out[1], 5.0f);
+    EXPECT_EQ(out[2], 10.0f);
+}
+
+TEST_F(ExpressionTest, BindMissingVariableThrows) {
+    Expression expr = Expression::parse("x + y");
+    ASSERT_TRUE(expr.isValid());
+
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    EXPECT_THROW(expr.bind(symbols), std::runtime_error);
+}
+
+TEST_F(ExpressionTest, ReportsArenaAllocations) {
+    Expression expr = Expression::parse("x*x + 2*x + 1", false);
+    ASSERT_TRUE(expr.isValid());
+
+    // 9 nodes plus 3 copies of "x"
+    EXPECT_EQ(expr.getAllocationCount(), 12u);
+    EXPECT_GT(expr.getAllocatedBytes(), 9 * sizeof(ConstantNode));
+    EXPECT_EQ(expr.getArena().getChunkCount(), 1u);
+
+    // Still evaluates after being moved (the arena's chunks don't move)
+    Expression moved = std::move(expr);
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    symbols.SetValue("x", 3.0f);
+    EXPECT_EQ(moved.evaluateTree(symbols), 16.0f);
+}
+
+TEST_F(ExpressionTest, DoubleKeepsDigits) {
+    // Literals and folded constants are kept in double as well
+    double frame = 1.0;
+    EXPECT_EQ(Expression::parse("0.1").evaluate(&frame), 0.1);
+    EXPECT_EQ(Expression::parse("2*pi*x").evaluate(&frame), 2.0 * M_PI);
+
+    // Differences float can't see
+    frame = 1.0 + 1e-12;
+    EXPECT_EQ(Expression::parse("x - 1").evaluate(&frame), frame - 1.0);
+    frame = 1.0;
+    EXPECT_NEAR(Expression::parse("1.00000001*x - x").evaluate(&frame), 1e-8, 1e-15);
+
+    // The float path is unchanged
+    float narrow = 1.0f;
+    EXPECT_EQ(Expression::parse("1.00000001*x - x").evaluate(&narrow), 0.0f);
+}
+
+TEST_F(ExpressionTest, DoubleBatchMatchesScalar) {
+    const std::vector<std::string> corpus = {
+        "x^2 - 4*x + 1", "1/x", "sqrt(x) + |x|", "sin(x)*cos(x) - tan(x)",
+        "e^(1/x)", "x!", "ln(-x) + log(x)", "3", "floor(x)*ceil(x) - --x"
+    };
+
+    std::vector<double> xs;
+    for (int i = 0; i < 37; ++i) {
+        xs.push_back(-6.0 + 0.33 * i);
+    }
+    xs[5] = 0.0;
+
+    for (const auto& equation : corpus) {
+        Expression expr = Expression::parse(equation);
+        ASSERT_TRUE(expr.isValid()) << "Parsing failed: " << expr.getError();
+
+        double frame = 0.0;
+        std::vector<double> batch(xs.size());
+        expr.evaluateBatch(&frame, 0, xs.data(), batch.data(), xs.size());
+
+        for (size_t i = 0; i < xs.size(); ++i) {
+            frame = xs[i];
+            double scalar = expr.evaluate(&frame);
+            if (std::isnan(scalar)) {
+                EXPECT_TRUE(std::isnan(batch[i])) << equation << " at x=" << xs[i];
+            } else {
+                EXPECT_EQ(batch[i], scalar) << equation << " at x=" << xs[i];
+            }
+        }
+    }
+}
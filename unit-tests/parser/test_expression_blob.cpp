@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "Expression.h"
+#include "SymbolTable.h"
+#include "random_equation.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Test fixture for Expression::serialize() / deserialize()
+class ExpressionBlobTest : public ::testing::Test {
+protected:
+    static Expression RoundTrip(const Expression& expr) {
+        std::vector<uint8_t> blob = expr.serialize();
+        return Expression::deserialize(blob.data(), blob.size());
+    }
+
+    static bool SameValue(float a, float b) {
+        return (std::isnan(a) && std::isnan(b)) || a == b;
+    }
+};
+
+TEST_F(ExpressionBlobTest, RoundTripsRandomEquations) {
+    std::mt19937 rng(2020);
+    RandomEquation generator(rng);
+
+    for (int i = 0; i < 300; ++i) {
+        std::string equation = generator.generate(4);
+        Expression original = Expression::parse(equation);
+        if (!original.isValid()) continue;
+        Expression loaded = RoundTrip(original);
+        ASSERT_TRUE(loaded.isValid()) << equation << ": " << loaded.getError();
+
+        // Same program, byte for byte
+        EXPECT_EQ(loaded.serialize(), original.serialize()) << equation;
+        EXPECT_EQ(loaded.getProgram().getVariables(), original.getProgram().getVariables());
+
+        const std::vector<std::string>& names = original.getProgram().getVariables();
+        std::vector<float> frame(names.size());
+        std::vector<double> wideFrame(names.size());
+        for (float x : {-2.5f, -0.25f, 0.0f, 0.75f, 3.0f}) {
+            for (size_t slot = 0; slot < names.size(); ++slot) {
+                frame[slot] = (names[slot] == "x") ? x : 1.5f;
+                wideFrame[slot] = frame[slot];
+            }
+            EXPECT_TRUE(SameValue(loaded.evaluate(frame.data()), original.evaluate(frame.data()))) << equation;
+            EXPECT_TRUE(SameValue(static_cast<float>(loaded.evaluate(wideFrame.data())),
+                                  static_cast<float>(original.evaluate(wideFrame.data())))) << equation;
+        }
+    }
+}
+
+TEST_F(ExpressionBlobTest, KeepsFlagsAndMode) {
+    Expression implicit = Expression::parse("x^2 + y^2 = 4");
+    implicit.setMathMode(FAST_MATH);
+    Expression loaded = RoundTrip(implicit);
+    ASSERT_TRUE(loaded.isValid());
+    EXPECT_TRUE(loaded.isImplicit());
+    EXPECT_EQ(loaded.getMathMode(), FAST_MATH);
+    EXPECT_EQ(loaded.getRemovedNodeCount(), implicit.getRemovedNodeCount());
+
+    // A bound program keeps the symbol table's layout
+    SymbolTable symbols;
+    symbols.AddEntry("y");
+    symbols.AddEntry("x");
+    Expression bound = Expression::parse("2*x - y");
+    bound.bind(symbols);
+    Expression boundLoaded = RoundTrip(bound);
+    symbols.SetValue("x", 5.0f);
+    symbols.SetValue("y", 1.0f);
+    EXPECT_EQ(boundLoaded.evaluate(symbols.GetFrame()), 9.0f);
+
+    // Errors survive too, so a restored session reports the same problem
+    Expression broken = Expression::parse("sin(");
+    Expression brokenLoaded = RoundTrip(broken);
+    EXPECT_FALSE(brokenLoaded.isValid());
+    EXPECT_EQ(brokenLoaded.getError(), broken.getError());
+}
+
+TEST_F(ExpressionBlobTest, RejectsDamagedBlobs) {
+    std::vector<uint8_t> blob = Expression::parse("sin(x) * e^(-x^2) + 3").serialize();
+
+    // Any single flipped bit is caught by the magic, version, size or checksum
+    for (size_t byte = 0; byte < blob.size(); ++byte) {
+        std::vector<uint8_t> damaged = blob;
+        damaged[byte] ^= 0x10;
+        Expression loaded = Expression::deserialize(damaged.data(), damaged.size());
+        EXPECT_FALSE(loaded.isValid()) << "byte " << byte;
+        EXPECT_FALSE(loaded.getError().empty());
+    }
+
+    for (size_t size = 0; size < blob.size(); ++size) {
+        EXPECT_FALSE(Expression::deserialize(blob.data(), size).isValid()) << "size " << size;
+    }
+
+    std::vector<uint8_t> newer = blob;
+    uint16_t version = EXPRESSION_BLOB_VERSION + 1;
+    std::memcpy(newer.data() + 8, &version, sizeof(version));
+    Expression loaded = Expression::deserialize(newer.data(), newer.size());
+    EXPECT_FALSE(loaded.isValid());
+    EXPECT_NE(loaded.getError().find("version"), std::string::npos);
+}
+
+TEST_F(ExpressionBlobTest, ValidatesProgram) {
+    Program program = Expression::parse("x + 1").getProgram();
+    std::vector<uint8_t> bytes;
+    program.serialize(bytes);
+    EXPECT_NO_THROW(Program::deserialize(bytes.data(), bytes.size()));
+
+    // Header is 17 bytes, then [VAR 0][CONST 0][ADD]; point VAR at slot 7
+    std::vector<uint8_t> badSlot = bytes;
+    badSlot[17 + 4] = 7;
+    EXPECT_THROW(Program::deserialize(badSlot.data(), badSlot.size()), std::runtime_error);
+
+    // ADD turned into an unknown opcode
+    std::vector<uint8_t> badOp = bytes;
+    badOp[17 + 16] = LAST_OP;
+    EXPECT_THROW(Program::deserialize(badOp.data(), badOp.size()), std::runtime_error);
+
+    // CONST -> VAR and ADD -> NEG leave two values on the stack
+    std::vector<uint8_t> unbalanced = bytes;
+    unbalanced[17 + 8] = OP_VAR;
+    unbalanced[17 + 16] = OP_NEG;
+    EXPECT_THROW(Program::deserialize(unbalanced.data(), unbalanced.size()), std::runtime_error);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "ExpressionCache.h"
+#include "SymbolTable.h"
+
+// Test fixture for ExpressionCache tests. Each test gets its own cache so
+// counts don't depend on what other tests interned globally.
+class ExpressionCacheTest : public ::testing::Test {
+protected:
+    ExpressionCache cache;
+};
+
+TEST_F(ExpressionCacheTest, NormalizesSpacing) {
+    EXPECT_EQ(ExpressionCache::normalize("2*x+1"), "2 * x + 1");
+    EXPECT_EQ(ExpressionCache::normalize("  2 *\tx + 1\n"), "2 * x + 1");
+    EXPECT_EQ(ExpressionCache::normalize("sinx"), "sin x");
+    EXPECT_EQ(ExpressionCache::normalize("sin x"), "sin x");
+
+    // Spacing that changes the tokens is kept apart
+    EXPECT_NE(ExpressionCache::normalize("2 3"), ExpressionCache::normalize("23"));
+
+    // Text that doesn't scan is only trimmed
+    EXPECT_EQ(ExpressionCache::normalize(" x $ 2 "), "x $ 2");
+}
+
+TEST_F(ExpressionCacheTest, SharesEquivalentEquations) {
+    auto first = cache.get("x^2 + 1");
+    auto second = cache.get("x ^ 2+1");
+    auto other = cache.get("x^2 + 2");
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), other.get());
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.getHitCount(), 1u);
+    EXPECT_EQ(cache.getMissCount(), 2u);
+
+    ASSERT_TRUE(first->isValid());
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    symbols.SetValue("x", 3.0f);
+    EXPECT_EQ(first->evaluate(symbols), 10.0f);
+}
+
+TEST_F(ExpressionCacheTest, ReleasesUnusedExpressions) {
+    {
+        auto expression = cache.get("sin(x)");
+        EXPECT_EQ(cache.size(), 1u);
+    }
+    EXPECT_EQ(cache.size(), 0u);
+
+    // Comes back as a fresh parse
+    auto expression = cache.get("sin(x)");
+    EXPECT_EQ(cache.getMissCount(), 2u);
+}
+
+TEST_F(ExpressionCacheTest, CachesInvalidEquations) {
+    auto first = cache.get("x +");
+    auto second = cache.get("x+");
+    EXPECT_FALSE(first->isValid());
+    EXPECT_EQ(first.get(), second.get());
+}
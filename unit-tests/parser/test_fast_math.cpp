@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include "FastMath.h"
+#include "Operations.h"
+#include "Expression.h"
+#include "ExpressionCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Test fixture for the FAST_MATH kernels. Every kernel is held to the
+// ULP bound documented in FastMath.h against libm (the op_* functions),
+// over its whole input range, and must reproduce libm's special values.
+class FastMathTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{4600};
+
+    // Distance in representable floats; NaN only matches NaN
+    static int64_t UlpDistance(float a, float b) {
+        if (std::isnan(a) || std::isnan(b)) {
+            return (std::isnan(a) && std::isnan(b)) ? 0 : std::numeric_limits<int64_t>::max();
+        }
+        auto ordered = [](float f) {
+            int32_t i;
+            std::memcpy(&i, &f, sizeof(i));
+            return i < 0 ? static_cast<int64_t>(INT32_MIN) - i : static_cast<int64_t>(i);
+        };
+        return std::llabs(ordered(a) - ordered(b));
+    }
+
+    // Evenly spaced floats over [lo, hi]
+    static std::vector<float> Sweep(float lo, float hi, int count) {
+        std::vector<float> xs(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(count - 1);
+        }
+        return xs;
+    }
+
+    // Random bit patterns: every exponent, sign, infinity and NaN
+    std::vector<float> AnyFloats(int count) {
+        std::uniform_int_distribution<uint32_t> bits;
+        std::vector<float> xs(count);
+        for (float& x : xs) {
+            uint32_t b = bits(rng);
+            std::memcpy(&x, &b, sizeof(x));
+        }
+        return xs;
+    }
+
+    static std::vector<float> Specials() {
+        const float inf = std::numeric_limits<float>::infinity();
+        return {0.0f, -0.0f, inf, -inf, std::numeric_limits<float>::quiet_NaN(),
+                std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(),
+                std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), 1.0f, -1.0f};
+    }
+
+    void ExpectWithin(void (*kernel)(float*, size_t), float (*exact)(float),
+                      const std::vector<float>& xs, int64_t bound) {
+        std::vector<float> ys = xs;
+        kernel(ys.data(), ys.size());
+
+        int64_t worst = 0;
+        float worstX = 0.0f;
+        for (size_t i = 0; i < xs.size(); ++i) {
+            int64_t ulps = UlpDistance(ys[i], exact(xs[i]));
+            if (ulps > worst) {
+                worst = ulps;
+                worstX = xs[i];
+            }
+        }
+        EXPECT_LE(worst, bound) << "worst at x = " << worstX << " (" << fast_isa() << ")";
+    }
+
+    // <kernel> is fast_pow or fast_pow_shared_base
+    void ExpectPowWithin(const std::vector<float>& as, const std::vector<float>& bs, int64_t bound,
+                         void (*kernel)(float*, const float*, size_t) = fast_pow) {
+        std::vector<float> ys = as;
+        kernel(ys.data(), bs.data(), ys.size());
+
+        // Past |b| = 8 the general path loses about |b| / 5 ULP, so each
+        // lane is judged against its own allowance
+        int64_t worstExcess = std::numeric_limits<int64_t>::min();
+        size_t worstAt = 0;
+        for (size_t i = 0; i < as.size(); ++i) {
+            int64_t allowed = std::max(bound, static_cast<int64_t>(std::abs(bs[i]) / 5.0f));
+            int64_t excess = UlpDistance(ys[i], op_pow(as[i], bs[i])) - allowed;
+            if (excess > worstExcess) {
+                worstExcess = excess;
+                worstAt = i;
+            }
+        }
+        EXPECT_LE(worstExcess, 0) << "worst at " << as[worstAt] << "^" << bs[worstAt]
+                                  << " (" << fast_isa() << ")";
+    }
+};
+
+static float exactExp(float x) { return std::exp(x); }
+
+TEST_F(FastMathTest, SinCosTan) {
+    std::vector<float> xs = Sweep(-8192.0f, 8192.0f, 400001);
+    std::vector<float> small = Sweep(-4.0f, 4.0f, 100001);
+    std::vector<float> any = AnyFloats(100000);
+    xs.insert(xs.end(), small.begin(), small.end());
+    xs.insert(xs.end(), any.begin(), any.end());
+
+    ExpectWithin(fast_sin, op_sin<float>, xs, 2);
+    ExpectWithin(fast_cos, op_cos<float>, xs, 2);
+    ExpectWithin(fast_tan, op_tan<float>, xs, 4);
+}
+
+TEST_F(FastMathTest, ExpAndLogs) {
+    std::vector<float> xs = Sweep(-110.0f, 90.0f, 400001);
+    ExpectWithin(fast_exp, exactExp, xs, 1);
+
+    std::vector<float> positive = Sweep(1e-3f, 100.0f, 200001);
+    std::vector<float> nearOne = Sweep(0.5f, 2.0f, 200001);
+    std::vector<float> any = AnyFloats(200000);
+    positive.insert(positive.end(), nearOne.begin(), nearOne.end());
+    positive.insert(positive.end(), any.begin(), any.end());
+    ExpectWithin(fast_ln, op_ln<float>, positive, 1);
+    ExpectWithin(fast_log10, op_log<float>, positive, 2);
+}
+
+TEST_F(FastMathTest, Pow) {
+    // Shared base: e^x, 2^x, 10^x, 0.3^x, and bases fast_pow passes on
+    for (float base : {static_cast<float>(M_E), 2.0f, 10.0f, 0.3f}) {
+        std::vector<float> bs = Sweep(-150.0f, 150.0f, 50001);
+        ExpectPowWithin(std::vector<float>(bs.size(), base), bs, 1, fast_pow_shared_base);
+    }
+    for (float base : Specials()) {
+        std::vector<float> bs = Sweep(-4.0f, 4.0f, 801);
+        ExpectPowWithin(std::vector<float>(bs.size(), base), bs, 3, fast_pow_shared_base);
+    }
+
+    // Small integer exponents, negative bases included
+    std::vector<float> as = Sweep(-50.0f, 50.0f, 50001);
+    for (float exponent : {-3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f}) {
+        ExpectPowWithin(as, std::vector<float>(as.size(), exponent), 2);
+    }
+
+    // Everything varying: x^x, then random pairs with |b| <= 8
+    std::vector<float> xs = Sweep(0.0f, 20.0f, 50001);
+    ExpectPowWithin(xs, xs, 3);
+
+    std::uniform_real_distribution<float> base(0.0f, 50.0f);
+    std::uniform_real_distribution<float> exponent(-8.0f, 8.0f);
+    std::vector<float> randomAs(100000), randomBs(100000);
+    for (size_t i = 0; i < randomAs.size(); ++i) {
+        randomAs[i] = base(rng);
+        randomBs[i] = exponent(rng);
+    }
+    ExpectPowWithin(randomAs, randomBs, 3);
+
+    // Negative bases and non-finite operands go to libm
+    std::vector<float> anyA = AnyFloats(50000);
+    std::vector<float> anyB = AnyFloats(50000);
+    ExpectPowWithin(anyA, anyB, 3);
+}
+
+// NaN has to stay NaN and infinities stay infinite, so any mismatch here
+// shows up as a huge ULP distance rather than a rounding difference
+TEST_F(FastMathTest, SpecialValuesMatchLibm) {
+    std::vector<float> xs = Specials();
+    ExpectWithin(fast_sin, op_sin<float>, xs, 2);
+    ExpectWithin(fast_cos, op_cos<float>, xs, 2);
+    ExpectWithin(fast_tan, op_tan<float>, xs, 4);
+    ExpectWithin(fast_exp, exactExp, xs, 1);
+    ExpectWithin(fast_ln, op_ln<float>, xs, 1);
+    ExpectWithin(fast_log10, op_log<float>, xs, 2);
+
+    for (float b : Specials()) {
+        ExpectPowWithin(xs, std::vector<float>(xs.size(), b), 3);
+    }
+
+    // Exponents too large for the kernel still come out right
+    ExpectPowWithin({1.0000001f, 0.9999999f, 2.0f, 0.5f}, std::vector<float>(4, 4.0e6f), 3);
+}
+
+// A lane's result can't depend on its neighbours: the same inputs give
+// the same bits in any grouping, vector body or scalar tail
+TEST_F(FastMathTest, LanesAreIndependent) {
+    std::vector<float> as = Sweep(-6.0f, 6.0f, 4001);
+    std::vector<float> bs(as.size());
+    for (size_t i = 0; i < bs.size(); ++i) bs[i] = (i % 3 == 0) ? 2.0f : std::floor(as[i]);
+
+    std::vector<float> whole = as;
+    fast_pow(whole.data(), bs.data(), whole.size());
+    std::vector<float> sines = as;
+    fast_sin(sines.data(), sines.size());
+
+    for (size_t i = 0; i < as.size(); ++i) {
+        float alone = as[i];
+        fast_pow(&alone, &bs[i], 1);
+        EXPECT_EQ(alone, whole[i]) << as[i] << "^" << bs[i];
+
+        alone = as[i];
+        fast_sin(&alone, 1);
+        EXPECT_EQ(alone, sines[i]) << "sin " << as[i];
+    }
+}
+
+TEST_F(FastMathTest, ExpressionsPickTheirMode) {
+    Expression exact = Expression::parse("sin(x)*e^(-x^2/8) + ln(x^2+1)");
+    Expression fast = Expression::parse("sin(x)*e^(-x^2/8) + ln(x^2+1)");
+    fast.setMathMode(FAST_MATH);
+    ASSERT_TRUE(exact.isValid());
+    EXPECT_EQ(exact.getMathMode(), EXACT_MATH);
+    EXPECT_EQ(fast.getMathMode(), FAST_MATH);
+
+    std::vector<float> xs = Sweep(-10.0f, 10.0f, 1001);
+    std::vector<float> exactOut(xs.size()), fastOut(xs.size());
+    float frame = 0.0f;
+    exact.evaluateBatch(&frame, 0, xs.data(), exactOut.data(), xs.size());
+    fast.evaluateBatch(&frame, 0, xs.data(), fastOut.data(), xs.size());
+
+    // Exact mode is libm, bit for bit
+    for (size_t i = 0; i < xs.size(); ++i) {
+        frame = xs[i];
+        EXPECT_EQ(exactOut[i], exact.evaluate(&frame));
+        EXPECT_NEAR(fastOut[i], exactOut[i], 1e-5f * (1.0f + std::abs(exactOut[i])));
+    }
+
+    // The cache keeps the modes apart
+    ExpressionCache cache;
+    auto cachedExact = cache.get("sin(x)");
+    auto cachedFast = cache.get("sin(x)", FAST_MATH);
+    EXPECT_NE(cachedExact.get(), cachedFast.get());
+    EXPECT_EQ(cachedExact->getMathMode(), EXACT_MATH);
+    EXPECT_EQ(cachedFast->getMathMode(), FAST_MATH);
+    EXPECT_EQ(cache.get("sin( x )", FAST_MATH).get(), cachedFast.get());
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "Expression.h"
+#include "Interval.h"
+#include "SymbolTable.h"
+#include "random_equation.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+// Test fixture for interval evaluation. The enclosure must hold every
+// value the tree evaluator produces for x inside the range.
+class IntervalTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{777};
+
+    Interval Enclose(const std::string& equation, float lo, float hi) {
+        Expression expr = Expression::parse(equation);
+        EXPECT_TRUE(expr.isValid()) << expr.getError();
+        float x = 0.0f;
+        return expr.evaluateInterval(&x, 0, {lo, hi});
+    }
+};
+
+TEST_F(IntervalTest, ElementaryEnclosures) {
+    Interval r = Enclose("1/x", 1.0f, 2.0f);
+    EXPECT_LE(r.lo, 0.5f);
+    EXPECT_GE(r.hi, 1.0f);
+    EXPECT_GT(r.lo, 0.49f);
+    EXPECT_LT(r.hi, 1.01f);
+
+    r = Enclose("x^2", -3.0f, 2.0f);
+    EXPECT_LE(r.lo, 0.0f);
+    EXPECT_GE(r.hi, 9.0f);
+    EXPECT_GT(r.lo, -1e-6f);
+
+    r = Enclose("sin(x)", 0.0f, 3.0f);
+    EXPECT_EQ(r.hi, 1.0f);
+    EXPECT_LE(r.lo, 0.0f);
+    EXPECT_GT(r.lo, -1e-6f);
+}
+
+TEST_F(IntervalTest, DetectsPoles) {
+    EXPECT_FALSE(Enclose("tan(x)", 1.0f, 2.0f).isBounded());
+    EXPECT_TRUE(Enclose("tan(x)", -1.0f, 1.0f).isBounded());
+    EXPECT_FALSE(Enclose("1/x", -0.1f, 0.1f).isBounded());
+    EXPECT_FALSE(Enclose("e^(1/x)", 0.0f, 0.1f).isBounded());
+    EXPECT_TRUE(Enclose("e^(1/x)", -0.1f, -0.01f).isBounded());
+    EXPECT_FALSE(Enclose("e^(1/x)", -0.1f, 0.0f).isBounded());  // op_div(1, 0) = +inf
+    EXPECT_FALSE(Enclose("csc(x)", 3.0f, 3.2f).isBounded());
+    EXPECT_FALSE(Enclose("(x)!", -1.5f, -0.5f).isBounded());
+    EXPECT_TRUE(Enclose("(x)!", -2.9f, -2.1f).isBounded());
+    EXPECT_LE(Enclose("(x)!", -1.9f, -1.1f).hi, 0.0f);
+}
+
+TEST_F(IntervalTest, FactorialBetweenPoles) {
+    // Negative arguments away from the poles stay bounded, with the sign
+    // of their cell, and hold every sampled value
+    for (float lo : {-4.9f, -3.9f, -2.9f, -1.9f, -0.9f}) {
+        float hi = lo + 0.8f;
+        Interval r = Enclose("(x)!", lo, hi);
+        ASSERT_TRUE(r.isBounded()) << lo;
+        for (int i = 0; i <= 16; ++i) {
+            float x = lo + (hi - lo) * i / 16.0f;
+            EXPECT_TRUE(r.contains(std::tgamma(x + 1.0f))) << "x = " << x;
+        }
+    }
+}
+
+TEST_F(IntervalTest, EmptyOutsideTheDomain) {
+    EXPECT_TRUE(Enclose("sqrt(x)", -3.0f, -1.0f).isEmpty());
+    EXPECT_TRUE(Enclose("ln(x)", -3.0f, -1.0f).isEmpty());
+    EXPECT_TRUE(Enclose("arcsin(x)", 2.0f, 3.0f).isEmpty());
+    EXPECT_TRUE(Enclose("x^0.5", -2.0f, -1.0f).isEmpty());
+    EXPECT_TRUE(Enclose("sqrt(x) + 1", -2.0f, -1.0f).isEmpty());
+    EXPECT_FALSE(Enclose("sqrt(x)", -1.0f, 1.0f).isEmpty());
+}
+
+TEST_F(IntervalTest, EnclosesRandomExpressions) {
+    RandomEquation generator(rng);
+    std::uniform_real_distribution<float> uniform(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> width(0.0f, 2.0f);
+
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string equation = generator.generate(4);
+        Expression expr = Expression::parse(equation);
+        ASSERT_TRUE(expr.isValid()) << equation << ": " << expr.getError();
+
+        SymbolTable symbols;
+        symbols.AddEntry("x");
+        symbols.AddEntry("y");
+        symbols.SetValue("y", uniform(rng));
+        expr.bind(symbols);
+        const int xSlot = symbols.GetIndex("x");
+
+        float lo = uniform(rng);
+        float hi = lo + width(rng);
+        Interval range = expr.evaluateInterval(symbols.GetFrame(), xSlot, {lo, hi});
+
+        for (int i = 0; i <= 64; ++i) {
+            float x = (i == 64) ? hi : lo + (hi - lo) * i / 64.0f;
+            symbols.SetValue(xSlot, x);
+            float y = expr.evaluateTree(symbols);
+            if (std::isnan(y)) continue;
+            ASSERT_TRUE(range.contains(y))
+                << equation << " over [" << lo << ", " << hi << "] at x=" << x
+                << ": " << y << " not in [" << range.lo << ", " << range.hi << "]";
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "Expression.h"
+#include "Jit.h"
+#include "SymbolTable.h"
+#include "random_equation.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Test fixture for JIT tests. The tree evaluator is the oracle: native
+// code must agree with it bit for bit (any NaN matches any NaN).
+class JitTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{12345};
+
+    static bool SameFloat(float a, float b) {
+        if (std::isnan(a) && std::isnan(b)) return true;
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+};
+
+TEST_F(JitTest, MatchesTreeOnRandomExpressions) {
+    if (!JitProgram::isSupported()) {
+        GTEST_SKIP() << "No native code generation on this platform";
+    }
+
+    RandomEquation generator(rng);
+    std::vector<float> inputs = {-0.0f, 0.0f, 1.0f, -1.0f, 0.5f, 2.0f, -3.5f, 7.25f, 100.0f, 1e-3f};
+    std::uniform_real_distribution<float> uniform(-10.0f, 10.0f);
+    for (int i = 0; i < 22; ++i) inputs.push_back(uniform(rng));
+
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string equation = generator.generate(5);
+        Expression expr = Expression::parse(equation, trial % 2 == 0);
+        ASSERT_TRUE(expr.isValid()) << equation << ": " << expr.getError();
+
+        SymbolTable symbols;
+        symbols.AddEntry("x");
+        symbols.AddEntry("y");
+        symbols.SetValue("y", uniform(rng));
+        expr.bind(symbols);
+        const int xSlot = symbols.GetIndex("x");
+
+        JitProgram jit = JitProgram::compile(expr.getProgram(), static_cast<uint32_t>(xSlot));
+        ASSERT_TRUE(jit.isNative()) << equation;
+
+        std::vector<float> batch(inputs.size());
+        jit.runBatch(symbols.GetFrame(), inputs.data(), batch.data(), inputs.size());
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            symbols.SetValue(xSlot, inputs[i]);
+            float expected = expr.evaluateTree(symbols);
+            float native = jit.run(symbols.GetFrame());
+            ASSERT_TRUE(SameFloat(native, expected))
+                << equation << " at x=" << inputs[i] << ": " << native << " vs " << expected;
+            ASSERT_TRUE(SameFloat(batch[i], expected))
+                << equation << " (batch) at x=" << inputs[i] << ": " << batch[i] << " vs " << expected;
+        }
+    }
+}
+
+TEST_F(JitTest, BatchHandlesEveryRemainder) {
+    Expression expr = Expression::parse("x*x - 3/x");
+    ASSERT_TRUE(expr.isValid());
+    JitProgram jit = JitProgram::compile(expr.getProgram(), 0);
+
+    for (size_t count = 0; count <= 9; ++count) {
+        std::vector<float> xs(count), out(count + 1, -42.0f);
+        for (size_t i = 0; i < count; ++i) xs[i] = static_cast<float>(i) - 2.0f;
+        jit.runBatch(nullptr, xs.data(), out.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_TRUE(SameFloat(out[i], expr.evaluate(&xs[i]))) << "count " << count << " lane " << i;
+        }
+        EXPECT_EQ(out[count], -42.0f) << "wrote past the end, count " << count;
+    }
+}
+
+TEST_F(JitTest, DeepExpressionsAndMoves) {
+    // Deep enough to spill a long value stack
+    std::string equation = "x";
+    for (int i = 0; i < 40; ++i) equation = "(1 + " + equation + ")^1.01";
+    Expression expr = Expression::parse(equation);
+    ASSERT_TRUE(expr.isValid());
+
+    JitProgram jit = JitProgram::compile(expr.getProgram());
+    JitProgram moved = std::move(jit);
+    EXPECT_FALSE(jit.isNative());
+
+    float x = 0.75f;
+    EXPECT_TRUE(SameFloat(moved.run(&x), expr.evaluate(&x)));
+}
+
+TEST_F(JitTest, EmptyProgramFallsBack) {
+    JitProgram jit = JitProgram::compile(Program());
+    EXPECT_FALSE(jit.isNative());
+    EXPECT_EQ(jit.run(nullptr), 0.0f);
+}
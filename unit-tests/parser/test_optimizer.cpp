@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "Expression.h"
+#include "Optimizer.h"
+#include "SymbolTable.h"
+#include <cmath>
+#include <string>
+
+// Test fixture for AST optimizer tests
+class OptimizerTest : public ::testing::Test {
+protected:
+    // Parse with the optimizer on and return the compiled instruction count
+    size_t OptimizedSize(const std::string& equation) {
+        Expression expr = Expression::parse(equation);
+        EXPECT_TRUE(expr.isValid()) << "Parsing failed: " << expr.getError();
+        return expr.getProgram().getCode().size();
+    }
+
+    // Optimized program must agree with the unoptimized tree everywhere
+    void ExpectSameResults(const std::string& equation) {
+        Expression optimized = Expression::parse(equation);
+        Expression reference = Expression::parse(equation, false);
+        ASSERT_TRUE(optimized.isValid()) << "Parsing failed: " << optimized.getError();
+
+        SymbolTable symbols;
+        symbols.AddEntry("x");
+        for (float x : {-3.5f, -1.0f, -0.0f, 0.0f, 0.5f, 2.0f, 7.25f, INFINITY, NAN}) {
+            symbols.SetValue("x", x);
+            float expected = reference.evaluateTree(symbols);
+            float actual = optimized.evaluate(symbols);
+            if (std::isnan(expected)) {
+                EXPECT_TRUE(std::isnan(actual)) << equation << " at x=" << x;
+            } else {
+                EXPECT_EQ(actual, expected) << equation << " at x=" << x;
+                // EXPECT_EQ has -0 == +0
+                EXPECT_EQ(std::signbit(actual), std::signbit(expected)) << equation << " at x=" << x;
+            }
+        }
+    }
+};
+
+TEST_F(OptimizerTest, FoldsConstants) {
+    EXPECT_EQ(OptimizedSize("(3+4)*x"), 3u);        // 7 x *
+    EXPECT_EQ(OptimizedSize("2*pi*x"), 3u);         // 6.28.. x *
+    EXPECT_EQ(OptimizedSize("sqrt(2) + 1"), 1u);    // 2.414..
+    EXPECT_EQ(OptimizedSize("e^2"), 1u);
+}
+
+TEST_F(OptimizerTest, AppliesIdentities) {
+    EXPECT_EQ(OptimizedSize("-0+sin(x)"), 2u);
+    EXPECT_EQ(OptimizedSize("x*1"), 1u);
+    EXPECT_EQ(OptimizedSize("1*x + -0"), 1u);
+    EXPECT_EQ(OptimizedSize("x^1"), 1u);
+    EXPECT_EQ(OptimizedSize("x/1 - 0"), 1u);
+    EXPECT_EQ(OptimizedSize("--x"), 1u);
+    EXPECT_EQ(OptimizedSize("x^0"), 1u);
+    EXPECT_EQ(OptimizedSize("-0-x"), 2u);           // x neg
+    EXPECT_EQ(OptimizedSize("x*(3-4)"), 2u);        // x neg
+}
+
+TEST_F(OptimizerTest, KeepsUnsafeRewrites) {
+    // x*0 is NaN for x = inf, so it must stay
+    EXPECT_EQ(OptimizedSize("x*0"), 3u);
+    // x+0 and 0+x are +0 for x = -0, 0-x is -0 for x = +0
+    EXPECT_EQ(OptimizedSize("x+0"), 3u);
+    EXPECT_EQ(OptimizedSize("0+x"), 3u);
+    EXPECT_EQ(OptimizedSize("0-x"), 3u);
+    EXPECT_EQ(OptimizedSize("x+-0"), 1u);
+}
+
+TEST_F(OptimizerTest, KeepsSignedZeros) {
+    Expression expr = Expression::parse("(0-x)^(-1)");
+    ASSERT_TRUE(expr.isValid());
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    symbols.SetValue("x", 0.0f);
+    EXPECT_EQ(expr.evaluate(symbols), INFINITY);
+    symbols.SetValue("x", -0.0f);
+    EXPECT_EQ(expr.evaluate(symbols), INFINITY);
+
+    // -0 + x keeps -0, 0 + x does not
+    EXPECT_TRUE(std::signbit(Expression::parse("-0+x").evaluate(symbols)));
+    EXPECT_FALSE(std::signbit(Expression::parse("0+x").evaluate(symbols)));
+}
+
+TEST_F(OptimizerTest, ReportsRemovedNodes) {
+    Expression expr = Expression::parse("(3+4)*x - 0");
+    ASSERT_TRUE(expr.isValid());
+    // - ( * ( + 3 4 ) x ) 0  ->  * 7 x
+    EXPECT_EQ(expr.getRemovedNodeCount(), 4);
+
+    Expression plain = Expression::parse("(3+4)*x - 0", false);
+    EXPECT_EQ(plain.getRemovedNodeCount(), 0);
+}
+
+TEST_F(OptimizerTest, PreservesResults) {
+    for (const char* equation : {"2*pi*x", "x^1 + 0*1", "0+sin(x)", "--x*1", "(3+4)*x/1",
+                                 "x^0", "1^x", "0-x", "x*-1", "ln(e)*x", "sqrt(2)*x^2",
+                                 "x+0", "x-0", "x+-0", "-0+x", "-0-x", "(0-x)^(-1)"}) {
+        ExpectSameResults(equation);
+    }
+}
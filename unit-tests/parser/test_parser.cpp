@@ -15,4 +15,58 @@ protected:
         symbols.SetValue("x", x);
         return expr.evaluate(symbols);
     }
-};
\ No newline at end of file
+};
+
+TEST_F(ParserTest, ParsesFromTokenBuffer) {
+    const std::string equation = "2 * x + 1";
+    ScannerClass scanner(equation.data(), equation.data() + equation.size());
+    TokenBuffer buffer;
+    buffer.Fill(scanner);
+
+    Arena arena;
+    Parser parser(buffer, arena);
+    Node* ast = parser.parse();
+    ASSERT_NE(ast, nullptr);
+    EXPECT_EQ(ast->getType(), BINARY_NODE);
+}
+
+TEST_F(ParserTest, ReportsLineOfBadToken) {
+    try {
+        Arena arena;
+        parseToAST("x +\n* 2", arena);
+        FAIL() << "Expected a parse error";
+    } catch (const std::runtime_error& error) {
+        EXPECT_NE(std::string(error.what()).find("line 2"), std::string::npos) << error.what();
+    }
+}
+
+TEST_F(ParserTest, NodesLiveInTheArena) {
+    Arena arena;
+    Node* ast = parseToAST("sin(x) * 2 + y", arena);
+    ASSERT_NE(ast, nullptr);
+
+    // 6 nodes plus the two variable names, all in one chunk
+    EXPECT_EQ(arena.getAllocationCount(), 8u);
+    EXPECT_EQ(arena.getChunkCount(), 1u);
+    EXPECT_GE(arena.getBytesReserved(), arena.getBytesUsed());
+}
+
+TEST_F(ParserTest, ParsesImplicitEquations) {
+    Expression circle = Expression::parse("x^2 + y^2 = 1");
+    ASSERT_TRUE(circle.isValid()) << circle.getError();
+    EXPECT_TRUE(circle.isImplicit());
+
+    // Evaluates to lhs - rhs
+    SymbolTable symbols;
+    symbols.AddEntry("x");
+    symbols.AddEntry("y");
+    symbols.SetValue("x", 0.6f);
+    symbols.SetValue("y", 0.8f);
+    EXPECT_NEAR(circle.evaluate(symbols), 0.0f, 1e-6f);
+    symbols.SetValue("x", 2.0f);
+    EXPECT_FLOAT_EQ(circle.evaluate(symbols), 3.64f);
+
+    EXPECT_FALSE(Expression::parse("x^2 + y^2").isImplicit());
+    EXPECT_FALSE(Expression::parse("x = ").isValid());
+    EXPECT_FALSE(Expression::parse("x = y = 1").isValid());
+}
@@ -169,6 +169,60 @@ TEST_F(ScannerTest, Variables) {
     EXPECT_EQ(tokens[7].GetTokenType(), RPAREN_TOKEN);
 }
 
+TEST_F(ScannerTest, ReservedWordPrefixes) {
+    // Longest reserved word wins; whatever follows is split the same way
+    auto tokens = GetAllTokens("arcsinx sinh lnx arcs ex");
+
+    std::vector<TokenType> expected = {
+        ARCSIN_TOKEN, VARIABLE_TOKEN,                                   // arcsin x
+        SIN_TOKEN, VARIABLE_TOKEN,                                      // sin h
+        LN_TOKEN, VARIABLE_TOKEN,                                       // ln x
+        VARIABLE_TOKEN, VARIABLE_TOKEN, VARIABLE_TOKEN, VARIABLE_TOKEN, // a r c s
+        EULER_TOKEN, VARIABLE_TOKEN,                                    // e x
+    };
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(tokens[i].GetTokenType(), expected[i]) << "token " << i;
+    }
+    EXPECT_EQ(tokens[0].GetLexeme(), "arcsin");
+    EXPECT_EQ(tokens[6].GetLexeme(), "a");
+}
+
+TEST_F(ScannerTest, LongIdentifiersSplitInOnePass) {
+    // Scanning the rest again for every piece would take ~n^2/2 steps
+    const size_t length = 200000;
+    auto tokens = GetAllTokens(std::string(length, 'x') + "sinx");
+
+    ASSERT_EQ(tokens.size(), length + 2);
+    EXPECT_EQ(tokens[0].GetTokenType(), VARIABLE_TOKEN);
+    EXPECT_EQ(tokens[length - 1].GetLexeme(), "x");
+    EXPECT_EQ(tokens[length].GetTokenType(), SIN_TOKEN);
+    EXPECT_EQ(tokens[length + 1].GetLexeme(), "x");
+}
+
+TEST_F(ScannerTest, PeekInsideASplitIdentifier) {
+    ScannerClass scanner("lnx + 1", false);
+
+    EXPECT_EQ(scanner.GetNextToken().GetTokenType(), LN_TOKEN);
+    EXPECT_EQ(scanner.PeekNextToken().GetLexeme(), "x");
+    EXPECT_EQ(scanner.GetNextToken().GetLexeme(), "x");
+    EXPECT_EQ(scanner.PeekNextToken().GetTokenType(), PLUS_TOKEN);
+    EXPECT_EQ(scanner.GetNextToken().GetTokenType(), PLUS_TOKEN);
+}
+
+TEST_F(ScannerTest, ClassifyLexemeMatchesWholeWordsOnly) {
+    EXPECT_EQ(ClassifyLexeme(IDENTIFIER_TOKEN, "floor"), FLOOR_TOKEN);
+    EXPECT_EQ(ClassifyLexeme(VARIABLE_TOKEN, "e"), EULER_TOKEN);
+    EXPECT_EQ(ClassifyLexeme(IDENTIFIER_TOKEN, "floors"), IDENTIFIER_TOKEN);
+    EXPECT_EQ(ClassifyLexeme(IDENTIFIER_TOKEN, "flo"), IDENTIFIER_TOKEN);
+    EXPECT_EQ(ClassifyLexeme(IDENTIFIER_TOKEN, "Sin"), IDENTIFIER_TOKEN);
+
+    TokenType type = BAD_TOKEN;
+    EXPECT_EQ(MatchReservedPrefix("sqrtx", type), 4u);
+    EXPECT_EQ(type, SQRT_TOKEN);
+    EXPECT_EQ(MatchReservedPrefix("xyz", type), 0u);
+}
+
 TEST_F(ScannerTest, LineNumberTracking) {
     ScannerClass scanner("1\n2\n3", false);
     
@@ -195,3 +249,66 @@ TEST_F(ScannerTest, MultipleStatementsWithSemicolon) {
     }
     EXPECT_EQ(semicolonCount, 2);
 }
+
+TEST_F(ScannerTest, ViewLexemesPointIntoSource) {
+    const std::string source = "sinx + 12.5";
+    ScannerClass scanner(source.data(), source.data() + source.size());
+
+    TokenView sin = scanner.ScanToken();
+    TokenView x = scanner.ScanToken();
+    TokenView plus = scanner.ScanToken();
+    TokenView number = scanner.ScanToken();
+
+    EXPECT_EQ(sin.type, SIN_TOKEN);
+    EXPECT_EQ(sin.lexeme.data(), source.data());
+    EXPECT_EQ(x.type, VARIABLE_TOKEN);
+    EXPECT_EQ(x.lexeme, "x");
+    EXPECT_EQ(x.lexeme.data(), source.data() + 3);
+    EXPECT_EQ(plus.type, PLUS_TOKEN);
+    EXPECT_EQ(number.type, NUMBER_TOKEN);
+    EXPECT_EQ(number.lexeme, "12.5");
+    EXPECT_EQ(number.lexeme.data(), source.data() + 7);
+    EXPECT_EQ(scanner.ScanToken().type, EOF_TOKEN);
+}
+
+TEST_F(ScannerTest, PeekDoesNotAdvance) {
+    ScannerClass scanner("2\n", false);
+
+    EXPECT_EQ(scanner.PeekNextToken().GetTokenType(), NUMBER_TOKEN);
+    EXPECT_EQ(scanner.GetNextToken().GetLexeme(), "2");
+
+    // Peeking at the end of input used to depend on stream state
+    EXPECT_EQ(scanner.PeekNextToken().GetTokenType(), EOF_TOKEN);
+    EXPECT_EQ(scanner.PeekNextToken().GetTokenType(), EOF_TOKEN);
+    EXPECT_EQ(scanner.GetNextToken().GetTokenType(), EOF_TOKEN);
+}
+
+TEST_F(ScannerTest, TokenBufferIndexesAllTokens) {
+    const std::string source = "sin(x)\n+ 2";
+    ScannerClass scanner(source.data(), source.data() + source.size());
+    TokenBuffer buffer;
+    buffer.Fill(scanner);
+
+    ASSERT_EQ(buffer.Size(), 7u);  // sin ( x ) + 2 EOF
+    EXPECT_EQ(buffer.At(0).type, SIN_TOKEN);
+    EXPECT_EQ(buffer.At(4).type, PLUS_TOKEN);
+    EXPECT_EQ(buffer.At(6).type, EOF_TOKEN);
+    EXPECT_EQ(buffer.At(100).type, EOF_TOKEN);
+    EXPECT_EQ(buffer.LineAt(0), 1);
+    EXPECT_EQ(buffer.LineAt(5), 2);
+}
+
+TEST_F(ScannerTest, TokenBufferRefillReplacesTokens) {
+    TokenBuffer buffer;
+    const std::string first = "x + y + z";
+    ScannerClass firstScanner(first.data(), first.data() + first.size());
+    buffer.Fill(firstScanner);
+    EXPECT_EQ(buffer.Size(), 6u);
+
+    const std::string second = "pi";
+    ScannerClass secondScanner(second.data(), second.data() + second.size());
+    buffer.Fill(secondScanner);
+    ASSERT_EQ(buffer.Size(), 2u);
+    EXPECT_EQ(buffer.At(0).type, PI_TOKEN);
+    EXPECT_EQ(buffer.At(1).type, EOF_TOKEN);
+}